@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -9,22 +9,26 @@
 #include <string.h>
 
 namespace CLElfLib {
-CElfReader::CElfReader(ElfBinaryStorage &elfBinary) {
-    validateElfBinary(elfBinary);
+CElfReader::CElfReader(ElfBinaryStorage &elfBinary) : CElfReader(elfBinary.data(), elfBinary.size()) {
 }
 
-void CElfReader::validateElfBinary(ElfBinaryStorage &elfBinary) {
+CElfReader::CElfReader(const char *elfBinary, size_t elfBinarySize) {
+    validateElfBinary(elfBinary, elfBinarySize);
+}
+
+void CElfReader::validateElfBinary(const char *elfBinary, size_t elfBinarySize) {
     const char *nameTable = nullptr;
     const char *end = nullptr;
     size_t ourSize = 0u;
     size_t entrySize = 0u;
     size_t indexedSectionHeaderOffset = 0u;
-    beginBinary = elfBinary.data();
+    beginBinary = elfBinary;
+    binarySize = elfBinarySize;
 
-    if (elfBinary.size() >= sizeof(SElf64Header)) {
+    if (elfBinary != nullptr && elfBinarySize >= sizeof(SElf64Header)) {
         // calculate a pointer to the end
-        end = beginBinary + elfBinary.size();
-        elf64Header = reinterpret_cast<const SElf64Header *>(elfBinary.data());
+        end = beginBinary + elfBinarySize;
+        elf64Header = reinterpret_cast<const SElf64Header *>(elfBinary);
 
         if (!((elf64Header->Identity[ELFConstants::idIdxMagic0] == ELFConstants::elfMag0) &&
               (elf64Header->Identity[ELFConstants::idIdxMagic1] == ELFConstants::elfMag1) &&
@@ -70,25 +74,50 @@ void CElfReader::validateElfBinary(ElfBinaryStorage &elfBinary) {
             throw ElfException();
         }
 
-        SElf64SectionHeader stringSectionHeader = {0};
-        stringSectionHeader.Type = sectionHeader->Type;
-        stringSectionHeader.Flags = sectionHeader->Flags;
-        stringSectionHeader.DataOffset = sectionHeader->DataOffset;
-        stringSectionHeader.DataSize = sectionHeader->DataSize;
-        stringSectionHeader.Name = sectionHeader->Name;
-        sectionHeaders.push_back(std::move(stringSectionHeader));
-
         // tally up the sizes
         ourSize += static_cast<size_t>(sectionHeader->DataSize);
         ourSize += static_cast<size_t>(entrySize);
     }
 
-    if (ourSize != elfBinary.size()) {
+    if (ourSize != elfBinarySize) {
         throw ElfException();
     }
 }
 
+ElfSectionHeaderStorage &CElfReader::getSectionHeaders() {
+    if (sectionHeaders.empty()) {
+        sectionHeaders.reserve(getSectionsCount());
+        for (size_t i = 0u; i < getSectionsCount(); ++i) {
+            sectionHeaders.push_back(getSectionHeader(i));
+        }
+    }
+    return sectionHeaders;
+}
+
+size_t CElfReader::getSectionsCount() const {
+    return elf64Header->NumSectionHeaderEntries;
+}
+
+SElf64SectionHeader CElfReader::getSectionHeader(size_t sectionIndex) const {
+    size_t sectionHeaderOffset = static_cast<size_t>(elf64Header->SectionHeadersOffset) + (sectionIndex * elf64Header->SectionHeaderEntrySize);
+    SElf64SectionHeader binarySectionHeader;
+    // binary may come from user memory with no alignment guarantees
+    memcpy(&binarySectionHeader, beginBinary + sectionHeaderOffset, sizeof(SElf64SectionHeader));
+
+    SElf64SectionHeader sectionHeader = {0};
+    sectionHeader.Type = binarySectionHeader.Type;
+    sectionHeader.Flags = binarySectionHeader.Flags;
+    sectionHeader.DataOffset = binarySectionHeader.DataOffset;
+    sectionHeader.DataSize = binarySectionHeader.DataSize;
+    sectionHeader.Name = binarySectionHeader.Name;
+    return sectionHeader;
+}
+
 char *CElfReader::getSectionData(Elf64_Off dataOffset) {
+    return const_cast<char *>(beginBinary) + dataOffset;
+}
+
+const char *CElfReader::getSectionData(Elf64_Off dataOffset) const {
     return beginBinary + dataOffset;
 }
 
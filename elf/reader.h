@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -17,23 +17,29 @@ using ElfSectionHeaderStorage = std::vector<SElf64SectionHeader>;
  Description:   Class to provide simpler interaction with the ELF standard
                 binary object.  SElf64Header defines the ELF header type and
                 SElf64SectionHeader defines the section header type.
+                Reader does not own nor copy the binary - it has to outlive
+                the reader. Section headers are decoded on demand.
 
 \******************************************************************************/
 class CElfReader {
   public:
     CElfReader(ElfBinaryStorage &elfBinary);
-    ElfSectionHeaderStorage &getSectionHeaders() {
-        return sectionHeaders;
-    }
+    CElfReader(const char *elfBinary, size_t elfBinarySize);
+
+    ElfSectionHeaderStorage &getSectionHeaders();
+    size_t getSectionsCount() const;
+    SElf64SectionHeader getSectionHeader(size_t sectionIndex) const;
 
     const SElf64Header *getElfHeader();
     char *getSectionData(Elf64_Off dataOffset);
+    const char *getSectionData(Elf64_Off dataOffset) const;
 
   protected:
-    void validateElfBinary(ElfBinaryStorage &elfBinary);
+    void validateElfBinary(const char *elfBinary, size_t elfBinarySize);
 
     ElfSectionHeaderStorage sectionHeaders;
-    char *beginBinary;
-    const SElf64Header *elf64Header;
+    const char *beginBinary = nullptr;
+    size_t binarySize = 0u;
+    const SElf64Header *elf64Header = nullptr;
 };
 } // namespace CLElfLib
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -7,6 +7,7 @@
 
 #include "writer.h"
 #include <cstring>
+#include <vector>
 
 // Need for linux compatibility with memcpy_s
 #include "runtime/helpers/string.h"
@@ -50,7 +51,7 @@ void CElfWriter::resolveBinary(ElfBinaryStorage &binary) {
         curSectionHeader = reinterpret_cast<SElf64SectionHeader *>(reinterpret_cast<unsigned char *>(curSectionHeader) + sizeof(SElf64SectionHeader));
 
         // copy the data, move the data pointer
-        memcpy_s(data, queueFront.dataSize, queueFront.data.c_str(), queueFront.dataSize);
+        memcpy_s(data, queueFront.dataSize, queueFront.getData(), queueFront.dataSize);
         data += queueFront.dataSize;
 
         // copy the name into the string table, move the string pointer
@@ -82,6 +83,61 @@ void CElfWriter::resolveBinary(ElfBinaryStorage &binary) {
     patchElfHeader(*reinterpret_cast<SElf64Header *>(binary.data()));
 }
 
+void CElfWriter::resolveBinary(std::ostream &stream) {
+    // Layout is known upfront, so headers can be emitted before any section data
+    // and the binary never has to be materialized in memory.
+    std::vector<SSectionNode> sections;
+    sections.reserve(nodeQueue.size());
+    while (nodeQueue.empty() == false) {
+        sections.push_back(std::move(nodeQueue.front()));
+        nodeQueue.pop();
+    }
+
+    Elf64_Off dataOffset = sizeof(SElf64Header) +
+                           ((numSections + 1) * sizeof(SElf64SectionHeader)); // +1 to account for string table entry
+    Elf64_Off stringTableOffset = dataOffset + dataSize;
+
+    // Add to our section number
+    numSections++;
+
+    SElf64Header elfHeader;
+    memset(&elfHeader, 0, sizeof(SElf64Header));
+    patchElfHeader(elfHeader);
+    stream.write(reinterpret_cast<const char *>(&elfHeader), sizeof(SElf64Header));
+
+    Elf64_Word nameOffset = 0u;
+    for (const auto &section : sections) {
+        SElf64SectionHeader sectionHeader;
+        memset(&sectionHeader, 0, sizeof(SElf64SectionHeader));
+        sectionHeader.Type = section.type;
+        sectionHeader.Flags = section.flag;
+        sectionHeader.DataSize = section.dataSize;
+        sectionHeader.DataOffset = dataOffset;
+        sectionHeader.Name = nameOffset;
+        stream.write(reinterpret_cast<const char *>(&sectionHeader), sizeof(SElf64SectionHeader));
+
+        dataOffset += section.dataSize;
+        nameOffset += static_cast<Elf64_Word>(section.name.size() + 1u);
+    }
+
+    SElf64SectionHeader stringSectionHeader;
+    memset(&stringSectionHeader, 0, sizeof(SElf64SectionHeader));
+    stringSectionHeader.Type = E_SH_TYPE::SH_TYPE_STR_TBL;
+    stringSectionHeader.Flags = E_SH_FLAG::SH_FLAG_NONE;
+    stringSectionHeader.DataOffset = stringTableOffset;
+    stringSectionHeader.DataSize = stringTableSize;
+    stringSectionHeader.Name = 0;
+    stream.write(reinterpret_cast<const char *>(&stringSectionHeader), sizeof(SElf64SectionHeader));
+
+    for (const auto &section : sections) {
+        stream.write(section.getData(), section.dataSize);
+    }
+
+    for (const auto &section : sections) {
+        stream.write(section.name.c_str(), section.name.size() + 1u);
+    }
+}
+
 void CElfWriter::patchElfHeader(SElf64Header &binary) {
     // Setup the identity
     binary.Identity[ELFConstants::idIdxMagic0] = ELFConstants::elfMag0;
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -7,6 +7,7 @@
 
 #pragma once
 #include "types.h"
+#include <ostream>
 #include <queue>
 #include <string>
 
@@ -16,6 +17,7 @@ struct SSectionNode {
     E_SH_FLAG flag = E_SH_FLAG::SH_FLAG_NONE;
     std::string name;
     std::string data;
+    const char *dataReference = nullptr;
     uint32_t dataSize = 0u;
 
     SSectionNode() = default;
@@ -25,6 +27,10 @@ struct SSectionNode {
         : type(type), flag(flag), name(std::forward<T1>(name)), data(std::forward<T2>(data)), dataSize(dataSize) {}
 
     ~SSectionNode() = default;
+
+    const char *getData() const {
+        return dataReference ? dataReference : data.c_str();
+    }
 };
 
 /******************************************************************************\
@@ -64,7 +70,15 @@ class CElfWriter {
         numSections++;
     }
 
+    // Section data is not copied, it has to stay valid until the binary is resolved.
+    void addSectionWithDataReference(E_SH_TYPE type, E_SH_FLAG flag, std::string name, const char *data, uint32_t dataSize) {
+        SSectionNode sectionNode(type, flag, std::move(name), "", dataSize);
+        sectionNode.dataReference = data;
+        addSection(std::move(sectionNode));
+    }
+
     void resolveBinary(ElfBinaryStorage &binary);
+    void resolveBinary(std::ostream &stream);
 
     size_t getTotalBinarySize() {
         return sizeof(SElf64Header) +
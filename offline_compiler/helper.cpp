@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -7,6 +7,7 @@
 
 #include "runtime/helpers/hw_info.h"
 #include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/utilities/async_log_writer.h"
 #include "runtime/utilities/debug_settings_reader_creator.h"
 
 namespace OCLRT {
@@ -18,6 +19,14 @@ DebugSettingsManager<DebugLevel>::DebugSettingsManager() {
 template <DebugFunctionalityLevel DebugLevel>
 DebugSettingsManager<DebugLevel>::~DebugSettingsManager() = default;
 
+template <DebugFunctionalityLevel DebugLevel>
+void DebugSettingsManager<DebugLevel>::flushLogs() {
+}
+
+template <DebugFunctionalityLevel DebugLevel>
+void DebugSettingsManager<DebugLevel>::closeLogWriter() {
+}
+
 template <DebugFunctionalityLevel DebugLevel>
 void DebugSettingsManager<DebugLevel>::writeToFile(std::string filename, const char *str, size_t length, std::ios_base::openmode mode) {
     std::ofstream outFile(filename, mode);
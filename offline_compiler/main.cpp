@@ -7,6 +7,7 @@
 
 #include "decoder/binary_encoder.h"
 #include "decoder/binary_decoder.h"
+#include "offline_compiler/multi_command.h"
 #include "offline_compiler/offline_compiler.h"
 #include "offline_compiler/utilities/safety_caller.h"
 #include "runtime/os_interface/os_library.h"
@@ -33,6 +34,16 @@ int main(int numArgs, const char *argv[]) {
             } else {
                 return retVal;
             }
+        } else if (numArgs > 1 && !strcmp(argv[1], "batch")) { // -file manifest.txt -jobs 8
+            int retVal = CL_SUCCESS;
+            std::unique_ptr<MultiCommand> pMultiCommand(MultiCommand::create(numArgs, argv, retVal));
+            if (retVal == CL_SUCCESS) {
+                retVal = pMultiCommand->execute();
+                if (retVal == CL_SUCCESS && !pMultiCommand->isQuiet()) {
+                    printf("Build succeeded.\n");
+                }
+            }
+            return retVal;
         } else {
             int retVal = CL_SUCCESS;
             OfflineCompiler *pCompiler = OfflineCompiler::create(numArgs, argv, retVal);
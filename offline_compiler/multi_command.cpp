@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "offline_compiler/multi_command.h"
+#include "runtime/helpers/file_io.h"
+#include "runtime/os_interface/os_library.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <sstream>
+#include <thread>
+
+namespace OCLRT {
+
+bool stringsAreEqual(const char *string1, const char *string2);
+
+MultiCommand::MultiCommand() = default;
+
+MultiCommand::~MultiCommand() = default;
+
+MultiCommand *MultiCommand::create(size_t numArgs, const char *const *argv, int &retVal) {
+    retVal = CL_SUCCESS;
+    auto pMultiCommand = new MultiCommand();
+
+    retVal = pMultiCommand->initialize(numArgs, argv);
+
+    if (retVal != CL_SUCCESS) {
+        delete pMultiCommand;
+        pMultiCommand = nullptr;
+    }
+
+    return pMultiCommand;
+}
+
+int MultiCommand::initialize(size_t numArgs, const char *const *argv) {
+    int retVal = parseCommandLine(numArgs, argv);
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
+
+    void *pManifest = nullptr;
+    size_t manifestSize = loadDataFromFile(manifestFile.c_str(), pManifest);
+    if (manifestSize == 0) {
+        deleteDataReadFromFile(pManifest);
+        printf("Error: Cannot read manifest file %s.\n", manifestFile.c_str());
+        return INVALID_FILE;
+    }
+    std::string manifest(reinterpret_cast<char *>(pManifest), manifestSize);
+    deleteDataReadFromFile(pManifest);
+
+    retVal = parseManifest(manifest);
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
+
+    sharedState = std::make_shared<OfflineCompilerSharedState>();
+    sharedState->shareIntermediateRepresentation = true;
+    return CL_SUCCESS;
+}
+
+int MultiCommand::parseCommandLine(size_t numArgs, const char *const *argv) {
+    int retVal = CL_SUCCESS;
+
+    if (numArgs < 3) {
+        printUsage();
+        return PRINT_USAGE;
+    }
+
+    for (uint32_t argIndex = 2; argIndex < numArgs; argIndex++) {
+        if ((stringsAreEqual(argv[argIndex], "-file")) &&
+            (argIndex + 1 < numArgs)) {
+            manifestFile = argv[argIndex + 1];
+            argIndex++;
+        } else if ((stringsAreEqual(argv[argIndex], "-jobs")) &&
+                   (argIndex + 1 < numArgs)) {
+            jobs = static_cast<uint32_t>(atoi(argv[argIndex + 1]));
+            argIndex++;
+        } else if (stringsAreEqual(argv[argIndex], "-q")) {
+            quiet = true;
+        } else if (stringsAreEqual(argv[argIndex], "-?")) {
+            printUsage();
+            retVal = PRINT_USAGE;
+        } else {
+            printf("Invalid option (arg %d): %s\n", argIndex, argv[argIndex]);
+            retVal = INVALID_COMMAND_LINE;
+            break;
+        }
+    }
+
+    if (retVal == CL_SUCCESS) {
+        if (manifestFile.empty()) {
+            printf("Error: Manifest file name missing.\n");
+            retVal = INVALID_COMMAND_LINE;
+        } else if (!fileExists(manifestFile)) {
+            printf("Error: Manifest file %s missing.\n", manifestFile.c_str());
+            retVal = INVALID_FILE;
+        }
+    }
+
+    return retVal;
+}
+
+std::vector<std::string> MultiCommand::splitLine(const std::string &line) {
+    std::vector<std::string> args;
+    std::string current;
+    bool inQuotes = false;
+    bool hasToken = false;
+
+    for (auto c : line) {
+        if (c == '"') {
+            inQuotes = !inQuotes;
+            hasToken = true;
+        } else if (!inQuotes && (c == ' ' || c == '\t' || c == '\r')) {
+            if (hasToken) {
+                args.push_back(current);
+                current.clear();
+                hasToken = false;
+            }
+        } else {
+            current += c;
+            hasToken = true;
+        }
+    }
+    if (hasToken) {
+        args.push_back(current);
+    }
+    return args;
+}
+
+int MultiCommand::parseManifest(const std::string &manifest) {
+    std::istringstream stream(manifest);
+    std::string line;
+    size_t lineNumber = 0;
+
+    while (std::getline(stream, line)) {
+        lineNumber++;
+        auto args = splitLine(line);
+        if (args.empty() || args[0][0] == '#') {
+            continue;
+        }
+
+        auto deviceArg = std::find(args.begin(), args.end(), "-device");
+        if (deviceArg == args.end() || deviceArg + 1 == args.end()) {
+            printf("Error: Device name missing in line %zu of manifest %s.\n", lineNumber, manifestFile.c_str());
+            return INVALID_COMMAND_LINE;
+        }
+        auto deviceIndex = static_cast<size_t>(deviceArg - args.begin()) + 1;
+
+        std::istringstream devices(args[deviceIndex]);
+        std::string device;
+        bool severalDevices = args[deviceIndex].find(',') != std::string::npos;
+        while (std::getline(devices, device, ',')) {
+            if (device.empty()) {
+                continue;
+            }
+            Command command;
+            command.args.reserve(args.size() + 1);
+            command.args.push_back("ocloc");
+            command.args.insert(command.args.end(), args.begin(), args.end());
+            command.args[deviceIndex + 1] = device;
+            if (quiet) {
+                command.args.push_back("-q");
+            }
+            command.device = device;
+            command.deviceInOutputName = severalDevices;
+            command.lineNumber = lineNumber;
+            commands.push_back(std::move(command));
+        }
+    }
+
+    if (commands.empty()) {
+        printf("Error: No commands found in manifest %s.\n", manifestFile.c_str());
+        return INVALID_FILE;
+    }
+    return CL_SUCCESS;
+}
+
+int MultiCommand::createCompilers() {
+    std::map<std::string, size_t> outputs;
+    compilers.resize(commands.size());
+
+    for (size_t i = 0; i < commands.size(); i++) {
+        auto &command = commands[i];
+        std::vector<const char *> argv;
+        argv.reserve(command.args.size());
+        for (auto &arg : command.args) {
+            argv.push_back(arg.c_str());
+        }
+
+        compilers[i].reset(OfflineCompiler::create(argv.size(), argv.data(), command.retVal, sharedState));
+        if (command.retVal != CL_SUCCESS) {
+            continue;
+        }
+
+        compilers[i]->setDeviceNameInOutputFileBase(command.deviceInOutputName);
+
+        // two commands writing the same files would race
+        auto insertResult = outputs.insert({compilers[i]->getOutputFilePathTrunk(), command.lineNumber});
+        if (insertResult.second == false) {
+            command.retVal = INVALID_COMMAND_LINE;
+            command.buildLog = "Error: Output files collide with the command from line " + std::to_string(insertResult.first->second) + ", use -output or -out_dir to distinguish them.";
+            compilers[i].reset();
+        }
+    }
+
+    return CL_SUCCESS;
+}
+
+void MultiCommand::buildCompilers() {
+    std::atomic<size_t> nextCommand{0};
+    auto worker = [&]() {
+        size_t i;
+        while ((i = nextCommand++) < commands.size()) {
+            if (compilers[i] == nullptr) {
+                continue;
+            }
+            commands[i].retVal = compilers[i]->build();
+            commands[i].buildLog = compilers[i]->getBuildLog();
+            compilers[i].reset();
+        }
+    };
+
+    size_t numThreads = jobs ? jobs : std::max(1u, std::thread::hardware_concurrency());
+    numThreads = std::min(numThreads, commands.size());
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numThreads; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+int MultiCommand::execute() {
+    int retVal = createCompilers();
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
+    buildCompilers();
+
+    size_t failedCommands = 0;
+    for (auto &command : commands) {
+        if (!command.buildLog.empty()) {
+            printf("Line %zu, device %s:\n%s\n", command.lineNumber, command.device.c_str(), command.buildLog.c_str());
+        }
+        if (command.retVal != CL_SUCCESS) {
+            printf("Build of line %zu for device %s failed with error code: %d\n", command.lineNumber, command.device.c_str(), command.retVal);
+            if (failedCommands++ == 0) {
+                retVal = command.retVal;
+            }
+        }
+    }
+
+    if (!quiet) {
+        printf("Built %zu of %zu commands.\n", commands.size() - failedCommands, commands.size());
+    }
+    return retVal;
+}
+
+void MultiCommand::printUsage() {
+    printf("Compiles all commands listed in a manifest file within a single ocloc process\n\n");
+    printf("ocloc batch -file <manifest> [OPTIONS]\n\n");
+    printf("  -file <manifest>             Indicates the manifest file. Each line holds ocloc arguments\n");
+    printf("                               of one build, e.g. -file a.cl -device skl,kbl -options \"-g\".\n");
+    printf("                               Empty lines and lines starting with # are skipped.\n");
+    printf("                               Outputs of a line listing several devices are suffixed\n");
+    printf("                               with the device name.\n");
+    printf("  -jobs <count>                Number of builds running in parallel, defaults to the number\n");
+    printf("                               of hardware threads.\n");
+    printf("  -q                           Be more quiet. print only warnings and errors.\n");
+    printf("  -?                           Print this usage message.\n");
+}
+} // namespace OCLRT
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+#include "offline_compiler/offline_compiler.h"
+
+#include <CL/cl.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OCLRT {
+
+// Batch mode of ocloc: builds every command listed in a manifest file within one process.
+// Each manifest line holds regular ocloc arguments, "-device" accepts a comma separated list of targets.
+// Compiler libraries and front end results are shared between commands, back end compilations run in parallel.
+class MultiCommand {
+  public:
+    struct Command {
+        std::vector<std::string> args;
+        std::string device;
+        bool deviceInOutputName = false;
+        size_t lineNumber = 0;
+        int retVal = CL_SUCCESS;
+        std::string buildLog;
+    };
+
+    static MultiCommand *create(size_t numArgs, const char *const *argv, int &retVal);
+    int execute();
+    void printUsage();
+
+    MultiCommand &operator=(const MultiCommand &) = delete;
+    MultiCommand(const MultiCommand &) = delete;
+    ~MultiCommand();
+
+    bool isQuiet() const {
+        return quiet;
+    }
+
+    static std::vector<std::string> splitLine(const std::string &line);
+
+  protected:
+    MultiCommand();
+
+    int initialize(size_t numArgs, const char *const *argv);
+    int parseCommandLine(size_t numArgs, const char *const *argv);
+    int parseManifest(const std::string &manifest);
+    int createCompilers();
+    void buildCompilers();
+
+    std::string manifestFile;
+    uint32_t jobs = 0;
+    bool quiet = false;
+
+    std::vector<Command> commands;
+    std::vector<std::unique_ptr<OfflineCompiler>> compilers;
+    std::shared_ptr<OfflineCompilerSharedState> sharedState;
+};
+} // namespace OCLRT
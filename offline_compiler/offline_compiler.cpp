@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -14,7 +14,10 @@
 #include "ocl_igc_interface/platform_helper.h"
 #include "offline_compiler.h"
 #include "igfxfmid.h"
+#include "offline_compiler/source_dependencies.h"
+#include "runtime/compiler_interface/binary_cache.h"
 #include "runtime/helpers/file_io.h"
+#include "runtime/helpers/hash.h"
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/os_inc_base.h"
 #include "runtime/os_interface/os_library.h"
@@ -27,16 +30,25 @@
 #include <iomanip>
 #include <list>
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <set>
+#include <thread>
 
 #ifdef _WIN32
 #include <direct.h>
+#include <process.h>
 #define MakeDirectory _mkdir
 #define GetCurrentWorkingDirectory _getcwd
+#define GetCurrentProcessIdentifier _getpid
 #else
 #include <sys/stat.h>
+#include <unistd.h>
 #define MakeDirectory(dir) mkdir(dir, 0777)
 #define GetCurrentWorkingDirectory getcwd
+#define GetCurrentProcessIdentifier getpid
 #endif
 
 namespace OCLRT {
@@ -89,10 +101,15 @@ OfflineCompiler::~OfflineCompiler() {
 // Create
 ////////////////////////////////////////////////////////////////////////////////
 OfflineCompiler *OfflineCompiler::create(size_t numArgs, const char *const *argv, int &retVal) {
+    return create(numArgs, argv, retVal, std::make_shared<OfflineCompilerSharedState>());
+}
+
+OfflineCompiler *OfflineCompiler::create(size_t numArgs, const char *const *argv, int &retVal, std::shared_ptr<OfflineCompilerSharedState> sharedState) {
     retVal = CL_SUCCESS;
     auto pOffCompiler = new OfflineCompiler();
 
     if (pOffCompiler) {
+        pOffCompiler->sharedState = std::move(sharedState);
         retVal = pOffCompiler->initialize(numArgs, argv);
     }
 
@@ -118,14 +135,17 @@ int OfflineCompiler::buildSourceCode() {
         UNRECOVERABLE_IF(fclDeviceCtx == nullptr);
         UNRECOVERABLE_IF(igcDeviceCtx == nullptr);
 
+        auto fclMain = sharedState->fclMain.get();
+        auto igcMain = sharedState->igcMain.get();
+
         CIF::RAII::UPtr_t<IGC::OclTranslationOutputTagOCL> igcOutput;
         bool inputIsIntermediateRepresentation = inputFileLlvm || inputFileSpirV;
         if (false == inputIsIntermediateRepresentation) {
             IGC::CodeType::CodeType_t intermediateRepresentation = useLlvmText ? IGC::CodeType::llvmLl : preferredIntermediateRepresentation;
             // sourceCode.size() returns the number of characters without null terminated char
-            auto fclSrc = CIF::Builtins::CreateConstBuffer(fclMain.get(), sourceCode.c_str(), sourceCode.size() + 1);
-            auto fclOptions = CIF::Builtins::CreateConstBuffer(fclMain.get(), options.c_str(), options.size());
-            auto fclInternalOptions = CIF::Builtins::CreateConstBuffer(fclMain.get(), internalOptions.c_str(), internalOptions.size());
+            auto fclSrc = CIF::Builtins::CreateConstBuffer(fclMain, sourceCode.c_str(), sourceCode.size() + 1);
+            auto fclOptions = CIF::Builtins::CreateConstBuffer(fclMain, options.c_str(), options.size());
+            auto fclInternalOptions = CIF::Builtins::CreateConstBuffer(fclMain, internalOptions.c_str(), internalOptions.size());
 
             auto fclTranslationCtx = fclDeviceCtx->CreateTranslationCtx(IGC::CodeType::oclC, intermediateRepresentation);
             auto igcTranslationCtx = igcDeviceCtx->CreateTranslationCtx(intermediateRepresentation, IGC::CodeType::oclGenBin);
@@ -136,35 +156,62 @@ int OfflineCompiler::buildSourceCode() {
                 break;
             }
 
-            auto fclOutput = fclTranslationCtx->Translate(fclSrc.get(), fclOptions.get(),
-                                                          fclInternalOptions.get(), nullptr, 0);
-
-            if (fclOutput == nullptr) {
-                retVal = CL_OUT_OF_HOST_MEMORY;
-                break;
+            std::string irKey;
+            if (sharedState->shareIntermediateRepresentation) {
+                irKey = getIntermediateRepresentationKey(intermediateRepresentation);
+                OfflineCompilerSharedState::IntermediateRepresentation cachedIr;
+                if (sharedState->findIntermediateRepresentation(irKey, cachedIr)) {
+                    // front end output depends only on the source and options, only the back end is device specific
+                    storeBinary(irBinary, irBinarySize, cachedIr.binary.c_str(), cachedIr.binary.size());
+                    isSpirV = cachedIr.isSpirV;
+                    updateBuildLog(cachedIr.buildLog.c_str(), cachedIr.buildLog.size());
+
+                    auto igcSrc = CIF::Builtins::CreateConstBuffer(igcMain, irBinary, irBinarySize);
+                    igcOutput = igcTranslationCtx->Translate(igcSrc.get(), fclOptions.get(),
+                                                             fclInternalOptions.get(),
+                                                             nullptr, 0);
+                }
             }
 
-            UNRECOVERABLE_IF(fclOutput->GetBuildLog() == nullptr);
-            UNRECOVERABLE_IF(fclOutput->GetOutput() == nullptr);
+            if (igcOutput == nullptr) {
+                auto fclOutput = fclTranslationCtx->Translate(fclSrc.get(), fclOptions.get(),
+                                                              fclInternalOptions.get(), nullptr, 0);
 
-            if (fclOutput->Successful() == false) {
-                updateBuildLog(fclOutput->GetBuildLog()->GetMemory<char>(), fclOutput->GetBuildLog()->GetSizeRaw());
-                retVal = CL_BUILD_PROGRAM_FAILURE;
-                break;
-            }
+                if (fclOutput == nullptr) {
+                    retVal = CL_OUT_OF_HOST_MEMORY;
+                    break;
+                }
 
-            storeBinary(irBinary, irBinarySize, fclOutput->GetOutput()->GetMemory<char>(), fclOutput->GetOutput()->GetSizeRaw());
-            isSpirV = intermediateRepresentation == IGC::CodeType::spirV;
-            updateBuildLog(fclOutput->GetBuildLog()->GetMemory<char>(), fclOutput->GetBuildLog()->GetSizeRaw());
+                UNRECOVERABLE_IF(fclOutput->GetBuildLog() == nullptr);
+                UNRECOVERABLE_IF(fclOutput->GetOutput() == nullptr);
 
-            igcOutput = igcTranslationCtx->Translate(fclOutput->GetOutput(), fclOptions.get(),
-                                                     fclInternalOptions.get(),
-                                                     nullptr, 0);
+                if (fclOutput->Successful() == false) {
+                    updateBuildLog(fclOutput->GetBuildLog()->GetMemory<char>(), fclOutput->GetBuildLog()->GetSizeRaw());
+                    retVal = CL_BUILD_PROGRAM_FAILURE;
+                    break;
+                }
+
+                storeBinary(irBinary, irBinarySize, fclOutput->GetOutput()->GetMemory<char>(), fclOutput->GetOutput()->GetSizeRaw());
+                isSpirV = intermediateRepresentation == IGC::CodeType::spirV;
+                updateBuildLog(fclOutput->GetBuildLog()->GetMemory<char>(), fclOutput->GetBuildLog()->GetSizeRaw());
+
+                if (sharedState->shareIntermediateRepresentation) {
+                    OfflineCompilerSharedState::IntermediateRepresentation ir;
+                    ir.binary.assign(irBinary, irBinarySize);
+                    ir.buildLog.assign(fclOutput->GetBuildLog()->GetMemory<char>(), fclOutput->GetBuildLog()->GetSizeRaw());
+                    ir.isSpirV = isSpirV;
+                    sharedState->storeIntermediateRepresentation(irKey, ir);
+                }
+
+                igcOutput = igcTranslationCtx->Translate(fclOutput->GetOutput(), fclOptions.get(),
+                                                         fclInternalOptions.get(),
+                                                         nullptr, 0);
+            }
 
         } else {
-            auto igcSrc = CIF::Builtins::CreateConstBuffer(igcMain.get(), sourceCode.c_str(), sourceCode.size());
-            auto igcOptions = CIF::Builtins::CreateConstBuffer(igcMain.get(), nullptr, 0);
-            auto igcInternalOptions = CIF::Builtins::CreateConstBuffer(igcMain.get(), internalOptions.c_str(), internalOptions.size());
+            auto igcSrc = CIF::Builtins::CreateConstBuffer(igcMain, sourceCode.c_str(), sourceCode.size());
+            auto igcOptions = CIF::Builtins::CreateConstBuffer(igcMain, nullptr, 0);
+            auto igcInternalOptions = CIF::Builtins::CreateConstBuffer(igcMain, internalOptions.c_str(), internalOptions.size());
             auto igcTranslationCtx = igcDeviceCtx->CreateTranslationCtx(inputFileSpirV ? IGC::CodeType::spirV : IGC::CodeType::llvmBc, IGC::CodeType::oclGenBin);
             igcOutput = igcTranslationCtx->Translate(igcSrc.get(), igcOptions.get(), igcInternalOptions.get(), nullptr, 0);
         }
@@ -192,11 +239,23 @@ int OfflineCompiler::buildSourceCode() {
 int OfflineCompiler::build() {
     int retVal = CL_SUCCESS;
 
-    retVal = buildSourceCode();
+    std::string cacheFileName;
+    // without known compilers identity cached entries could come from other compiler builds
+    bool useCache = !cacheDirectory.empty() && !sharedState->getCompilersIdentity().empty();
+    if (useCache) {
+        cacheFileName = getCacheFileName();
+        builtFromCache = loadFromCache(cacheFileName);
+    }
+
+    if (!builtFromCache) {
+        retVal = buildSourceCode();
+    }
 
     if (retVal == CL_SUCCESS) {
-        generateElfBinary();
         writeOutAllFiles();
+        if (useCache && !builtFromCache) {
+            storeInCache(cacheFileName);
+        }
     }
 
     return retVal;
@@ -324,28 +383,16 @@ int OfflineCompiler::initialize(size_t numArgs, const char *const *argv) {
         sourceCode = (pSource != nullptr) ? getStringWithinDelimiters((char *)pSourceFromFile) : (char *)pSourceFromFile;
     }
 
-    this->fclLib.reset(OsLibrary::load(Os::frontEndDllName));
-    if (this->fclLib == nullptr) {
-        return CL_OUT_OF_HOST_MEMORY;
+    if (sharedState == nullptr) {
+        sharedState = std::make_shared<OfflineCompilerSharedState>();
     }
-
-    auto fclCreateMain = reinterpret_cast<CIF::CreateCIFMainFunc_t>(this->fclLib->getProcAddress(CIF::CreateCIFMainFuncName));
-    if (fclCreateMain == nullptr) {
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-
-    this->fclMain = CIF::RAII::UPtr(createMainNoSanitize(fclCreateMain));
-    if (this->fclMain == nullptr) {
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-
-    if (false == this->fclMain->IsCompatible<IGC::FclOclDeviceCtx>()) {
-        // given FCL is not compatible
-        DEBUG_BREAK_IF(true);
-        return CL_OUT_OF_HOST_MEMORY;
+    auto lock = sharedState->lock();
+    retVal = sharedState->loadCompilerLibraries();
+    if (retVal != CL_SUCCESS) {
+        return retVal;
     }
 
-    this->fclDeviceCtx = this->fclMain->CreateInterface<IGC::FclOclDeviceCtxTagOCL>();
+    this->fclDeviceCtx = sharedState->fclMain->CreateInterface<IGC::FclOclDeviceCtxTagOCL>();
     if (this->fclDeviceCtx == nullptr) {
         return CL_OUT_OF_HOST_MEMORY;
     }
@@ -353,28 +400,7 @@ int OfflineCompiler::initialize(size_t numArgs, const char *const *argv) {
     fclDeviceCtx->SetOclApiVersion(hwInfo->capabilityTable.clVersionSupport * 10);
     preferredIntermediateRepresentation = fclDeviceCtx->GetPreferredIntermediateRepresentation();
 
-    this->igcLib.reset(OsLibrary::load(Os::igcDllName));
-    if (this->igcLib == nullptr) {
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-
-    auto igcCreateMain = reinterpret_cast<CIF::CreateCIFMainFunc_t>(this->igcLib->getProcAddress(CIF::CreateCIFMainFuncName));
-    if (igcCreateMain == nullptr) {
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-
-    this->igcMain = CIF::RAII::UPtr(createMainNoSanitize(igcCreateMain));
-    if (this->igcMain == nullptr) {
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-
-    if (false == this->igcMain->IsCompatible<IGC::IgcOclDeviceCtx>()) {
-        // given IGC is not compatible
-        DEBUG_BREAK_IF(true);
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-
-    this->igcDeviceCtx = this->igcMain->CreateInterface<IGC::IgcOclDeviceCtxTagOCL>();
+    this->igcDeviceCtx = sharedState->igcMain->CreateInterface<IGC::IgcOclDeviceCtxTagOCL>();
     if (this->igcDeviceCtx == nullptr) {
         return CL_OUT_OF_HOST_MEMORY;
     }
@@ -422,6 +448,106 @@ int OfflineCompiler::initialize(size_t numArgs, const char *const *argv) {
     return retVal;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// LoadCompilerLibraries
+////////////////////////////////////////////////////////////////////////////////
+int OfflineCompilerSharedState::loadCompilerLibraries() {
+    if (fclMain != nullptr && igcMain != nullptr) {
+        return CL_SUCCESS;
+    }
+
+    this->fclLib.reset(OsLibrary::load(Os::frontEndDllName));
+    if (this->fclLib == nullptr) {
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    auto fclCreateMain = reinterpret_cast<CIF::CreateCIFMainFunc_t>(this->fclLib->getProcAddress(CIF::CreateCIFMainFuncName));
+    if (fclCreateMain == nullptr) {
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    this->fclMain = CIF::RAII::UPtr(createMainNoSanitize(fclCreateMain));
+    if (this->fclMain == nullptr) {
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    if (false == this->fclMain->IsCompatible<IGC::FclOclDeviceCtx>()) {
+        // given FCL is not compatible
+        DEBUG_BREAK_IF(true);
+        this->fclMain.reset();
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    this->igcLib.reset(OsLibrary::load(Os::igcDllName));
+    if (this->igcLib == nullptr) {
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    auto igcCreateMain = reinterpret_cast<CIF::CreateCIFMainFunc_t>(this->igcLib->getProcAddress(CIF::CreateCIFMainFuncName));
+    if (igcCreateMain == nullptr) {
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    this->igcMain = CIF::RAII::UPtr(createMainNoSanitize(igcCreateMain));
+    if (this->igcMain == nullptr) {
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    if (false == this->igcMain->IsCompatible<IGC::IgcOclDeviceCtx>()) {
+        // given IGC is not compatible
+        DEBUG_BREAK_IF(true);
+        this->igcMain.reset();
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    return CL_SUCCESS;
+}
+
+std::string OfflineCompilerSharedState::getLibraryIdentity(OsLibrary &library) {
+    // interface versions stay the same across compiler updates, so the library file itself identifies the compiler
+    std::string libraryPath = library.getFullPath();
+    if (libraryPath.empty()) {
+        return std::string();
+    }
+    void *pLibrary = nullptr;
+    size_t librarySize = loadDataFromFile(libraryPath.c_str(), pLibrary);
+    std::string identity;
+    if (librarySize) {
+        identity = std::to_string(Hash::hash(reinterpret_cast<const char *>(pLibrary), librarySize));
+    }
+    deleteDataReadFromFile(pLibrary);
+    return identity;
+}
+
+const std::string &OfflineCompilerSharedState::getCompilersIdentity() {
+    std::call_once(compilersIdentityOnce, [this]() {
+        if (fclLib == nullptr || igcLib == nullptr) {
+            return;
+        }
+        auto fclIdentity = getLibraryIdentity(*fclLib);
+        auto igcIdentity = getLibraryIdentity(*igcLib);
+        if (!fclIdentity.empty() && !igcIdentity.empty()) {
+            compilersIdentity = " -fcl_identity " + fclIdentity + " -igc_identity " + igcIdentity;
+        }
+    });
+    return compilersIdentity;
+}
+
+bool OfflineCompilerSharedState::findIntermediateRepresentation(const std::string &key, IntermediateRepresentation &ir) {
+    std::lock_guard<std::mutex> lock(irMtx);
+    auto it = irCache.find(key);
+    if (it == irCache.end()) {
+        return false;
+    }
+    ir = it->second;
+    return true;
+}
+
+void OfflineCompilerSharedState::storeIntermediateRepresentation(const std::string &key, const IntermediateRepresentation &ir) {
+    std::lock_guard<std::mutex> lock(irMtx);
+    irCache[key] = ir;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // ParseCommandLine
 ////////////////////////////////////////////////////////////////////////////////
@@ -478,6 +604,10 @@ int OfflineCompiler::parseCommandLine(size_t numArgs, const char *const *argv) {
                    (argIndex + 1 < numArgs)) {
             outputDirectory = argv[argIndex + 1];
             argIndex++;
+        } else if ((stringsAreEqual(argv[argIndex], "-cache_dir")) &&
+                   (argIndex + 1 < numArgs)) {
+            cacheDirectory = argv[argIndex + 1];
+            argIndex++;
         } else if (stringsAreEqual(argv[argIndex], "-q")) {
             quiet = true;
         } else if (stringsAreEqual(argv[argIndex], "-?")) {
@@ -596,6 +726,41 @@ std::string OfflineCompiler::getFileNameTrunk(std::string &filePath) {
 
     return fileTrunk;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// GetOutputFileBase
+////////////////////////////////////////////////////////////////////////////////
+std::string OfflineCompiler::getOutputFileBase() {
+    std::string fileBase = outputFile.empty() ? getFileNameTrunk(inputFile) : outputFile;
+    fileBase.append("_" + familyNameWithType);
+    if (deviceNameInOutputFileBase) {
+        // devices of one family share familyNameWithType
+        fileBase.append("_" + deviceName);
+    }
+    return fileBase;
+}
+
+std::string OfflineCompiler::getOutputFilePathTrunk() {
+    return generateFilePath(outputDirectory, getOutputFileBase(), "") + generateOptsSuffix();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// GetIntermediateRepresentationKey
+////////////////////////////////////////////////////////////////////////////////
+std::string OfflineCompiler::getIntermediateRepresentationKey(IGC::CodeType::CodeType_t intermediateRepresentation) const {
+    std::string key;
+    key.reserve(sourceCode.size() + options.size() + internalOptions.size() + 32);
+    key.append(sourceCode);
+    key.append(1, '\0');
+    key.append(options);
+    key.append(1, '\0');
+    key.append(internalOptions);
+    key.append(1, '\0');
+    key.append(std::to_string(static_cast<uint64_t>(intermediateRepresentation)));
+    key.append(1, '\0');
+    key.append(std::to_string(hwInfo->capabilityTable.clVersionSupport));
+    return key;
+}
 //
 std::string getDevicesTypes() {
     std::list<std::string> prefixes;
@@ -639,8 +804,12 @@ void OfflineCompiler::printUsage() {
     printf("  -spirv_input                  Indicates input file is a SpirV binary\n");
     printf("  -options <options>           Compiler options.\n");
     printf("  -options_name                Add suffix with compile options to filename\n");
+    printf("  -cache_dir <cache_dir>       Reuse outputs of previous builds stored in the given directory\n");
+    printf("                               when the source, included headers, options and device match.\n");
     printf("  -q                           Be more quiet. print only warnings and errors.\n");
     printf("  -?                           Print this usage message.\n");
+    printf("\n");
+    printf("To build many sources or targets within one process use: ocloc batch -?\n");
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -674,16 +843,7 @@ bool OfflineCompiler::generateElfBinary() {
 
     if (retVal) {
         CLElfLib::CElfWriter elfWriter(CLElfLib::E_EH_TYPE::EH_TYPE_OPENCL_EXECUTABLE, CLElfLib::E_EH_MACHINE::EH_MACHINE_NONE, 0);
-
-        elfWriter.addSection(CLElfLib::SSectionNode(CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_OPTIONS, CLElfLib::E_SH_FLAG::SH_FLAG_NONE, "BuildOptions", options, static_cast<uint32_t>(strlen(options.c_str()) + 1u)));
-        std::string irBinaryTemp = irBinary ? std::string(irBinary, irBinarySize) : "";
-        elfWriter.addSection(CLElfLib::SSectionNode(isSpirV ? CLElfLib::E_SH_TYPE::SH_TYPE_SPIRV : CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_LLVM_BINARY, CLElfLib::E_SH_FLAG::SH_FLAG_NONE, "Intel(R) OpenCL LLVM Object", std::move(irBinaryTemp), static_cast<uint32_t>(irBinarySize)));
-
-        // Add the device binary if it exists
-        if (genBinary) {
-            std::string genBinaryTemp = genBinary ? std::string(genBinary, genBinarySize) : "";
-            elfWriter.addSection(CLElfLib::SSectionNode(CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_DEV_BINARY, CLElfLib::E_SH_FLAG::SH_FLAG_NONE, "Intel(R) OpenCL Device Binary", std::move(genBinaryTemp), static_cast<uint32_t>(genBinarySize)));
-        }
+        addElfSections(elfWriter);
 
         elfBinarySize = elfWriter.getTotalBinarySize();
         elfBinary.resize(elfBinarySize);
@@ -693,33 +853,59 @@ bool OfflineCompiler::generateElfBinary() {
     return retVal;
 }
 
+void OfflineCompiler::addElfSections(CLElfLib::CElfWriter &elfWriter) {
+    elfWriter.addSection(CLElfLib::SSectionNode(CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_OPTIONS, CLElfLib::E_SH_FLAG::SH_FLAG_NONE, "BuildOptions", options, static_cast<uint32_t>(strlen(options.c_str()) + 1u)));
+    elfWriter.addSectionWithDataReference(isSpirV ? CLElfLib::E_SH_TYPE::SH_TYPE_SPIRV : CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_LLVM_BINARY, CLElfLib::E_SH_FLAG::SH_FLAG_NONE, "Intel(R) OpenCL LLVM Object", irBinary, static_cast<uint32_t>(irBinarySize));
+
+    // Add the device binary if it exists
+    if (genBinary) {
+        elfWriter.addSectionWithDataReference(CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_DEV_BINARY, CLElfLib::E_SH_FLAG::SH_FLAG_NONE, "Intel(R) OpenCL Device Binary", genBinary, static_cast<uint32_t>(genBinarySize));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// WriteElfBinary
+////////////////////////////////////////////////////////////////////////////////
+bool OfflineCompiler::writeElfBinary(const std::string &filePath) {
+    if (!genBinary || !genBinarySize) {
+        return false;
+    }
+
+    CLElfLib::CElfWriter elfWriter(CLElfLib::E_EH_TYPE::EH_TYPE_OPENCL_EXECUTABLE, CLElfLib::E_EH_MACHINE::EH_MACHINE_NONE, 0);
+    addElfSections(elfWriter);
+
+    // stream sections straight to the file instead of materializing the whole ELF first
+    std::ofstream file(filePath, std::ios::binary);
+    elfWriter.resolveBinary(file);
+    return file.good();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // WriteOutAllFiles
 ////////////////////////////////////////////////////////////////////////////////
+static void createDirectories(const std::string &directory) {
+    std::list<std::string> dirList;
+    std::string tmp = directory;
+    size_t pos = directory.size() + 1;
+
+    do {
+        dirList.push_back(tmp);
+        pos = tmp.find_last_of("/\\", pos);
+        tmp = tmp.substr(0, pos);
+    } while (pos != std::string::npos);
+
+    while (!dirList.empty()) {
+        MakeDirectory(dirList.back().c_str());
+        dirList.pop_back();
+    }
+}
+
 void OfflineCompiler::writeOutAllFiles() {
-    std::string fileBase;
     std::string fileTrunk = getFileNameTrunk(inputFile);
-    if (outputFile.empty()) {
-        fileBase = fileTrunk + "_" + familyNameWithType;
-    } else {
-        fileBase = outputFile + "_" + familyNameWithType;
-    }
+    std::string fileBase = getOutputFileBase();
 
     if (outputDirectory != "") {
-        std::list<std::string> dirList;
-        std::string tmp = outputDirectory;
-        size_t pos = outputDirectory.size() + 1;
-
-        do {
-            dirList.push_back(tmp);
-            pos = tmp.find_last_of("/\\", pos);
-            tmp = tmp.substr(0, pos);
-        } while (pos != std::string::npos);
-
-        while (!dirList.empty()) {
-            MakeDirectory(dirList.back().c_str());
-            dirList.pop_back();
-        }
+        createDirectories(outputDirectory);
     }
 
     if (irBinary) {
@@ -746,13 +932,8 @@ void OfflineCompiler::writeOutAllFiles() {
         }
     }
 
-    if (!elfBinary.empty()) {
-        std::string elfOutputFile = generateFilePath(outputDirectory, fileBase, ".bin") + generateOptsSuffix();
-
-        writeDataToFile(
-            elfOutputFile.c_str(),
-            elfBinary.data(),
-            elfBinarySize);
+    if (genBinary && genBinarySize) {
+        writeElfBinary(generateFilePath(outputDirectory, fileBase, ".bin") + generateOptsSuffix());
     }
 
     if (debugDataBinary) {
@@ -765,6 +946,148 @@ void OfflineCompiler::writeOutAllFiles() {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// GetCacheFileName
+////////////////////////////////////////////////////////////////////////////////
+std::string OfflineCompiler::getCacheFileName() {
+    std::set<std::string> includedFiles;
+    std::set<std::string> unresolvedIncludes;
+    if (!inputFileLlvm && !inputFileSpirV) {
+        collectIncludedFiles(sourceCode, getDirectoryName(inputFile), getIncludeDirectories(options), includedFiles, unresolvedIncludes);
+    }
+
+    std::string input = sourceCode;
+    for (auto &includedFile : includedFiles) {
+        void *pHeader = nullptr;
+        size_t headerSize = loadDataFromFile(includedFile.c_str(), pHeader);
+        input.append("----");
+        input.append(includedFile);
+        input.append("----");
+        if (headerSize) {
+            input.append(reinterpret_cast<char *>(pHeader), headerSize);
+        }
+        deleteDataReadFromFile(pHeader);
+    }
+    for (auto &unresolvedInclude : unresolvedIncludes) {
+        input.append("----");
+        input.append(unresolvedInclude);
+    }
+
+    std::string buildFlags = options;
+    buildFlags.append(useLlvmText ? " -llvm_text" : "");
+    buildFlags.append(inputFileLlvm ? " -llvm_input" : "");
+    buildFlags.append(inputFileSpirV ? " -spirv_input" : "");
+    // entries produced by other compiler binaries must not be reused
+    if (sharedState) {
+        buildFlags.append(sharedState->getCompilersIdentity());
+    }
+
+    return BinaryCache::getCachedFileName(*hwInfo, ArrayRef<const char>(input.c_str(), input.size()),
+                                          ArrayRef<const char>(buildFlags.c_str(), buildFlags.size()),
+                                          ArrayRef<const char>(internalOptions.c_str(), internalOptions.size()));
+}
+
+struct CacheEntryHeader {
+    static constexpr uint32_t magic = 0x434f434c;
+    static constexpr uint32_t version = 1;
+
+    uint32_t entryMagic;
+    uint32_t entryVersion;
+    uint32_t isSpirV;
+    uint32_t reserved;
+    uint64_t irBinarySize;
+    uint64_t genBinarySize;
+    uint64_t debugDataBinarySize;
+    uint64_t buildLogSize;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// LoadFromCache
+////////////////////////////////////////////////////////////////////////////////
+bool OfflineCompiler::loadFromCache(const std::string &cacheFileName) {
+    std::string cacheFilePath = generateFilePath(cacheDirectory, cacheFileName, ".ocloc_cache");
+    if (!fileExists(cacheFilePath)) {
+        return false;
+    }
+
+    void *pEntry = nullptr;
+    size_t entrySize = loadDataFromFile(cacheFilePath.c_str(), pEntry);
+    struct Helper {
+        static void deleter(void *ptr) { deleteDataReadFromFile(ptr); }
+    };
+    auto entryRaii = std::unique_ptr<void, decltype(&Helper::deleter)>{pEntry, Helper::deleter};
+
+    CacheEntryHeader header = {};
+    if (entrySize < sizeof(header)) {
+        return false;
+    }
+    memcpy_s(&header, sizeof(header), pEntry, sizeof(header));
+    if (header.entryMagic != CacheEntryHeader::magic || header.entryVersion != CacheEntryHeader::version ||
+        header.genBinarySize == 0 ||
+        sizeof(header) + header.irBinarySize + header.genBinarySize + header.debugDataBinarySize + header.buildLogSize != entrySize) {
+        return false;
+    }
+
+    auto data = reinterpret_cast<const char *>(pEntry) + sizeof(header);
+    if (header.irBinarySize) {
+        storeBinary(irBinary, irBinarySize, data, static_cast<size_t>(header.irBinarySize));
+        data += header.irBinarySize;
+    }
+    storeBinary(genBinary, genBinarySize, data, static_cast<size_t>(header.genBinarySize));
+    data += header.genBinarySize;
+    if (header.debugDataBinarySize) {
+        storeBinary(debugDataBinary, debugDataBinarySize, data, static_cast<size_t>(header.debugDataBinarySize));
+        data += header.debugDataBinarySize;
+    }
+    updateBuildLog(data, static_cast<size_t>(header.buildLogSize));
+    isSpirV = header.isSpirV != 0;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// StoreInCache
+////////////////////////////////////////////////////////////////////////////////
+bool OfflineCompiler::storeInCache(const std::string &cacheFileName) {
+    if (!genBinary || !genBinarySize) {
+        return false;
+    }
+
+    CacheEntryHeader header = {};
+    header.entryMagic = CacheEntryHeader::magic;
+    header.entryVersion = CacheEntryHeader::version;
+    header.isSpirV = isSpirV ? 1 : 0;
+    header.irBinarySize = irBinary ? irBinarySize : 0;
+    header.genBinarySize = genBinarySize;
+    header.debugDataBinarySize = debugDataBinary ? debugDataBinarySize : 0;
+    header.buildLogSize = buildLog.size();
+
+    std::string entry;
+    entry.reserve(sizeof(header) + header.irBinarySize + header.genBinarySize + header.debugDataBinarySize + header.buildLogSize);
+    entry.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    entry.append(irBinary ? irBinary : "", static_cast<size_t>(header.irBinarySize));
+    entry.append(genBinary, genBinarySize);
+    entry.append(debugDataBinary ? debugDataBinary : "", static_cast<size_t>(header.debugDataBinarySize));
+    entry.append(buildLog);
+
+    createDirectories(cacheDirectory);
+
+    // entries are written under a name unique per process and thread first, so concurrent builds never observe a partially written entry
+    std::string cacheFilePath = generateFilePath(cacheDirectory, cacheFileName, ".ocloc_cache");
+    std::string tmpFilePath = cacheFilePath + "." + std::to_string(GetCurrentProcessIdentifier()) + "." +
+                              std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    if (writeDataToFile(tmpFilePath.c_str(), entry.c_str(), entry.size()) != entry.size()) {
+        std::remove(tmpFilePath.c_str());
+        return false;
+    }
+    std::remove(cacheFilePath.c_str());
+    if (std::rename(tmpFilePath.c_str(), cacheFilePath.c_str()) != 0) {
+        std::remove(tmpFilePath.c_str());
+        return false;
+    }
+    return true;
+}
+
 bool OfflineCompiler::readOptionsFromFile(std::string &options, const std::string &file) {
     if (!fileExists(file)) {
         return false;
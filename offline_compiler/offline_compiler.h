@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -11,8 +11,10 @@
 #include "ocl_igc_interface/fcl_ocl_device_ctx.h"
 #include "elf/writer.h"
 #include <cstdint>
-#include <string>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 
 namespace OCLRT {
 
@@ -29,9 +31,48 @@ enum ErrorCode {
 
 std::string generateFilePath(const std::string &directory, const std::string &fileNameBase, const char *extension);
 
+// Compiler libraries and front-end results shared by all OfflineCompiler instances of one ocloc invocation.
+// Translations may run concurrently, creation of device contexts is serialized with lock().
+class OfflineCompilerSharedState {
+  public:
+    struct IntermediateRepresentation {
+        std::string binary;
+        std::string buildLog;
+        bool isSpirV = false;
+    };
+
+    int loadCompilerLibraries();
+    const std::string &getCompilersIdentity();
+
+    std::unique_lock<std::mutex> lock() {
+        return std::unique_lock<std::mutex>{mtx};
+    }
+
+    bool findIntermediateRepresentation(const std::string &key, IntermediateRepresentation &ir);
+    void storeIntermediateRepresentation(const std::string &key, const IntermediateRepresentation &ir);
+
+    std::unique_ptr<OsLibrary> igcLib = nullptr;
+    CIF::RAII::UPtr_t<CIF::CIFMain> igcMain = nullptr;
+
+    std::unique_ptr<OsLibrary> fclLib = nullptr;
+    CIF::RAII::UPtr_t<CIF::CIFMain> fclMain = nullptr;
+
+    bool shareIntermediateRepresentation = false;
+
+  protected:
+    static std::string getLibraryIdentity(OsLibrary &library);
+
+    std::mutex mtx;
+    std::mutex irMtx;
+    std::map<std::string, IntermediateRepresentation> irCache;
+    std::once_flag compilersIdentityOnce;
+    std::string compilersIdentity;
+};
+
 class OfflineCompiler {
   public:
     static OfflineCompiler *create(size_t numArgs, const char *const *argv, int &retVal);
+    static OfflineCompiler *create(size_t numArgs, const char *const *argv, int &retVal, std::shared_ptr<OfflineCompilerSharedState> sharedState);
     int build();
     std::string &getBuildLog();
     void printUsage();
@@ -47,11 +88,19 @@ class OfflineCompiler {
     std::string parseBinAsCharArray(uint8_t *binary, size_t size, std::string &fileName);
     static bool readOptionsFromFile(std::string &optionsOut, const std::string &file);
 
+    std::string getOutputFilePathTrunk();
+
+    void setDeviceNameInOutputFileBase(bool value) {
+        deviceNameInOutputFileBase = value;
+    }
+
   protected:
     OfflineCompiler();
 
     int getHardwareInfo(const char *pDeviceName);
     std::string getFileNameTrunk(std::string &filePath);
+    std::string getOutputFileBase();
+    std::string getIntermediateRepresentationKey(IGC::CodeType::CodeType_t intermediateRepresentation) const;
     std::string getStringWithinDelimiters(const std::string &src);
     int initialize(size_t numArgs, const char *const *argv);
     int parseCommandLine(size_t numArgs, const char *const *argv);
@@ -60,6 +109,8 @@ class OfflineCompiler {
     int buildSourceCode();
     void updateBuildLog(const char *pErrorString, const size_t errorStringSize);
     bool generateElfBinary();
+    void addElfSections(CLElfLib::CElfWriter &elfWriter);
+    bool writeElfBinary(const std::string &filePath);
     std::string generateFilePathForIr(const std::string &fileNameBase) {
         const char *ext = (isSpirV) ? ".spv" : ".bc";
         return generateFilePath(outputDirectory, fileNameBase, useLlvmText ? ".ll" : ext);
@@ -71,6 +122,9 @@ class OfflineCompiler {
         return suffix;
     }
     void writeOutAllFiles();
+    std::string getCacheFileName();
+    bool loadFromCache(const std::string &cacheFileName);
+    bool storeInCache(const std::string &cacheFileName);
     const HardwareInfo *hwInfo = nullptr;
 
     std::string deviceName;
@@ -82,6 +136,7 @@ class OfflineCompiler {
     std::string internalOptions;
     std::string sourceCode;
     std::string buildLog;
+    std::string cacheDirectory;
 
     bool useLlvmText = false;
     bool useCppFile = false;
@@ -89,6 +144,8 @@ class OfflineCompiler {
     bool quiet = false;
     bool inputFileLlvm = false;
     bool inputFileSpirV = false;
+    bool builtFromCache = false;
+    bool deviceNameInOutputFileBase = false;
 
     CLElfLib::ElfBinaryStorage elfBinary;
     size_t elfBinarySize = 0;
@@ -100,12 +157,8 @@ class OfflineCompiler {
     char *debugDataBinary = nullptr;
     size_t debugDataBinarySize = 0;
 
-    std::unique_ptr<OsLibrary> igcLib = nullptr;
-    CIF::RAII::UPtr_t<CIF::CIFMain> igcMain = nullptr;
+    std::shared_ptr<OfflineCompilerSharedState> sharedState;
     CIF::RAII::UPtr_t<IGC::IgcOclDeviceCtxTagOCL> igcDeviceCtx = nullptr;
-
-    std::unique_ptr<OsLibrary> fclLib = nullptr;
-    CIF::RAII::UPtr_t<CIF::CIFMain> fclMain = nullptr;
     CIF::RAII::UPtr_t<IGC::FclOclDeviceCtxTagOCL> fclDeviceCtx = nullptr;
     IGC::CodeType::CodeType_t preferredIntermediateRepresentation;
 };
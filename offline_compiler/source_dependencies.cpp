@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "offline_compiler/source_dependencies.h"
+#include "runtime/helpers/file_io.h"
+
+#include <sstream>
+
+namespace OCLRT {
+
+std::string getDirectoryName(const std::string &filePath) {
+    auto slashPos = filePath.find_last_of("\\/");
+    if (slashPos == std::string::npos) {
+        return "";
+    }
+    return filePath.substr(0, slashPos + 1);
+}
+
+std::vector<std::string> getIncludeDirectories(const std::string &options) {
+    std::vector<std::string> includeDirectories;
+    std::istringstream stream(options);
+    std::string option;
+
+    while (stream >> option) {
+        if (option == "-I") {
+            if (stream >> option) {
+                includeDirectories.push_back(option);
+            }
+        } else if (option.compare(0, 2, "-I") == 0) {
+            includeDirectories.push_back(option.substr(2));
+        }
+    }
+    return includeDirectories;
+}
+
+static bool parseIncludeDirective(const std::string &line, std::string &headerName) {
+    auto pos = line.find_first_not_of(" \t");
+    if (pos == std::string::npos || line[pos] != '#') {
+        return false;
+    }
+    pos = line.find_first_not_of(" \t", pos + 1);
+    if (pos == std::string::npos || line.compare(pos, 7, "include") != 0) {
+        return false;
+    }
+    pos = line.find_first_not_of(" \t", pos + 7);
+    if (pos == std::string::npos || (line[pos] != '"' && line[pos] != '<')) {
+        return false;
+    }
+    char closingChar = (line[pos] == '"') ? '"' : '>';
+    auto endPos = line.find(closingChar, pos + 1);
+    if (endPos == std::string::npos) {
+        return false;
+    }
+    headerName = line.substr(pos + 1, endPos - pos - 1);
+    return !headerName.empty();
+}
+
+static std::string joinPath(const std::string &directory, const std::string &fileName) {
+    if (directory.empty()) {
+        return fileName;
+    }
+    auto lastChar = *directory.rbegin();
+    if (lastChar == '/' || lastChar == '\\') {
+        return directory + fileName;
+    }
+    return directory + "/" + fileName;
+}
+
+void collectIncludedFiles(const std::string &source, const std::string &sourceDirectory,
+                          const std::vector<std::string> &includeDirectories,
+                          std::set<std::string> &includedFiles, std::set<std::string> &unresolvedIncludes) {
+    std::istringstream stream(source);
+    std::string line;
+    std::string headerName;
+
+    while (std::getline(stream, line)) {
+        if (!parseIncludeDirective(line, headerName)) {
+            continue;
+        }
+
+        std::string headerPath = joinPath(sourceDirectory, headerName);
+        for (auto it = includeDirectories.begin(); !fileExists(headerPath) && it != includeDirectories.end(); it++) {
+            headerPath = joinPath(*it, headerName);
+        }
+        if (!fileExists(headerPath)) {
+            unresolvedIncludes.insert(headerName);
+            continue;
+        }
+        if (includedFiles.insert(headerPath).second == false) {
+            continue;
+        }
+
+        void *pHeader = nullptr;
+        size_t headerSize = loadDataFromFile(headerPath.c_str(), pHeader);
+        std::string header = headerSize ? std::string(reinterpret_cast<char *>(pHeader), headerSize) : "";
+        deleteDataReadFromFile(pHeader);
+
+        collectIncludedFiles(header, getDirectoryName(headerPath), includeDirectories, includedFiles, unresolvedIncludes);
+    }
+}
+} // namespace OCLRT
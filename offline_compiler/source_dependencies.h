@@ -0,0 +1,25 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+#include <set>
+#include <string>
+#include <vector>
+
+namespace OCLRT {
+
+std::string getDirectoryName(const std::string &filePath);
+std::vector<std::string> getIncludeDirectories(const std::string &options);
+
+// Collects files pulled in by #include directives of the source, recursively.
+// Headers are looked up next to the including file first and then in include directories.
+// Directives are not preprocessed, so conditionally included headers are reported as well.
+// Headers which cannot be found (e.g. provided by the compiler) are reported in unresolvedIncludes.
+void collectIncludedFiles(const std::string &source, const std::string &sourceDirectory,
+                          const std::vector<std::string> &includeDirectories,
+                          std::set<std::string> &includedFiles, std::set<std::string> &unresolvedIncludes);
+} // namespace OCLRT
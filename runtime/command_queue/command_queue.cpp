@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -8,6 +8,7 @@
 #include "runtime/built_ins/builtins_dispatch_builder.h"
 #include "runtime/command_queue/command_queue.h"
 #include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/command_stream/command_stream_ring.h"
 #include "runtime/context/context.h"
 #include "runtime/device/device.h"
 #include "runtime/device_queue/device_queue.h"
@@ -26,6 +27,7 @@
 #include "runtime/mem_obj/image.h"
 #include "runtime/helpers/surface_formats.h"
 #include "runtime/memory_manager/internal_allocation_storage.h"
+#include "runtime/program/printf_handler.h"
 #include "runtime/helpers/string.h"
 #include "CL/cl_ext.h"
 #include "runtime/utilities/api_intercept.h"
@@ -71,9 +73,22 @@ CommandQueue::CommandQueue(Context *context, Device *deviceId, const cl_queue_pr
     }
 
     processProperties(properties);
+
+    if (gtpinIsGTPinInitialized()) {
+        gtpinNotifyCommandQueueCreate(this);
+    }
 }
 
 CommandQueue::~CommandQueue() {
+    if (gtpinKernelExecs) {
+        gtpinNotifyCommandQueueRelease(this);
+    }
+
+    if (!pendingPrintfOutputs.empty()) {
+        getCommandStreamReceiver().flushBatchedSubmissions();
+        waitUntilComplete(pendingPrintfOutputs.back().first, flushStamp->peekStamp(), false);
+    }
+
     if (virtualEvent) {
         UNRECOVERABLE_IF(this->virtualEvent->getCommandQueue() != this && this->virtualEvent->getCommandQueue() != nullptr);
         virtualEvent->setCurrentCmdQVirtualEvent(false);
@@ -84,7 +99,10 @@ CommandQueue::~CommandQueue() {
         auto storageForAllocation = getCommandStreamReceiver().getInternalAllocationStorage();
 
         if (commandStream) {
-            storageForAllocation->storeAllocation(std::unique_ptr<GraphicsAllocation>(commandStream->getGraphicsAllocation()), REUSABLE_ALLOCATION);
+            if (!commandStreamRing->ownsChunk(commandStream->getGraphicsAllocation())) {
+                storageForAllocation->storeAllocation(std::unique_ptr<GraphicsAllocation>(commandStream->getGraphicsAllocation()), REUSABLE_ALLOCATION);
+            }
+            commandStreamRing->storeChunksForReuse(getCommandStreamReceiver());
         }
         delete commandStream;
 
@@ -125,6 +143,7 @@ bool CommandQueue::isCompleted(uint32_t taskCount) const {
 
 void CommandQueue::waitUntilComplete(uint32_t taskCountToWait, FlushStamp flushStampToWait, bool useQuickKmdSleep) {
     WAIT_ENTER()
+    PERF_TRACE_SCOPE("waitUntilComplete", Wait);
 
     DBG_LOG(LogTaskCounts, __FUNCTION__, "Waiting for taskCount:", taskCountToWait);
     DBG_LOG(LogTaskCounts, __FUNCTION__, "Line: ", __LINE__, "Current taskCount:", getHwTag());
@@ -135,9 +154,28 @@ void CommandQueue::waitUntilComplete(uint32_t taskCountToWait, FlushStamp flushS
 
     DEBUG_BREAK_IF(getHwTag() < taskCountToWait);
     latestTaskCountWaited = taskCountToWait;
+    printCompletedPrintfOutput();
     WAIT_LEAVE()
 }
 
+void CommandQueue::deferPrintfOutput(uint32_t taskCount, std::unique_ptr<PrintfHandler> printfHandler) {
+    std::lock_guard<std::mutex> lock(printfOutputMutex);
+    pendingPrintfOutputs.emplace_back(taskCount, std::move(printfHandler));
+}
+
+void CommandQueue::printCompletedPrintfOutput() {
+    std::lock_guard<std::mutex> lock(printfOutputMutex);
+    while (!pendingPrintfOutputs.empty() && isCompleted(pendingPrintfOutputs.front().first)) {
+        pendingPrintfOutputs.front().second->printEnqueueOutput();
+        pendingPrintfOutputs.pop_front();
+    }
+}
+
+size_t CommandQueue::getPendingPrintfOutputsCount() {
+    std::lock_guard<std::mutex> lock(printfOutputMutex);
+    return pendingPrintfOutputs.size();
+}
+
 bool CommandQueue::isQueueBlocked() {
     TakeOwnershipWrapper<CommandQueue> takeOwnershipWrapper(*this);
     //check if we have user event and if so, if it is in blocked state.
@@ -192,12 +230,10 @@ uint32_t CommandQueue::getTaskLevelFromWaitList(uint32_t taskLevel,
 
 LinearStream &CommandQueue::getCS(size_t minRequiredSize) {
     DEBUG_BREAK_IF(nullptr == device);
-    auto storageForAllocation = getCommandStreamReceiver().getInternalAllocationStorage();
-    auto memoryManager = getCommandStreamReceiver().getMemoryManager();
-    DEBUG_BREAK_IF(nullptr == memoryManager);
 
     if (!commandStream) {
         commandStream = new LinearStream(nullptr);
+        commandStreamRing = std::make_unique<CommandStreamRing>();
     }
 
     // Make sure we have enough room for any CSR additions
@@ -209,21 +245,10 @@ LinearStream &CommandQueue::getCS(size_t minRequiredSize) {
 
         auto requiredSize = minRequiredSize + CSRequirements::csOverfetchSize;
 
-        GraphicsAllocation *allocation = storageForAllocation->obtainReusableAllocation(requiredSize, false).release();
+        // Old block goes back to the ring or to reusable list
+        auto allocation = commandStreamRing->obtainChunk(getCommandStreamReceiver(), commandStream->getGraphicsAllocation(), requiredSize);
 
-        if (!allocation) {
-            allocation = memoryManager->allocateGraphicsMemoryWithProperties({requiredSize, GraphicsAllocation::AllocationType::LINEAR_STREAM});
-        }
-
-        allocation->setAllocationType(GraphicsAllocation::AllocationType::LINEAR_STREAM);
-
-        // Deallocate the old block, if not null
-        auto oldAllocation = commandStream->getGraphicsAllocation();
-
-        if (oldAllocation) {
-            storageForAllocation->storeAllocation(std::unique_ptr<GraphicsAllocation>(oldAllocation), REUSABLE_ALLOCATION);
-        }
-        commandStream->replaceBuffer(allocation->getUnderlyingBuffer(), minRequiredSize - CSRequirements::minCommandQueueCommandStreamSize);
+        commandStream->replaceBuffer(allocation->getUnderlyingBuffer(), allocation->getUnderlyingBufferSize() - CSRequirements::csOverfetchSize - CSRequirements::minCommandQueueCommandStreamSize);
         commandStream->replaceGraphicsAllocation(allocation);
     }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -13,9 +13,13 @@
 #include "instrumentation.h"
 #include <atomic>
 #include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
 
 namespace OCLRT {
 class Buffer;
+class CommandStreamRing;
 class LinearStream;
 class Context;
 class Device;
@@ -28,6 +32,7 @@ class Kernel;
 class MemObj;
 class PerformanceCounters;
 struct CompletionStamp;
+struct GTPinQueueKernelExecs;
 struct MultiDispatchInfo;
 
 enum class QueuePriority {
@@ -323,6 +328,10 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
 
     MOCKABLE_VIRTUAL void waitUntilComplete(uint32_t taskCountToWait, FlushStamp flushStampToWait, bool useQuickKmdSleep);
 
+    void deferPrintfOutput(uint32_t taskCount, std::unique_ptr<PrintfHandler> printfHandler);
+    void printCompletedPrintfOutput();
+    size_t getPendingPrintfOutputsCount();
+
     static uint32_t getTaskLevelFromWaitList(uint32_t taskLevel,
                                              cl_uint numEventsInWaitList,
                                              const cl_event *eventWaitList);
@@ -407,6 +416,9 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
     // virtual event that holds last Enqueue information
     Event *virtualEvent = nullptr;
 
+    // GT-Pin records of kernels submitted to this queue
+    std::shared_ptr<GTPinQueueKernelExecs> gtpinKernelExecs;
+
   protected:
     void *enqueueReadMemObjForMap(TransferProperties &transferProperties, EventsRequest &eventsRequest, cl_int &errcodeRet);
     cl_int enqueueWriteMemObjForUnmap(MemObj *memObj, void *mappedPtr, EventsRequest &eventsRequest);
@@ -440,12 +452,17 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
     bool perfCountersRegsCfgPending = false;
 
     LinearStream *commandStream = nullptr;
+    std::unique_ptr<CommandStreamRing> commandStreamRing;
 
     bool mapDcFlushRequired = false;
     bool isSpecialCommandQueue = false;
 
     std::unique_ptr<TimestampPacketContainer> timestampPacketContainer;
 
+    // printf output of non blocking enqueues, formatted in submission order once their task count completes
+    std::mutex printfOutputMutex;
+    std::deque<std::pair<uint32_t, std::unique_ptr<PrintfHandler>>> pendingPrintfOutputs;
+
   private:
     void providePerformanceHint(TransferProperties &transferProperties);
 };
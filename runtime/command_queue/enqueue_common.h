@@ -31,6 +31,7 @@
 #include "runtime/program/printf_handler.h"
 #include "runtime/program/block_kernel_manager.h"
 #include "runtime/utilities/range.h"
+#include "runtime/utilities/perf_profiler.h"
 #include "runtime/utilities/tag_allocator.h"
 #include <algorithm>
 #include <new>
@@ -133,6 +134,7 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
                                                cl_uint numEventsInWaitList,
                                                const cl_event *eventWaitList,
                                                cl_event *event) {
+    PERF_TRACE_SCOPE("enqueueHandler", Enqueue);
     if (multiDispatchInfo.empty() && !isCommandWithoutKernel(commandType)) {
         enqueueHandler<CL_COMMAND_MARKER>(surfacesForResidency, numSurfaceForResidency, blocking, multiDispatchInfo,
                                           numEventsInWaitList, eventWaitList, event);
@@ -152,7 +154,7 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
 
     TimeStampData queueTimeStamp;
     if (isProfilingEnabled() && event) {
-        this->getDevice().getOSTime()->getCpuGpuTime(&queueTimeStamp);
+        this->getDevice().getOSTime()->getCalibratedCpuGpuTime(&queueTimeStamp);
     }
 
     EventBuilder eventBuilder;
@@ -231,6 +233,9 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
             if (this->isProfilingEnabled()) {
                 // Get allocation for timestamps
                 hwTimeStamps = eventBuilder.getEvent()->getHwTimeStampNode();
+                if (commandType == CL_COMMAND_NDRANGE_KERNEL && multiDispatchInfo.size() == 1 && DebugManager.flags.EnableLocalWorkSizeAutotune.get()) {
+                    eventBuilder.getEvent()->setLocalWorkSizeSample(*multiDispatchInfo.begin());
+                }
                 if (this->isPerfCountersEnabled()) {
                     hwPerfCounter = eventBuilder.getEvent()->getHwPerfCounterNode()->tag;
                     // PERF COUNTER: copy current configuration from queue to event
@@ -391,7 +396,7 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
 
             if (eventBuilder.getEvent() && isProfilingEnabled()) {
                 TimeStampData submitTimeStamp;
-                this->getDevice().getOSTime()->getCpuGpuTime(&submitTimeStamp);
+                this->getDevice().getOSTime()->getCalibratedCpuGpuTime(&submitTimeStamp);
                 eventBuilder.getEvent()->setSubmitTimeStamp(&submitTimeStamp);
                 eventBuilder.getEvent()->setSubmitTimeStamp();
                 eventBuilder.getEvent()->setStartTimeStamp();
@@ -442,6 +447,9 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
             }
             getCommandStreamReceiver().waitForTaskCountAndCleanAllocationList(completionStamp.taskCount, TEMPORARY_ALLOCATION);
         }
+    } else if (printfHandler) {
+        deferPrintfOutput(completionStamp.taskCount, std::move(printfHandler));
+        printCompletedPrintfOutput();
     }
 }
 
@@ -509,7 +517,6 @@ CompletionStamp CommandQueueHw<GfxFamily>::enqueueNonBlocked(
     auto implicitFlush = false;
 
     if (printfHandler) {
-        blocking = true;
         printfHandler->makeResident(getCommandStreamReceiver());
     }
     if (timestampPacketContainer) {
@@ -547,7 +554,7 @@ CompletionStamp CommandQueueHw<GfxFamily>::enqueueNonBlocked(
 
     TimeStampData submitTimeStamp;
     if (isProfilingEnabled() && eventBuilder.getEvent()) {
-        this->getDevice().getOSTime()->getCpuGpuTime(&submitTimeStamp);
+        this->getDevice().getOSTime()->getCalibratedCpuGpuTime(&submitTimeStamp);
         eventBuilder.getEvent()->setSubmitTimeStamp(&submitTimeStamp);
         getCommandStreamReceiver().makeResident(*eventBuilder.getEvent()->getHwTimeStampNode()->getGraphicsAllocation());
         if (isPerfCountersEnabled()) {
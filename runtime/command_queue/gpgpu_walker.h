@@ -202,7 +202,8 @@ class GpgpuWalkerHelper {
         IndirectHeap *dsh);
 
     static void dispatchOnDeviceWaitlistSemaphores(LinearStream *commandStream, Device &currentDevice,
-                                                   cl_uint numEventsInWaitList, const cl_event *eventWaitList);
+                                                   cl_uint numEventsInWaitList, const cl_event *eventWaitList,
+                                                   TimestampPacketContainer *previousTimestampPacketNodes);
 
     static void adjustMiStoreRegMemMode(MI_STORE_REG_MEM<GfxFamily> *storeCmd);
 };
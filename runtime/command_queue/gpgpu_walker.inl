@@ -363,7 +363,9 @@ void GpgpuWalkerHelper<GfxFamily>::dispatchPerfCountersCommandsEnd(
 
 template <typename GfxFamily>
 inline void GpgpuWalkerHelper<GfxFamily>::dispatchOnDeviceWaitlistSemaphores(LinearStream *commandStream, Device &currentDevice,
-                                                                             cl_uint numEventsInWaitList, const cl_event *eventWaitList) {
+                                                                             cl_uint numEventsInWaitList, const cl_event *eventWaitList,
+                                                                             TimestampPacketContainer *previousTimestampPacketNodes) {
+    TimestampPacketHelper::WaitedPackets waitedPackets;
     for (cl_uint i = 0; i < numEventsInWaitList; i++) {
         auto event = castToObjectOrAbort<Event>(eventWaitList[i]);
         if (event->isUserEvent() || (&event->getCommandQueue()->getDevice() != &currentDevice)) {
@@ -371,7 +373,17 @@ inline void GpgpuWalkerHelper<GfxFamily>::dispatchOnDeviceWaitlistSemaphores(Lin
         }
 
         for (auto &node : event->getTimestampPacketNodes()->peekNodes()) {
-            TimestampPacketHelper::programSemaphoreWithImplicitDependency<GfxFamily>(*commandStream, *node->tag);
+            if (TimestampPacketHelper::isSemaphoreRequired(*node->tag, waitedPackets)) {
+                TimestampPacketHelper::programSemaphoreWithImplicitDependency<GfxFamily>(*commandStream, *node->tag);
+            }
+        }
+    }
+
+    if (previousTimestampPacketNodes) {
+        for (auto &node : previousTimestampPacketNodes->peekNodes()) {
+            if (TimestampPacketHelper::isSemaphoreRequired(*node->tag, waitedPackets)) {
+                TimestampPacketHelper::programSemaphoreWithImplicitDependency<GfxFamily>(*commandStream, *node->tag);
+            }
         }
     }
 }
@@ -92,12 +92,7 @@ void HardwareInterface<GfxFamily>::dispatchWalker(
 
     if (commandQueue.getCommandStreamReceiver().peekTimestampPacketWriteEnabled()) {
         GpgpuWalkerHelper<GfxFamily>::dispatchOnDeviceWaitlistSemaphores(commandStream, commandQueue.getDevice(),
-                                                                         numEventsInWaitList, eventWaitList);
-        if (previousTimestampPacketNodes) {
-            for (auto &node : previousTimestampPacketNodes->peekNodes()) {
-                TimestampPacketHelper::programSemaphoreWithImplicitDependency<GfxFamily>(*commandStream, *node->tag);
-            }
-        }
+                                                                         numEventsInWaitList, eventWaitList, previousTimestampPacketNodes);
     }
 
     dsh->align(KernelCommandsHelper<GfxFamily>::alignInterfaceDescriptorData);
@@ -20,6 +20,7 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include "runtime/command_queue/local_work_size_cache.h"
 #include "runtime/context/context.h"
 #include "runtime/helpers/array_count.h"
 #include "runtime/helpers/basic_math.h"
@@ -27,6 +28,7 @@
 #include "runtime/helpers/dispatch_info.h"
 #include "runtime/kernel/kernel.h"
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cmath>
 #include <ctime>
@@ -413,33 +415,62 @@ void computeWorkgroupSizeND(WorkSizeInfo wsInfo, size_t workGroupSize[3], const
     }
 }
 
-Vec3<size_t> computeWorkgroupSize(const DispatchInfo &dispatchInfo) {
+static Vec3<size_t> computeWorkgroupSizeWithHeuristics(const DispatchInfo &dispatchInfo) {
     size_t workGroupSize[3] = {};
-    if (dispatchInfo.getKernel() != nullptr) {
-        if (DebugManager.flags.EnableComputeWorkSizeND.get()) {
-            WorkSizeInfo wsInfo(dispatchInfo);
-            size_t workItems[3] = {dispatchInfo.getGWS().x, dispatchInfo.getGWS().y, dispatchInfo.getGWS().z};
-            computeWorkgroupSizeND(wsInfo, workGroupSize, workItems, dispatchInfo.getDim());
+    if (DebugManager.flags.EnableComputeWorkSizeND.get()) {
+        WorkSizeInfo wsInfo(dispatchInfo);
+        size_t workItems[3] = {dispatchInfo.getGWS().x, dispatchInfo.getGWS().y, dispatchInfo.getGWS().z};
+        computeWorkgroupSizeND(wsInfo, workGroupSize, workItems, dispatchInfo.getDim());
+    } else {
+        auto maxWorkGroupSize = static_cast<uint32_t>(dispatchInfo.getKernel()->getDevice().getDeviceInfo().maxWorkGroupSize);
+        auto simd = dispatchInfo.getKernel()->getKernelInfo().getMaxSimdSize();
+        size_t workItems[3] = {dispatchInfo.getGWS().x, dispatchInfo.getGWS().y, dispatchInfo.getGWS().z};
+        if (dispatchInfo.getDim() == 1) {
+            computeWorkgroupSize1D(maxWorkGroupSize, workGroupSize, workItems, simd);
+        } else if (DebugManager.flags.EnableComputeWorkSizeSquared.get() && dispatchInfo.getDim() == 2) {
+            computeWorkgroupSizeSquared(maxWorkGroupSize, workGroupSize, workItems, simd, dispatchInfo.getDim());
         } else {
-            auto maxWorkGroupSize = static_cast<uint32_t>(dispatchInfo.getKernel()->getDevice().getDeviceInfo().maxWorkGroupSize);
-            auto simd = dispatchInfo.getKernel()->getKernelInfo().getMaxSimdSize();
-            size_t workItems[3] = {dispatchInfo.getGWS().x, dispatchInfo.getGWS().y, dispatchInfo.getGWS().z};
-            if (dispatchInfo.getDim() == 1) {
-                computeWorkgroupSize1D(maxWorkGroupSize, workGroupSize, workItems, simd);
-            } else if (DebugManager.flags.EnableComputeWorkSizeSquared.get() && dispatchInfo.getDim() == 2) {
-                computeWorkgroupSizeSquared(maxWorkGroupSize, workGroupSize, workItems, simd, dispatchInfo.getDim());
-            } else {
-                computeWorkgroupSize2D(maxWorkGroupSize, workGroupSize, workItems, simd);
+            computeWorkgroupSize2D(maxWorkGroupSize, workGroupSize, workItems, simd);
+        }
+    }
+    return {workGroupSize[0], workGroupSize[1], workGroupSize[2]};
+}
+
+Vec3<size_t> computeWorkgroupSize(const DispatchInfo &dispatchInfo) {
+    Vec3<size_t> workGroupSize = {0, 0, 0};
+    auto kernel = dispatchInfo.getKernel();
+    if (kernel != nullptr) {
+        if (DebugManager.flags.EnableLocalWorkSizeCache.get()) {
+            LocalWorkSizeCacheKey key(dispatchInfo);
+            auto &lwsCache = kernel->getLocalWorkSizeCache();
+            if (!lwsCache.getLocalWorkSize(key, workGroupSize)) {
+                auto start = std::chrono::steady_clock::now();
+                workGroupSize = computeWorkgroupSizeWithHeuristics(dispatchInfo);
+                auto heuristicTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+                lwsCache.storeLocalWorkSize(key, workGroupSize, static_cast<uint64_t>(heuristicTime.count()));
             }
+        } else {
+            workGroupSize = computeWorkgroupSizeWithHeuristics(dispatchInfo);
         }
     }
     DBG_LOG(PrintLWSSizes, "Input GWS enqueueBlocked", dispatchInfo.getGWS().x, dispatchInfo.getGWS().y, dispatchInfo.getGWS().z,
-            " Driver deduced LWS", workGroupSize[0], workGroupSize[1], workGroupSize[2]);
-    return {workGroupSize[0], workGroupSize[1], workGroupSize[2]};
+            " Driver deduced LWS", workGroupSize.x, workGroupSize.y, workGroupSize.z);
+    return workGroupSize;
 }
 
 Vec3<size_t> generateWorkgroupSize(const DispatchInfo &dispatchInfo) {
-    return (dispatchInfo.getEnqueuedWorkgroupSize().x == 0) ? computeWorkgroupSize(dispatchInfo) : dispatchInfo.getEnqueuedWorkgroupSize();
+    if (dispatchInfo.getEnqueuedWorkgroupSize().x != 0) {
+        return dispatchInfo.getEnqueuedWorkgroupSize();
+    }
+    auto workGroupSize = computeWorkgroupSize(dispatchInfo);
+    auto kernel = dispatchInfo.getKernel();
+    if (kernel != nullptr && DebugManager.flags.EnableLocalWorkSizeAutotune.get()) {
+        auto &lwsCache = kernel->getLocalWorkSizeCache();
+        lwsCache.initializeAutotune(*kernel);
+        auto maxWorkGroupSize = static_cast<uint32_t>(kernel->getDevice().getDeviceInfo().maxWorkGroupSize);
+        workGroupSize = lwsCache.selectAutotuneCandidate(LocalWorkSizeCacheKey(dispatchInfo), workGroupSize, maxWorkGroupSize);
+    }
+    return workGroupSize;
 }
 
 Vec3<size_t> computeWorkgroupsNumber(const Vec3<size_t> gws, const Vec3<size_t> lws) {
@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/command_queue/local_work_size_cache.h"
+#include "runtime/device/device.h"
+#include "runtime/helpers/dispatch_info.h"
+#include "runtime/helpers/file_io.h"
+#include "runtime/helpers/hash.h"
+#include "runtime/helpers/hw_info.h"
+#include "runtime/kernel/kernel.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "os_inc.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <tuple>
+
+namespace OCLRT {
+constexpr size_t LocalWorkSizeCache::maxEntries;
+constexpr size_t LocalWorkSizeCache::maxAutotuneCandidates;
+
+LocalWorkSizeCacheKey::LocalWorkSizeCacheKey(const DispatchInfo &dispatchInfo) {
+    gws[0] = dispatchInfo.getGWS().x;
+    gws[1] = dispatchInfo.getGWS().y;
+    gws[2] = dispatchInfo.getGWS().z;
+    dim = dispatchInfo.getDim();
+    auto kernel = dispatchInfo.getKernel();
+    if (kernel != nullptr) {
+        auto &kernelInfo = kernel->getKernelInfo();
+        slmTotalSize = kernel->slmTotalSize;
+        simdSize = static_cast<uint32_t>(kernelInfo.getMaxSimdSize());
+        maxWorkGroupSize = static_cast<uint32_t>(kernel->getDevice().getDeviceInfo().maxWorkGroupSize);
+        hasBarriers = kernelInfo.patchInfo.executionEnvironment && kernelInfo.patchInfo.executionEnvironment->HasBarriers;
+    }
+    computeSizeND = DebugManager.flags.EnableComputeWorkSizeND.get();
+    computeSizeSquared = DebugManager.flags.EnableComputeWorkSizeSquared.get();
+}
+
+bool LocalWorkSizeCacheKey::operator<(const LocalWorkSizeCacheKey &other) const {
+    return std::tie(gws[0], gws[1], gws[2], dim, slmTotalSize, simdSize, maxWorkGroupSize, hasBarriers, computeSizeND, computeSizeSquared) <
+           std::tie(other.gws[0], other.gws[1], other.gws[2], other.dim, other.slmTotalSize, other.simdSize, other.maxWorkGroupSize, other.hasBarriers,
+                    other.computeSizeND, other.computeSizeSquared);
+}
+
+LocalWorkSizeCache::Entry &LocalWorkSizeCache::getEntry(const LocalWorkSizeCacheKey &key) {
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        return it->second;
+    }
+    if (entries.size() >= maxEntries) {
+        entries.clear();
+    }
+    return entries[key];
+}
+
+bool LocalWorkSizeCache::getLocalWorkSize(const LocalWorkSizeCacheKey &key, Vec3<size_t> &lws) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = entries.find(key);
+        if (it == entries.end() || !it->second.computed) {
+            missCount++;
+            return false;
+        }
+        lws = it->second.lws;
+    }
+    hitCount++;
+    return true;
+}
+
+void LocalWorkSizeCache::storeLocalWorkSize(const LocalWorkSizeCacheKey &key, const Vec3<size_t> &lws, uint64_t heuristicTimeNs) {
+    this->heuristicTimeNs += heuristicTimeNs;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    auto &entry = getEntry(key);
+    entry.lws = lws;
+    entry.computed = true;
+}
+
+Vec3<size_t> LocalWorkSizeCache::selectAutotuneCandidate(const LocalWorkSizeCacheKey &key, const Vec3<size_t> &lws, uint32_t maxWorkGroupSize) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto &entry = getEntry(key);
+    if (entry.tuned) {
+        return entry.bestLws;
+    }
+    if (entry.candidates.empty()) {
+        entry.candidates = generateAutotuneCandidates(lws, key.gws, key.dim, maxWorkGroupSize);
+        entry.durations.assign(entry.candidates.size(), std::numeric_limits<uint64_t>::max());
+        entry.nextCandidate = 0;
+    }
+    if (entry.candidates.size() == 1) {
+        entry.bestLws = entry.candidates[0];
+        entry.tuned = true;
+        return entry.bestLws;
+    }
+    // prefer candidates which were not measured yet, samples of dispatches without profiling never come back
+    for (size_t i = 0; i < entry.candidates.size(); i++) {
+        auto candidate = (entry.nextCandidate + i) % entry.candidates.size();
+        if (entry.durations[candidate] == std::numeric_limits<uint64_t>::max()) {
+            entry.nextCandidate = (candidate + 1) % entry.candidates.size();
+            return entry.candidates[candidate];
+        }
+    }
+    return entry.candidates[0];
+}
+
+bool LocalWorkSizeCache::reportExecutionTime(const LocalWorkSizeSample &sample, uint64_t durationNs) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = entries.find(sample.key);
+    if (it == entries.end() || it->second.tuned) {
+        return false;
+    }
+    auto &entry = it->second;
+    auto candidate = std::find(entry.candidates.begin(), entry.candidates.end(), sample.lws);
+    if (candidate == entry.candidates.end()) {
+        return false;
+    }
+    auto &duration = entry.durations[candidate - entry.candidates.begin()];
+    duration = std::min(duration, durationNs);
+
+    if (std::find(entry.durations.begin(), entry.durations.end(), std::numeric_limits<uint64_t>::max()) != entry.durations.end()) {
+        return false;
+    }
+    auto best = std::min_element(entry.durations.begin(), entry.durations.end()) - entry.durations.begin();
+    entry.bestLws = entry.candidates[best];
+    entry.tuned = true;
+    return true;
+}
+
+bool LocalWorkSizeCache::isAutotuned(const LocalWorkSizeCacheKey &key) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = entries.find(key);
+    return it != entries.end() && it->second.tuned;
+}
+
+std::string LocalWorkSizeCache::getAutotuneFileName(const Kernel &kernel) {
+    auto directory = DebugManager.flags.LocalWorkSizeAutotuneCacheDir.get();
+    if (directory == "unk") {
+        return "";
+    }
+    auto &kernelInfo = kernel.getKernelInfo();
+    auto &hwInfo = kernel.getDevice().getHardwareInfo();
+
+    Hash hash;
+    hash.update(kernelInfo.name.c_str(), kernelInfo.name.size());
+    hash.update("----", 4);
+    if (kernelInfo.heapInfo.pKernelHeap && kernelInfo.heapInfo.pKernelHeader) {
+        hash.update(reinterpret_cast<const char *>(kernelInfo.heapInfo.pKernelHeap), kernelInfo.heapInfo.pKernelHeader->KernelHeapSize);
+    }
+    hash.update("----", 4);
+    hash.update(reinterpret_cast<const char *>(hwInfo.pPlatform), sizeof(*hwInfo.pPlatform));
+    hash.update("----", 4);
+    hash.update(reinterpret_cast<const char *>(hwInfo.pSysInfo), sizeof(*hwInfo.pSysInfo));
+
+    std::stringstream stream;
+    stream << directory << PATH_SEPARATOR
+           << std::setfill('0') << std::setw(sizeof(uint64_t) * 2) << std::hex << hash.finish()
+           << ".lws_cache";
+    return stream.str();
+}
+
+void LocalWorkSizeCache::initializeAutotune(const Kernel &kernel) {
+    std::call_once(autotuneInitialized, [&]() {
+        autotuneFileName = getAutotuneFileName(kernel);
+        if (!autotuneFileName.empty()) {
+            loadAutotuneResults(autotuneFileName);
+        }
+    });
+}
+
+bool LocalWorkSizeCache::persistAutotuneResults() {
+    if (autotuneFileName.empty()) {
+        return false;
+    }
+    return saveAutotuneResults(autotuneFileName);
+}
+
+bool LocalWorkSizeCache::loadAutotuneResults(const std::string &fileName) {
+    void *data = nullptr;
+    auto dataSize = loadDataFromFile(fileName.c_str(), data);
+    if (data == nullptr || dataSize == 0) {
+        deleteDataReadFromFile(data);
+        return false;
+    }
+    std::istringstream stream(std::string(static_cast<const char *>(data), dataSize));
+    deleteDataReadFromFile(data);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    LocalWorkSizeCacheKey key;
+    size_t lws[3] = {};
+    while (stream >> key.gws[0] >> key.gws[1] >> key.gws[2] >> key.dim >> key.slmTotalSize >> key.simdSize >> key.maxWorkGroupSize >> key.hasBarriers >> key.computeSizeND >> key.computeSizeSquared >> lws[0] >> lws[1] >> lws[2]) {
+        auto &entry = getEntry(key);
+        entry.bestLws = lws;
+        entry.tuned = true;
+    }
+    return true;
+}
+
+bool LocalWorkSizeCache::saveAutotuneResults(const std::string &fileName) {
+    std::ostringstream stream;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto &entry : entries) {
+            if (!entry.second.tuned) {
+                continue;
+            }
+            auto &key = entry.first;
+            auto &lws = entry.second.bestLws;
+            stream << key.gws[0] << " " << key.gws[1] << " " << key.gws[2] << " " << key.dim << " " << key.slmTotalSize << " "
+                   << key.simdSize << " " << key.maxWorkGroupSize << " " << key.hasBarriers << " " << key.computeSizeND << " " << key.computeSizeSquared << " " << lws.x << " " << lws.y << " " << lws.z << "\n";
+        }
+    }
+    auto data = stream.str();
+    return writeDataToFile(fileName.c_str(), data.c_str(), data.size()) == data.size();
+}
+
+std::vector<Vec3<size_t>> LocalWorkSizeCache::generateAutotuneCandidates(const Vec3<size_t> &lws, const uint64_t gws[3], uint32_t dim, uint32_t maxWorkGroupSize) {
+    std::vector<Vec3<size_t>> candidates;
+    candidates.push_back(lws);
+
+    auto addCandidate = [&](Vec3<size_t> candidate) {
+        size_t sizes[3] = {candidate.x, candidate.y, candidate.z};
+        for (uint32_t i = 0; i < 3; i++) {
+            auto globalSize = std::max(static_cast<uint64_t>(1u), i < dim ? gws[i] : 1u);
+            if (sizes[i] == 0 || globalSize % sizes[i] != 0) {
+                return;
+            }
+        }
+        if (candidate.x * candidate.y * candidate.z > maxWorkGroupSize || candidates.size() >= maxAutotuneCandidates ||
+            std::find(candidates.begin(), candidates.end(), candidate) != candidates.end()) {
+            return;
+        }
+        candidates.push_back(candidate);
+    };
+
+    addCandidate({lws.x * 2, lws.y, lws.z});
+    addCandidate({lws.x / 2, lws.y, lws.z});
+    if (dim > 1) {
+        addCandidate({lws.x, lws.y * 2, lws.z});
+        addCandidate({lws.x, lws.y / 2, lws.z});
+        addCandidate({lws.x * 2, lws.y / 2, lws.z});
+        addCandidate({lws.x / 2, lws.y * 2, lws.z});
+    }
+    if (dim > 2) {
+        addCandidate({lws.x, lws.y, lws.z * 2});
+        addCandidate({lws.x, lws.y, lws.z / 2});
+    }
+    return candidates;
+}
+
+void LocalWorkSizeCache::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    entries.clear();
+}
+
+size_t LocalWorkSizeCache::getEntriesCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return entries.size();
+}
+} // namespace OCLRT
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+#include "runtime/utilities/vec.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OCLRT {
+struct DispatchInfo;
+class Kernel;
+
+struct LocalWorkSizeCacheKey {
+    LocalWorkSizeCacheKey() = default;
+    LocalWorkSizeCacheKey(const DispatchInfo &dispatchInfo);
+
+    bool operator<(const LocalWorkSizeCacheKey &other) const;
+
+    uint64_t gws[3] = {0, 0, 0};
+    uint32_t dim = 0;
+    uint32_t slmTotalSize = 0;
+    uint32_t simdSize = 0;
+    uint32_t maxWorkGroupSize = 0;
+    bool hasBarriers = false;
+    bool computeSizeND = false;
+    bool computeSizeSquared = false;
+};
+
+// Sample of autotuned dispatch, matched with its execution time once profiling data is available
+struct LocalWorkSizeSample {
+    LocalWorkSizeCacheKey key;
+    Vec3<size_t> lws = {0, 0, 0};
+};
+
+// Local work sizes deduced by driver depend only on kernel, device and dispatch shape,
+// so results of heuristics are kept per kernel and reused for repeated NULL local size enqueues.
+// In autotune mode successive dispatches cycle through candidate sizes until each one has been
+// measured, then the fastest one is used and can be persisted for next runs.
+class LocalWorkSizeCache {
+  public:
+    static constexpr size_t maxEntries = 256u;
+    static constexpr size_t maxAutotuneCandidates = 8u;
+
+    bool getLocalWorkSize(const LocalWorkSizeCacheKey &key, Vec3<size_t> &lws);
+    void storeLocalWorkSize(const LocalWorkSizeCacheKey &key, const Vec3<size_t> &lws, uint64_t heuristicTimeNs);
+
+    Vec3<size_t> selectAutotuneCandidate(const LocalWorkSizeCacheKey &key, const Vec3<size_t> &lws, uint32_t maxWorkGroupSize);
+    bool reportExecutionTime(const LocalWorkSizeSample &sample, uint64_t durationNs);
+    bool isAutotuned(const LocalWorkSizeCacheKey &key);
+
+    void initializeAutotune(const Kernel &kernel);
+    bool persistAutotuneResults();
+    bool loadAutotuneResults(const std::string &fileName);
+    bool saveAutotuneResults(const std::string &fileName);
+
+    static std::string getAutotuneFileName(const Kernel &kernel);
+
+    static std::vector<Vec3<size_t>> generateAutotuneCandidates(const Vec3<size_t> &lws, const uint64_t gws[3], uint32_t dim, uint32_t maxWorkGroupSize);
+
+    void clear();
+    size_t getEntriesCount();
+    uint64_t getHitCount() const { return hitCount; }
+    uint64_t getMissCount() const { return missCount; }
+    uint64_t getHeuristicTimeNs() const { return heuristicTimeNs; }
+
+  protected:
+    struct Entry {
+        Vec3<size_t> lws = {0, 0, 0};
+        Vec3<size_t> bestLws = {0, 0, 0};
+        std::vector<Vec3<size_t>> candidates;
+        std::vector<uint64_t> durations;
+        size_t nextCandidate = 0;
+        bool computed = false;
+        bool tuned = false;
+    };
+
+    Entry &getEntry(const LocalWorkSizeCacheKey &key);
+
+    std::mutex mtx;
+    std::map<LocalWorkSizeCacheKey, Entry> entries;
+    std::atomic<uint64_t> hitCount{0};
+    std::atomic<uint64_t> missCount{0};
+    std::atomic<uint64_t> heuristicTimeNs{0};
+
+    std::once_flag autotuneInitialized;
+    std::string autotuneFileName;
+};
+} // namespace OCLRT
@@ -7,6 +7,7 @@
 
 #include "runtime/built_ins/built_ins.h"
 #include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/command_stream/command_stream_ring.h"
 #include "runtime/command_stream/experimental_command_buffer.h"
 #include "runtime/command_stream/preemption.h"
 #include "runtime/command_stream/scratch_space_controller.h"
@@ -35,6 +36,7 @@ CommandStreamReceiver::CommandStreamReceiver(ExecutionEnvironment &executionEnvi
 
     latestSentStatelessMocsConfig = CacheSettings::unknownMocs;
     submissionAggregator.reset(new SubmissionAggregator());
+    commandStreamRing = std::make_unique<CommandStreamRing>();
     if (DebugManager.flags.CsrDispatchMode.get()) {
         this->dispatchMode = (DispatchMode)DebugManager.flags.CsrDispatchMode.get();
     }
@@ -132,19 +134,10 @@ LinearStream &CommandStreamReceiver::getCS(size_t minRequiredSize) {
 
         auto requiredSize = minRequiredSize + CSRequirements::csOverfetchSize;
 
-        auto allocation = internalAllocationStorage->obtainReusableAllocation(requiredSize, false).release();
-        if (!allocation) {
-            allocation = getMemoryManager()->allocateGraphicsMemoryWithProperties({requiredSize, GraphicsAllocation::AllocationType::LINEAR_STREAM});
-        }
-
-        allocation->setAllocationType(GraphicsAllocation::AllocationType::LINEAR_STREAM);
-
-        //pass current allocation to reusable list
-        if (commandStream.getCpuBase()) {
-            internalAllocationStorage->storeAllocation(std::unique_ptr<GraphicsAllocation>(commandStream.getGraphicsAllocation()), REUSABLE_ALLOCATION);
-        }
+        //current allocation goes back to the ring or to reusable list
+        auto allocation = commandStreamRing->obtainChunk(*this, commandStream.getGraphicsAllocation(), requiredSize);
 
-        commandStream.replaceBuffer(allocation->getUnderlyingBuffer(), minRequiredSize - sizeForSubmission);
+        commandStream.replaceBuffer(allocation->getUnderlyingBuffer(), allocation->getUnderlyingBufferSize() - CSRequirements::csOverfetchSize - sizeForSubmission);
         commandStream.replaceGraphicsAllocation(allocation);
     }
 
@@ -164,10 +157,13 @@ void CommandStreamReceiver::cleanupResources() {
     }
 
     if (commandStream.getCpuBase()) {
-        getMemoryManager()->freeGraphicsMemory(commandStream.getGraphicsAllocation());
+        if (!commandStreamRing->ownsChunk(commandStream.getGraphicsAllocation())) {
+            getMemoryManager()->freeGraphicsMemory(commandStream.getGraphicsAllocation());
+        }
         commandStream.replaceGraphicsAllocation(nullptr);
         commandStream.replaceBuffer(nullptr, 0);
     }
+    commandStreamRing->freeChunks(*getMemoryManager());
 
     if (tagAllocation) {
         getMemoryManager()->freeGraphicsMemory(tagAllocation);
@@ -256,6 +252,14 @@ IndirectHeap &CommandStreamReceiver::getIndirectHeap(IndirectHeap::Type heapType
         heapMemory = heap->getGraphicsAllocation();
 
     if (heap && heap->getAvailableSpace() < minRequiredSize && heapMemory) {
+        if (DebugManager.flags.EnableHeapBaseAddressReuse.get() &&
+            heap->getMaxAvailableSpace() >= minRequiredSize &&
+            heapMemory->getTaskCount(osContext->getContextId()) <= *getTagAddress()) {
+            // rewind completed heap in place, programmed state base address keeps covering it
+            heap->replaceBuffer(heap->getCpuBase(), heap->getMaxAvailableSpace());
+            scratchSpaceController->reserveHeap(heapType, heap);
+            return *heap;
+        }
         internalAllocationStorage->storeAllocation(std::unique_ptr<GraphicsAllocation>(heapMemory), REUSABLE_ALLOCATION);
         heapMemory = nullptr;
     }
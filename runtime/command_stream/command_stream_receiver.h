@@ -22,6 +22,7 @@
 
 namespace OCLRT {
 class AllocationsList;
+class CommandStreamRing;
 class Device;
 class EventBuilder;
 class ExecutionEnvironment;
@@ -156,6 +157,7 @@ class CommandStreamReceiver {
     size_t defaultSshSize;
 
     void setDeviceIndex(uint32_t deviceIndex) { this->deviceIndex = deviceIndex; }
+    uint32_t getDeviceIndex() const { return deviceIndex; }
     AllocationsList &getTemporaryAllocations();
     AllocationsList &getAllocationsForReuse();
     InternalAllocationStorage *getInternalAllocationStorage() const { return internalAllocationStorage.get(); }
@@ -178,6 +180,7 @@ class CommandStreamReceiver {
 
     std::unique_ptr<FlushStampTracker> flushStamp;
     std::unique_ptr<SubmissionAggregator> submissionAggregator;
+    std::unique_ptr<CommandStreamRing> commandStreamRing;
     std::unique_ptr<FlatBatchBufferHelper> flatBatchBufferHelper;
     std::unique_ptr<ExperimentalCommandBuffer> experimentalCmdBuffer;
     std::unique_ptr<InternalAllocationStorage> internalAllocationStorage;
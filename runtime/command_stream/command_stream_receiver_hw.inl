@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -25,6 +25,7 @@
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/os_context.h"
+#include "runtime/utilities/perf_profiler.h"
 #include "runtime/command_stream/preemption.h"
 #include "runtime/command_queue/gpgpu_walker.h"
 #include "runtime/utilities/tag_allocator.h"
@@ -151,6 +152,7 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
     typedef typename GfxFamily::MI_BATCH_BUFFER_END MI_BATCH_BUFFER_END;
     typedef typename GfxFamily::PIPE_CONTROL PIPE_CONTROL;
     typedef typename GfxFamily::STATE_BASE_ADDRESS STATE_BASE_ADDRESS;
+    PERF_TRACE_SCOPE("flushTask", FlushTask);
 
     DEBUG_BREAK_IF(&commandStreamTask == &commandStream);
     DEBUG_BREAK_IF(!(dispatchFlags.preemptionMode == PreemptionMode::Disabled ? device.getPreemptionMode() == PreemptionMode::Disabled : true));
@@ -243,7 +245,7 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
     bool stateBaseAddressDirty = false;
 
     bool checkVfeStateDirty = false;
-    if (requiredScratchSize) {
+    if (requiredScratchSize || scratchSpaceController->getScratchSpaceAllocation()) {
         scratchSpaceController->setRequiredScratchSpace(ssh.getCpuBase(),
                                                         requiredScratchSize,
                                                         this->taskCount,
@@ -253,8 +255,12 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
         if (checkVfeStateDirty) {
             setMediaVFEStateDirty(true);
         }
-        makeResident(*scratchSpaceController->getScratchSpaceAllocation());
+        if (scratchSpaceController->getScratchSpaceAllocation()) {
+            makeResident(*scratchSpaceController->getScratchSpaceAllocation());
+        }
     }
+    // scratch demand of submitted work is now covered by scratch space controller
+    requiredScratchSize = 0;
 
     auto &commandStreamCSR = this->getCS(getRequiredCmdStreamSizeAligned(dispatchFlags, device));
     auto commandStreamStartCSR = commandStreamCSR.getUsed();
@@ -451,7 +457,7 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
             this->latestFlushedTaskCount = this->taskCount + 1;
             this->makeSurfacePackNonResident(this->getResidencyAllocations());
         } else {
-            auto commandBuffer = new CommandBuffer(device);
+            auto commandBuffer = this->submissionAggregator->obtainCommandBuffer(device);
             commandBuffer->batchBuffer = batchBuffer;
             commandBuffer->surfaces.swap(this->getResidencyAllocations());
             commandBuffer->batchBufferEndLocation = bbEndLocation;
@@ -554,7 +560,7 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
                 currentBBendLocation = nextCommandBuffer->batchBufferEndLocation;
                 lastTaskCount = nextCommandBuffer->taskCount;
                 nextCommandBuffer = nextCommandBuffer->next;
-                commandBufferList.removeFrontOne();
+                this->submissionAggregator->recycleCommandBuffer(commandBufferList.removeFrontOne());
             }
             surfacesForSubmit.reserve(resourcePackage.size() + 1);
             for (auto &surface : resourcePackage) {
@@ -576,6 +582,7 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
             this->flushStamp->setStamp(flushStamp);
             this->makeSurfacePackNonResident(surfacesForSubmit);
             resourcePackage.clear();
+            this->submissionAggregator->recycleCommandBuffer(std::move(primaryCmdBuffer));
         }
         this->totalMemoryUsed = 0;
     }
@@ -664,8 +671,11 @@ inline void CommandStreamReceiverHw<GfxFamily>::waitForTaskCountWithKmdNotifyFal
     bool enableTimeout = kmdNotifyHelper->obtainTimeoutParams(waitTimeout, useQuickKmdSleep, *getTagAddress(), taskCountToWait, flushStampToWait, forcePowerSavingMode);
 
     auto status = waitForCompletionWithTimeout(enableTimeout, waitTimeout, taskCountToWait);
+    //flush stamp wait is bounded, when it times out poll the tag again before going back to KMD wait
+    while (!status && *getTagAddress() < taskCountToWait && !waitForFlushStamp(flushStampToWait)) {
+        status = waitForCompletionWithTimeout(enableTimeout, waitTimeout, taskCountToWait);
+    }
     if (!status) {
-        waitForFlushStamp(flushStampToWait);
         //now call blocking wait, this is to ensure that task count is reached
         waitForCompletionWithTimeout(false, 0, taskCountToWait);
     }
@@ -734,7 +744,7 @@ inline void CommandStreamReceiverHw<GfxFamily>::programPreamble(LinearStream &cs
 template <typename GfxFamily>
 inline void CommandStreamReceiverHw<GfxFamily>::programVFEState(LinearStream &csr, DispatchFlags &dispatchFlags) {
     if (mediaVfeStateDirty) {
-        PreambleHelper<GfxFamily>::programVFEState(&csr, hwInfo, requiredScratchSize, getScratchPatchAddress());
+        PreambleHelper<GfxFamily>::programVFEState(&csr, hwInfo, scratchSpaceController->getPerThreadScratchSize(), getScratchPatchAddress());
         setMediaVFEStateDirty(false);
     }
 }
@@ -785,6 +795,7 @@ void CommandStreamReceiverHw<GfxFamily>::addClearSLMWorkAround(typename GfxFamil
 
 template <typename GfxFamily>
 void CommandStreamReceiverHw<GfxFamily>::handleEventsTimestampPacketTags(LinearStream &csr, DispatchFlags &dispatchFlags, Device &currentDevice) {
+    TimestampPacketHelper::WaitedPackets waitedPackets;
     for (cl_uint i = 0; i < dispatchFlags.outOfDeviceDependencies->numEventsInWaitList; i++) {
         auto event = castToObjectOrAbort<Event>(dispatchFlags.outOfDeviceDependencies->eventWaitList[i]);
         if (event->isUserEvent()) {
@@ -796,7 +807,9 @@ void CommandStreamReceiverHw<GfxFamily>::handleEventsTimestampPacketTags(LinearS
 
         if (&event->getCommandQueue()->getDevice() != &currentDevice) {
             for (auto &node : timestampPacketContainer->peekNodes()) {
-                TimestampPacketHelper::programSemaphoreWithImplicitDependency<GfxFamily>(csr, *node->tag);
+                if (TimestampPacketHelper::isSemaphoreRequired(*node->tag, waitedPackets)) {
+                    TimestampPacketHelper::programSemaphoreWithImplicitDependency<GfxFamily>(csr, *node->tag);
+                }
             }
         }
     }
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/command_stream/command_stream_ring.h"
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/helpers/debug_helpers.h"
+#include "runtime/memory_manager/internal_allocation_storage.h"
+#include "runtime/memory_manager/memory_manager.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+
+namespace OCLRT {
+
+CommandStreamRing::~CommandStreamRing() {
+    DEBUG_BREAK_IF(!chunks.empty());
+}
+
+GraphicsAllocation *CommandStreamRing::obtainChunk(CommandStreamReceiver &commandStreamReceiver, GraphicsAllocation *retiredChunk, size_t requiredSize) {
+    if (retiredChunk) {
+        if (!chunks.empty() && chunks[currentChunk].allocation == retiredChunk) {
+            chunks[currentChunk].taskCount = commandStreamReceiver.peekTaskCount();
+        } else {
+            commandStreamReceiver.getInternalAllocationStorage()->storeAllocation(std::unique_ptr<GraphicsAllocation>(retiredChunk), REUSABLE_ALLOCATION);
+        }
+    }
+
+    if (!DebugManager.flags.EnableCommandStreamRing.get()) {
+        return allocateChunk(commandStreamReceiver, requiredSize);
+    }
+
+    if (chunks.empty()) {
+        chunks.push_back({allocateChunk(commandStreamReceiver, requiredSize), 0u});
+        currentChunk = 0u;
+        return chunks[currentChunk].allocation;
+    }
+
+    auto nextChunk = (currentChunk + 1) % chunks.size();
+    auto &chunk = chunks[nextChunk];
+    if (isCompleted(commandStreamReceiver, chunk)) {
+        if (chunk.allocation->getUnderlyingBufferSize() < requiredSize) {
+            commandStreamReceiver.getMemoryManager()->freeGraphicsMemory(chunk.allocation);
+            chunk.allocation = allocateChunk(commandStreamReceiver, requiredSize);
+        }
+        currentChunk = nextChunk;
+        return chunk.allocation;
+    }
+
+    // next chunk is still used by GPU, insert new one in front of it to keep round-robin order
+    chunks.insert(chunks.begin() + nextChunk, {allocateChunk(commandStreamReceiver, requiredSize), 0u});
+    currentChunk = nextChunk;
+    return chunks[currentChunk].allocation;
+}
+
+void CommandStreamRing::storeChunksForReuse(CommandStreamReceiver &commandStreamReceiver) {
+    if (!chunks.empty()) {
+        chunks[currentChunk].taskCount = commandStreamReceiver.peekTaskCount();
+    }
+    for (auto &chunk : chunks) {
+        commandStreamReceiver.getInternalAllocationStorage()->storeAllocationWithTaskCount(std::unique_ptr<GraphicsAllocation>(chunk.allocation), REUSABLE_ALLOCATION, chunk.taskCount);
+    }
+    chunks.clear();
+    currentChunk = 0u;
+}
+
+void CommandStreamRing::freeChunks(MemoryManager &memoryManager) {
+    for (auto &chunk : chunks) {
+        memoryManager.freeGraphicsMemory(chunk.allocation);
+    }
+    chunks.clear();
+    currentChunk = 0u;
+}
+
+bool CommandStreamRing::ownsChunk(const GraphicsAllocation *allocation) const {
+    for (auto &chunk : chunks) {
+        if (chunk.allocation == allocation) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CommandStreamRing::isCompleted(CommandStreamReceiver &commandStreamReceiver, const Chunk &chunk) {
+    auto tagAddress = commandStreamReceiver.getTagAddress();
+    return tagAddress == nullptr || *tagAddress >= chunk.taskCount;
+}
+
+GraphicsAllocation *CommandStreamRing::allocateChunk(CommandStreamReceiver &commandStreamReceiver, size_t requiredSize) {
+    auto allocation = commandStreamReceiver.getInternalAllocationStorage()->obtainReusableAllocation(requiredSize, false).release();
+    if (!allocation) {
+        allocation = commandStreamReceiver.getMemoryManager()->allocateGraphicsMemoryWithProperties({requiredSize, GraphicsAllocation::AllocationType::LINEAR_STREAM});
+    }
+    allocation->setAllocationType(GraphicsAllocation::AllocationType::LINEAR_STREAM);
+    return allocation;
+}
+} // namespace OCLRT
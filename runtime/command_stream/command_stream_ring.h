@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OCLRT {
+class CommandStreamReceiver;
+class GraphicsAllocation;
+class MemoryManager;
+
+// Fixed set of command buffer chunks reused round-robin by a command stream.
+// Chunk is taken again once the task count it was retired with completes,
+// the ring is extended only when the next chunk is still used by GPU.
+class CommandStreamRing {
+  public:
+    ~CommandStreamRing();
+
+    GraphicsAllocation *obtainChunk(CommandStreamReceiver &commandStreamReceiver, GraphicsAllocation *retiredChunk, size_t requiredSize);
+    void storeChunksForReuse(CommandStreamReceiver &commandStreamReceiver);
+    void freeChunks(MemoryManager &memoryManager);
+    bool ownsChunk(const GraphicsAllocation *allocation) const;
+    size_t getChunksCount() const { return chunks.size(); }
+
+  protected:
+    struct Chunk {
+        GraphicsAllocation *allocation;
+        uint32_t taskCount;
+    };
+
+    static bool isCompleted(CommandStreamReceiver &commandStreamReceiver, const Chunk &chunk);
+    static GraphicsAllocation *allocateChunk(CommandStreamReceiver &commandStreamReceiver, size_t requiredSize);
+
+    std::vector<Chunk> chunks;
+    size_t currentChunk = 0u;
+};
+} // namespace OCLRT
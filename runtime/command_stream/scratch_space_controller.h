@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -27,6 +27,12 @@ class ScratchSpaceController {
     GraphicsAllocation *getScratchSpaceAllocation() {
         return scratchAllocation;
     }
+    uint32_t getPerThreadScratchSize() const {
+        return perThreadScratchSize;
+    }
+    uint32_t getScratchAllocationsCount() const {
+        return scratchAllocationsCount;
+    }
     virtual void setRequiredScratchSpace(void *sshBaseAddress,
                                          uint32_t requiredPerThreadScratchSize,
                                          uint32_t currentTaskCount,
@@ -46,6 +52,8 @@ class ScratchSpaceController {
     GraphicsAllocation *scratchAllocation = nullptr;
     InternalAllocationStorage &csrAllocationStorage;
     size_t scratchSizeBytes = 0;
+    uint32_t perThreadScratchSize = 0;
+    uint32_t scratchAllocationsCount = 0;
     bool force32BitAllocation = false;
     uint32_t computeUnitsUsedForScratch = 0;
 };
@@ -1,11 +1,15 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
  */
 
 #include "runtime/command_stream/scratch_space_controller_base.h"
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/command_stream/scratch_space_pool.h"
+#include "runtime/execution_environment/execution_environment.h"
+#include "runtime/helpers/basic_math.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/hw_helper.h"
 #include "runtime/helpers/preamble.h"
@@ -13,12 +17,26 @@
 #include "runtime/memory_manager/graphics_allocation.h"
 #include "runtime/memory_manager/internal_allocation_storage.h"
 #include "runtime/memory_manager/memory_manager.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+
+#include <algorithm>
 
 namespace OCLRT {
+
+constexpr uint32_t ScratchSpaceControllerBase::lowDemandRatio;
+constexpr uint32_t ScratchSpaceControllerBase::lowDemandSubmissionsToShrink;
+
 ScratchSpaceControllerBase::ScratchSpaceControllerBase(const HardwareInfo &info, ExecutionEnvironment &environment, InternalAllocationStorage &allocationStorage)
     : ScratchSpaceController(info, environment, allocationStorage) {
 }
 
+ScratchSpaceControllerBase::~ScratchSpaceControllerBase() {
+    // command stream receiver waited for its submissions before releasing this controller
+    if (releaseTagAddress && executionEnvironment.scratchSpacePool) {
+        executionEnvironment.scratchSpacePool->markCompleted(releaseTagAddress);
+    }
+}
+
 void ScratchSpaceControllerBase::setRequiredScratchSpace(void *sshBaseAddress,
                                                          uint32_t requiredPerThreadScratchSize,
                                                          uint32_t currentTaskCount,
@@ -26,24 +44,83 @@ void ScratchSpaceControllerBase::setRequiredScratchSpace(void *sshBaseAddress,
                                                          bool &stateBaseAddressDirty,
                                                          bool &vfeStateDirty) {
     size_t requiredScratchSizeInBytes = requiredPerThreadScratchSize * computeUnitsUsedForScratch;
-    if (requiredScratchSizeInBytes && (!scratchAllocation || scratchSizeBytes < requiredScratchSizeInBytes)) {
-        if (scratchAllocation) {
-            scratchAllocation->updateTaskCount(currentTaskCount, contextId);
-            csrAllocationStorage.storeAllocation(std::unique_ptr<GraphicsAllocation>(scratchAllocation), TEMPORARY_ALLOCATION);
+    if (!DebugManager.flags.EnableScratchSpacePooling.get()) {
+        if (requiredScratchSizeInBytes && (!scratchAllocation || scratchSizeBytes < requiredScratchSizeInBytes)) {
+            replaceScratchSpaceAllocation(requiredScratchSizeInBytes, false, currentTaskCount, contextId);
+            markScratchSpaceChanged(stateBaseAddressDirty, vfeStateDirty);
         }
-        scratchSizeBytes = requiredScratchSizeInBytes;
-        createScratchSpaceAllocation();
+        perThreadScratchSize = std::max(perThreadScratchSize, requiredPerThreadScratchSize);
+        return;
+    }
+
+    if (requiredScratchSizeInBytes > scratchSizeBytes) {
+        auto newScratchSizeBytes = std::max(static_cast<size_t>(Math::nextPowerOfTwo(static_cast<uint32_t>(requiredScratchSizeInBytes))), 2 * scratchSizeBytes);
+        replaceScratchSpaceAllocation(newScratchSizeBytes, true, currentTaskCount, contextId);
+        perThreadScratchSize = std::max(perThreadScratchSize, requiredPerThreadScratchSize);
+        lowDemandSubmissions = 0;
+        markScratchSpaceChanged(stateBaseAddressDirty, vfeStateDirty);
+        return;
+    }
+
+    // allocation has room for bigger per thread scratch, only media VFE state has to be updated
+    if (requiredPerThreadScratchSize > perThreadScratchSize) {
+        perThreadScratchSize = requiredPerThreadScratchSize;
         vfeStateDirty = true;
-        force32BitAllocation = getMemoryManager()->peekForce32BitAllocations();
-        if (is64bit && !force32BitAllocation) {
-            stateBaseAddressDirty = true;
+    }
+
+    if (scratchAllocation && requiredScratchSizeInBytes * lowDemandRatio <= scratchSizeBytes) {
+        lowDemandSubmissions++;
+    } else {
+        lowDemandSubmissions = 0;
+    }
+    if (lowDemandSubmissions >= lowDemandSubmissionsToShrink) {
+        auto newScratchSizeBytes = requiredScratchSizeInBytes ? static_cast<size_t>(Math::nextPowerOfTwo(static_cast<uint32_t>(requiredScratchSizeInBytes))) : 0u;
+        replaceScratchSpaceAllocation(newScratchSizeBytes, false, currentTaskCount, contextId);
+        perThreadScratchSize = requiredPerThreadScratchSize;
+        lowDemandSubmissions = 0;
+        markScratchSpaceChanged(stateBaseAddressDirty, vfeStateDirty);
+    }
+}
+
+void ScratchSpaceControllerBase::replaceScratchSpaceAllocation(size_t newScratchSizeBytes, bool shareReleasedAllocation, uint32_t currentTaskCount, uint32_t contextId) {
+    auto &commandStreamReceiver = csrAllocationStorage.getCommandStreamReceiver();
+    if (scratchAllocation) {
+        scratchAllocation->updateTaskCount(currentTaskCount, contextId);
+        if (shareReleasedAllocation && !scratchAllocation->is32BitAllocation) {
+            releaseTagAddress = commandStreamReceiver.getTagAddress();
+            executionEnvironment.getScratchSpacePool()->release(scratchAllocation, commandStreamReceiver.getDeviceIndex(), releaseTagAddress, currentTaskCount);
+        } else {
+            csrAllocationStorage.storeAllocation(std::unique_ptr<GraphicsAllocation>(scratchAllocation), TEMPORARY_ALLOCATION);
         }
+        scratchAllocation = nullptr;
+    }
+
+    scratchSizeBytes = newScratchSizeBytes;
+    if (scratchSizeBytes == 0) {
+        return;
+    }
+    if (shareReleasedAllocation && !getMemoryManager()->peekForce32BitAllocations()) {
+        scratchAllocation = executionEnvironment.getScratchSpacePool()->obtain(scratchSizeBytes, 2 * scratchSizeBytes, commandStreamReceiver.getDeviceIndex());
+    }
+    if (scratchAllocation) {
+        scratchSizeBytes = scratchAllocation->getUnderlyingBufferSize();
+    } else {
+        createScratchSpaceAllocation();
+    }
+}
+
+void ScratchSpaceControllerBase::markScratchSpaceChanged(bool &stateBaseAddressDirty, bool &vfeStateDirty) {
+    vfeStateDirty = true;
+    force32BitAllocation = getMemoryManager()->peekForce32BitAllocations();
+    if (is64bit && !force32BitAllocation) {
+        stateBaseAddressDirty = true;
     }
 }
 
 void ScratchSpaceControllerBase::createScratchSpaceAllocation() {
     scratchAllocation = getMemoryManager()->allocateGraphicsMemoryWithProperties({scratchSizeBytes, GraphicsAllocation::AllocationType::SCRATCH_SURFACE});
     UNRECOVERABLE_IF(scratchAllocation == nullptr);
+    scratchAllocationsCount++;
 }
 
 uint64_t ScratchSpaceControllerBase::calculateNewGSH() {
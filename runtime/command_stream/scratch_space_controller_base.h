@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -12,7 +12,11 @@ namespace OCLRT {
 
 class ScratchSpaceControllerBase : public ScratchSpaceController {
   public:
+    static constexpr uint32_t lowDemandRatio = 4u;
+    static constexpr uint32_t lowDemandSubmissionsToShrink = 64u;
+
     ScratchSpaceControllerBase(const HardwareInfo &info, ExecutionEnvironment &environment, InternalAllocationStorage &allocationStorage);
+    ~ScratchSpaceControllerBase() override;
 
     void setRequiredScratchSpace(void *sshBaseAddress,
                                  uint32_t requiredPerThreadScratchSize,
@@ -27,5 +31,10 @@ class ScratchSpaceControllerBase : public ScratchSpaceController {
 
   protected:
     void createScratchSpaceAllocation();
+    void replaceScratchSpaceAllocation(size_t newScratchSizeBytes, bool shareReleasedAllocation, uint32_t currentTaskCount, uint32_t contextId);
+    void markScratchSpaceChanged(bool &stateBaseAddressDirty, bool &vfeStateDirty);
+
+    uint32_t lowDemandSubmissions = 0;
+    volatile uint32_t *releaseTagAddress = nullptr;
 };
 } // namespace OCLRT
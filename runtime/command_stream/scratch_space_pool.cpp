@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/command_stream/scratch_space_pool.h"
+#include "runtime/execution_environment/execution_environment.h"
+#include "runtime/helpers/debug_helpers.h"
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "runtime/memory_manager/memory_manager.h"
+
+namespace OCLRT {
+
+constexpr size_t ScratchSpacePool::maxIdleAllocations;
+
+ScratchSpacePool::ScratchSpacePool(ExecutionEnvironment &executionEnvironment) : executionEnvironment(executionEnvironment) {
+}
+
+ScratchSpacePool::~ScratchSpacePool() {
+    for (auto &idleAllocation : idleAllocations) {
+        freeAllocation(idleAllocation.allocation);
+    }
+}
+
+void ScratchSpacePool::release(GraphicsAllocation *allocation, uint32_t deviceIndex, volatile uint32_t *tagAddress, uint32_t taskCount) {
+    std::lock_guard<std::mutex> lock(mtx);
+    idleAllocations.push_back({allocation, deviceIndex, tagAddress, taskCount});
+
+    // drop the oldest allocations which are no longer used by GPU
+    for (auto it = idleAllocations.begin(); idleAllocations.size() > maxIdleAllocations && it != idleAllocations.end();) {
+        if (it->isCompleted()) {
+            freeAllocation(it->allocation);
+            it = idleAllocations.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+GraphicsAllocation *ScratchSpacePool::obtain(size_t minSize, size_t maxSize, uint32_t deviceIndex) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto bestFit = idleAllocations.end();
+    for (auto it = idleAllocations.begin(); it != idleAllocations.end(); ++it) {
+        auto size = it->allocation->getUnderlyingBufferSize();
+        if (it->deviceIndex != deviceIndex || size < minSize || size > maxSize || !it->isCompleted()) {
+            continue;
+        }
+        if (bestFit == idleAllocations.end() || size < bestFit->allocation->getUnderlyingBufferSize()) {
+            bestFit = it;
+        }
+    }
+    if (bestFit == idleAllocations.end()) {
+        return nullptr;
+    }
+    auto allocation = bestFit->allocation;
+    idleAllocations.erase(bestFit);
+    return allocation;
+}
+
+void ScratchSpacePool::markCompleted(volatile uint32_t *tagAddress) {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto &idleAllocation : idleAllocations) {
+        if (idleAllocation.tagAddress == tagAddress) {
+            idleAllocation.tagAddress = nullptr;
+        }
+    }
+}
+
+size_t ScratchSpacePool::getIdleAllocationsCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return idleAllocations.size();
+}
+
+void ScratchSpacePool::freeAllocation(GraphicsAllocation *allocation) {
+    UNRECOVERABLE_IF(executionEnvironment.memoryManager.get() == nullptr);
+    executionEnvironment.memoryManager->freeGraphicsMemory(allocation);
+}
+} // namespace OCLRT
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace OCLRT {
+class ExecutionEnvironment;
+class GraphicsAllocation;
+
+// Scratch allocations outgrown by command stream receivers. Allocation may be taken over
+// by any engine of the same device once the work submitted by the releasing engine completes.
+class ScratchSpacePool {
+  public:
+    static constexpr size_t maxIdleAllocations = 4u;
+
+    ScratchSpacePool(ExecutionEnvironment &executionEnvironment);
+    ~ScratchSpacePool();
+
+    void release(GraphicsAllocation *allocation, uint32_t deviceIndex, volatile uint32_t *tagAddress, uint32_t taskCount);
+    GraphicsAllocation *obtain(size_t minSize, size_t maxSize, uint32_t deviceIndex);
+    void markCompleted(volatile uint32_t *tagAddress);
+    size_t getIdleAllocationsCount();
+
+  protected:
+    struct IdleAllocation {
+        GraphicsAllocation *allocation;
+        uint32_t deviceIndex;
+        volatile uint32_t *tagAddress;
+        uint32_t taskCount;
+
+        bool isCompleted() const { return tagAddress == nullptr || *tagAddress >= taskCount; }
+    };
+
+    void freeAllocation(GraphicsAllocation *allocation);
+
+    ExecutionEnvironment &executionEnvironment;
+    std::mutex mtx;
+    std::vector<IdleAllocation> idleAllocations;
+};
+} // namespace OCLRT
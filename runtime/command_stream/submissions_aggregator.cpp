@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -13,6 +13,21 @@ void OCLRT::SubmissionAggregator::recordCommandBuffer(CommandBuffer *commandBuff
     this->cmdBuffers.pushTailOne(*commandBuffer);
 }
 
+OCLRT::CommandBuffer *OCLRT::SubmissionAggregator::obtainCommandBuffer(Device &device) {
+    auto commandBuffer = this->freeCmdBuffers.removeFrontOne();
+    if (commandBuffer && &commandBuffer->device == &device) {
+        return commandBuffer.release();
+    }
+    return new CommandBuffer(device);
+}
+
+void OCLRT::SubmissionAggregator::recycleCommandBuffer(std::unique_ptr<CommandBuffer> commandBuffer) {
+    if (commandBuffer) {
+        commandBuffer->reset();
+        this->freeCmdBuffers.pushFrontOne(*commandBuffer.release());
+    }
+}
+
 void OCLRT::SubmissionAggregator::aggregateCommandBuffers(ResourcePackage &resourcePackage, size_t &totalUsedSize, size_t totalMemoryBudget, uint32_t osContextId) {
     auto primaryCommandBuffer = this->cmdBuffers.peekHead();
     auto currentInspection = this->inspectionId;
@@ -99,3 +114,14 @@ OCLRT::BatchBuffer::BatchBuffer(GraphicsAllocation *commandBufferAllocation, siz
 OCLRT::CommandBuffer::CommandBuffer(Device &device) : device(device) {
     flushStamp.reset(new FlushStampTracker(false));
 }
+
+void OCLRT::CommandBuffer::reset() {
+    surfaces.clear();
+    batchBuffer = BatchBuffer();
+    batchBufferEndLocation = nullptr;
+    inspectionId = 0;
+    taskCount = 0u;
+    pipeControlThatMayBeErasedLocation = nullptr;
+    epiloguePipeControlLocation = nullptr;
+    flushStamp->releaseStampObject();
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -44,6 +44,7 @@ struct BatchBuffer {
 
 struct CommandBuffer : public IDNode<CommandBuffer> {
     CommandBuffer(Device &device);
+    void reset();
     ResidencyContainer surfaces;
     BatchBuffer batchBuffer;
     void *batchBufferEndLocation = nullptr;
@@ -65,8 +66,14 @@ class SubmissionAggregator {
     void aggregateCommandBuffers(ResourcePackage &resourcePackage, size_t &totalUsedSize, size_t totalMemoryBudget, uint32_t osContextId);
     CommandBufferList &peekCmdBufferList() { return cmdBuffers; }
 
+    // records are recycled to avoid heap churn per flushed task, residency containers keep their capacity
+    CommandBuffer *obtainCommandBuffer(Device &device);
+    void recycleCommandBuffer(std::unique_ptr<CommandBuffer> commandBuffer);
+    CommandBufferList &peekFreeCmdBufferList() { return freeCmdBuffers; }
+
   protected:
     CommandBufferList cmdBuffers;
+    CommandBufferList freeCmdBuffers;
     uint32_t inspectionId = 1;
 };
 } // namespace OCLRT
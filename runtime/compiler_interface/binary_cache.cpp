@@ -10,8 +10,6 @@
 #include <runtime/compiler_interface/binary_cache.h>
 #include <runtime/helpers/aligned_memory.h>
 #include <runtime/helpers/file_io.h>
-#include <runtime/helpers/hash.h>
-#include <runtime/helpers/hw_info.h>
 #include <runtime/os_interface/os_inc_base.h>
 #include <runtime/program/program.h>
 #include <runtime/utilities/debug_settings_reader.h>
@@ -19,38 +17,10 @@
 
 #include <cstring>
 #include <string>
-#include <sstream>
-#include <iomanip>
 #include <mutex>
 
 namespace OCLRT {
 std::mutex BinaryCache::cacheAccessMtx;
-const std::string BinaryCache::getCachedFileName(const HardwareInfo &hwInfo, const ArrayRef<const char> input,
-                                                 const ArrayRef<const char> options, const ArrayRef<const char> internalOptions) {
-    Hash hash;
-
-    hash.update("----", 4);
-    hash.update(&*input.begin(), input.size());
-    hash.update("----", 4);
-    hash.update(&*options.begin(), options.size());
-    hash.update("----", 4);
-    hash.update(&*internalOptions.begin(), internalOptions.size());
-
-    hash.update("----", 4);
-    hash.update(reinterpret_cast<const char *>(hwInfo.pPlatform), sizeof(*hwInfo.pPlatform));
-    hash.update("----", 4);
-    hash.update(reinterpret_cast<const char *>(hwInfo.pSkuTable), sizeof(*hwInfo.pSkuTable));
-    hash.update("----", 4);
-    hash.update(reinterpret_cast<const char *>(hwInfo.pWaTable), sizeof(*hwInfo.pWaTable));
-
-    auto res = hash.finish();
-    std::stringstream stream;
-    stream << std::setfill('0')
-           << std::setw(sizeof(res) * 2)
-           << std::hex
-           << res;
-    return stream.str();
-}
 
 BinaryCache::BinaryCache() {
     std::string keyName = "cl_cache_dir";
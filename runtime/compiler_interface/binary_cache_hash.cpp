@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2017-2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/compiler_interface/binary_cache.h"
+#include "runtime/helpers/hash.h"
+#include "runtime/helpers/hw_info.h"
+
+#include <iomanip>
+#include <sstream>
+
+namespace OCLRT {
+
+const std::string BinaryCache::getCachedFileName(const HardwareInfo &hwInfo, const ArrayRef<const char> input,
+                                                 const ArrayRef<const char> options, const ArrayRef<const char> internalOptions) {
+    Hash hash;
+
+    hash.update("----", 4);
+    hash.update(&*input.begin(), input.size());
+    hash.update("----", 4);
+    hash.update(&*options.begin(), options.size());
+    hash.update("----", 4);
+    hash.update(&*internalOptions.begin(), internalOptions.size());
+
+    hash.update("----", 4);
+    hash.update(reinterpret_cast<const char *>(hwInfo.pPlatform), sizeof(*hwInfo.pPlatform));
+    hash.update("----", 4);
+    hash.update(reinterpret_cast<const char *>(hwInfo.pSkuTable), sizeof(*hwInfo.pSkuTable));
+    hash.update("----", 4);
+    hash.update(reinterpret_cast<const char *>(hwInfo.pWaTable), sizeof(*hwInfo.pWaTable));
+
+    auto res = hash.finish();
+    std::stringstream stream;
+    stream << std::setfill('0')
+           << std::setw(sizeof(res) * 2)
+           << std::hex
+           << res;
+    return stream.str();
+}
+} // namespace OCLRT
@@ -10,6 +10,7 @@
 #include "runtime/device/device.h"
 #include "runtime/device_queue/device_queue.h"
 #include "runtime/mem_obj/image.h"
+#include "runtime/mem_obj/image_allocation_pool.h"
 #include "runtime/gtpin/gtpin_notify.h"
 #include "runtime/helpers/get_info.h"
 #include "runtime/helpers/ptr_math.h"
@@ -53,6 +54,9 @@ Context::~Context() {
     if (svmAllocsManager) {
         delete svmAllocsManager;
     }
+    if (imageAllocationPool) {
+        delete imageAllocationPool;
+    }
     if (driverDiagnostics) {
         delete driverDiagnostics;
     }
@@ -164,6 +168,9 @@ bool Context::createImpl(const cl_context_properties *properties,
         auto device = this->getDevice(0);
         this->memoryManager = device->getMemoryManager();
         this->svmAllocsManager = new SVMAllocsManager(this->memoryManager);
+        if (DebugManager.flags.EnableImageAllocationPool.get() > 0) {
+            this->imageAllocationPool = new ImageAllocationPool(*this->memoryManager, DebugManager.flags.EnableImageAllocationPool.get());
+        }
         if (memoryManager->isAsyncDeleterEnabled()) {
             memoryManager->getDeferredDeleter()->addClient();
         }
@@ -17,6 +17,7 @@ namespace OCLRT {
 class CommandQueue;
 class Device;
 class DeviceQueue;
+class ImageAllocationPool;
 class MemoryManager;
 class SharingFunctions;
 class SVMAllocsManager;
@@ -80,6 +81,10 @@ class Context : public BaseObject<_cl_context> {
         return svmAllocsManager;
     }
 
+    ImageAllocationPool *getImageAllocationPool() const {
+        return imageAllocationPool;
+    }
+
     DeviceQueue *getDefaultDeviceQueue();
     void setDefaultDeviceQueue(DeviceQueue *queue);
 
@@ -135,6 +140,7 @@ class Context : public BaseObject<_cl_context> {
     DeviceVector devices;
     MemoryManager *memoryManager;
     SVMAllocsManager *svmAllocsManager = nullptr;
+    ImageAllocationPool *imageAllocationPool = nullptr;
     CommandQueue *specialQueue;
     DeviceQueue *defaultDeviceQueue;
     std::vector<std::unique_ptr<SharingFunctions>> sharingFunctions;
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -14,9 +14,11 @@
 #include "runtime/event/event.h"
 #include "runtime/event/event_tracker.h"
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/dispatch_info.h"
 #include "runtime/helpers/get_info.h"
 #include "runtime/helpers/kernel_commands.h"
 #include "runtime/helpers/timestamp_packet.h"
+#include "runtime/kernel/kernel.h"
 #include "runtime/api/cl_types.h"
 #include "runtime/mem_obj/mem_obj.h"
 #include "runtime/utilities/range.h"
@@ -117,6 +119,13 @@ Event::~Event() {
         executeCallbacks(lastStatus);
     }
 
+    if (localWorkSizeSampleKernel != nullptr) {
+        if (lastStatus == CL_COMPLETE) {
+            calcProfilingData();
+        }
+        reportLocalWorkSizeSample(0);
+    }
+
     {
         // clean-up submitted command if needed
         std::unique_ptr<Command> submittedCommand(submittedCmd.exchange(nullptr));
@@ -292,10 +301,36 @@ bool Event::calcProfilingData() {
         }
 
         dataCalculated = true;
+        reportLocalWorkSizeSample(cpuDuration);
     }
     return dataCalculated;
 }
 
+void Event::setLocalWorkSizeSample(const DispatchInfo &dispatchInfo) {
+    auto kernel = dispatchInfo.getKernel();
+    if (kernel == nullptr || dispatchInfo.getEnqueuedWorkgroupSize().x != 0 || localWorkSizeSampleKernel != nullptr) {
+        return;
+    }
+    kernel->incRefInternal();
+    localWorkSizeSampleKernel = kernel;
+    localWorkSizeSample.key = LocalWorkSizeCacheKey(dispatchInfo);
+    localWorkSizeSample.lws = dispatchInfo.getLocalWorkgroupSize();
+}
+
+void Event::reportLocalWorkSizeSample(uint64_t durationNs) {
+    if (localWorkSizeSampleKernel == nullptr) {
+        return;
+    }
+    if (durationNs != 0) {
+        auto &lwsCache = localWorkSizeSampleKernel->getLocalWorkSizeCache();
+        if (lwsCache.reportExecutionTime(localWorkSizeSample, durationNs)) {
+            lwsCache.persistAutotuneResults();
+        }
+    }
+    localWorkSizeSampleKernel->decRefInternal();
+    localWorkSizeSampleKernel = nullptr;
+}
+
 inline bool Event::wait(bool blocking, bool useQuickKmdSleep) {
     while (this->taskCount == Event::eventNotReady) {
         if (blocking == false) {
@@ -342,6 +377,7 @@ void Event::updateExecutionStatus() {
 
     if ((cmdQueue != nullptr) && (cmdQueue->isCompleted(getCompletionStamp()))) {
         transitionExecutionStatus(CL_COMPLETE);
+        cmdQueue->printCompletedPrintfOutput();
         executeCallbacks(CL_COMPLETE);
         unblockEventsBlockedByThis(CL_COMPLETE);
         auto *allocationStorage = cmdQueue->getCommandStreamReceiver().getInternalAllocationStorage();
@@ -457,7 +493,7 @@ void Event::submitCommand(bool abortTasks) {
                 setSubmitTimeStamp();
                 setStartTimeStamp();
             } else {
-                this->cmdQueue->getDevice().getOSTime()->getCpuGpuTime(&submitTimeStamp);
+                this->cmdQueue->getDevice().getOSTime()->getCalibratedCpuGpuTime(&submitTimeStamp);
             }
             if (perfCountersEnabled && perfCounterNode) {
                 this->cmdQueue->getCommandStreamReceiver().makeResident(*perfCounterNode->getGraphicsAllocation());
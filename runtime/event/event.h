@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -7,6 +7,7 @@
 
 #pragma once
 #include "runtime/api/cl_types.h"
+#include "runtime/command_queue/local_work_size_cache.h"
 #include "runtime/helpers/base_object.h"
 #include <cstdint>
 #include <atomic>
@@ -28,7 +29,9 @@ struct TagNode;
 class CommandQueue;
 class Context;
 class Device;
+class Kernel;
 class TimestampPacketContainer;
+struct DispatchInfo;
 
 template <>
 struct OpenCLObjectMapper<_cl_event> {
@@ -94,6 +97,7 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
     cl_ulong getDelta(cl_ulong startTime,
                       cl_ulong endTime);
     bool calcProfilingData();
+    void setLocalWorkSizeSample(const DispatchInfo &dispatchInfo);
     void setCPUProfilingPath(bool isCPUPath) { this->profilingCpuPath = isCPUPath; }
     bool isCPUProfilingPath() const {
         return profilingCpuPath;
@@ -303,6 +307,8 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
     Event(Context *ctx, CommandQueue *cmdQueue, cl_command_type cmdType,
           uint32_t taskLevel, uint32_t taskCount);
 
+    void reportLocalWorkSizeSample(uint64_t durationNs);
+
     ECallbackTarget translateToCallbackTarget(cl_int execStatus) {
         switch (execStatus) {
         default: {
@@ -363,6 +369,9 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
     TagNode<HwPerfCounter> *perfCounterNode = nullptr;
     std::unique_ptr<TimestampPacketContainer> timestampPacketContainer;
     InstrPmRegsCfg *perfConfigurationData = nullptr;
+    // driver deduced local work size measured for autotuning
+    Kernel *localWorkSizeSampleKernel = nullptr;
+    LocalWorkSizeSample localWorkSizeSample;
     //number of events this event depends on
     std::atomic<int> parentCount;
     //event parents
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -8,6 +8,7 @@
 #include "runtime/aub/aub_center.h"
 #include "runtime/execution_environment/execution_environment.h"
 #include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/command_stream/scratch_space_pool.h"
 #include "runtime/compiler_interface/compiler_interface.h"
 #include "runtime/source_level_debugger/source_level_debugger.h"
 #include "runtime/built_ins/sip.h"
@@ -90,4 +91,13 @@ BuiltIns *ExecutionEnvironment::getBuiltIns() {
     }
     return this->builtins.get();
 }
+ScratchSpacePool *ExecutionEnvironment::getScratchSpacePool() {
+    if (this->scratchSpacePool.get() == nullptr) {
+        std::lock_guard<std::mutex> autolock(this->mtx);
+        if (this->scratchSpacePool.get() == nullptr) {
+            this->scratchSpacePool = std::make_unique<ScratchSpacePool>(*this);
+        }
+    }
+    return this->scratchSpacePool.get();
+}
 } // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -23,6 +23,7 @@ class CompilerInterface;
 class BuiltIns;
 struct HardwareInfo;
 class OSInterface;
+class ScratchSpacePool;
 
 using CsrContainer = std::vector<std::array<std::unique_ptr<CommandStreamReceiver>, EngineInstanceConstants::numGpgpuEngineInstances>>;
 
@@ -47,9 +48,11 @@ class ExecutionEnvironment : public ReferenceTrackedObject<ExecutionEnvironment>
     GmmHelper *getGmmHelper() const;
     MOCKABLE_VIRTUAL CompilerInterface *getCompilerInterface();
     BuiltIns *getBuiltIns();
+    ScratchSpacePool *getScratchSpacePool();
 
     std::unique_ptr<OSInterface> osInterface;
     std::unique_ptr<MemoryManager> memoryManager;
+    std::unique_ptr<ScratchSpacePool> scratchSpacePool;
     std::unique_ptr<AubCenter> aubCenter;
     CsrContainer commandStreamReceivers;
     std::unique_ptr<BuiltIns> builtins;
@@ -7,6 +7,7 @@
 
 #include "runtime/gmm_helper/gmm.h"
 #include "runtime/gmm_helper/gmm_helper.h"
+#include "runtime/gmm_helper/image_layout_cache.h"
 #include "runtime/gmm_helper/resource_info.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/debug_helpers.h"
@@ -55,11 +56,28 @@ Gmm::Gmm(GMM_RESOURCE_INFO *inputGmm) {
     gmmResourceInfo.reset(GmmResourceInfo::create(inputGmm));
 }
 
-Gmm::Gmm(ImageInfo &inputOutputImgInfo) {
-    queryImageParams(inputOutputImgInfo);
+Gmm::Gmm(ImageInfo &inputOutputImgInfo) : Gmm(inputOutputImgInfo, GmmHelper::getInstance()->getImageLayoutCache()) {}
+
+Gmm::Gmm(ImageInfo &inputOutputImgInfo, ImageLayoutCache *layoutCache) {
+    queryImageParams(inputOutputImgInfo, layoutCache);
+}
+
+void Gmm::queryImageLayout(ImageInfo &imgInfo) {
+    auto layoutCache = GmmHelper::getInstance()->getImageLayoutCache();
+    if (layoutCache && layoutCache->getLayout(imgInfo)) {
+        return;
+    }
+    Gmm gmm(imgInfo, nullptr);
+    if (layoutCache && gmm.gmmResourceInfo) {
+        layoutCache->storeLayout(imgInfo);
+    }
 }
 
 void Gmm::queryImageParams(ImageInfo &imgInfo) {
+    queryImageParams(imgInfo, GmmHelper::getInstance()->getImageLayoutCache());
+}
+
+void Gmm::queryImageParams(ImageInfo &imgInfo, ImageLayoutCache *layoutCache) {
     this->resourceParams = {};
     uint32_t imageWidth = static_cast<uint32_t>(imgInfo.imgDesc->image_width);
     uint32_t imageHeight = 1;
@@ -121,6 +139,10 @@ void Gmm::queryImageParams(ImageInfo &imgInfo) {
 
     this->gmmResourceInfo.reset(GmmResourceInfo::create(&this->resourceParams));
 
+    if (layoutCache && layoutCache->getLayout(imgInfo)) {
+        return;
+    }
+
     imgInfo.size = this->gmmResourceInfo->getSizeAllocation();
 
     imgInfo.rowPitch = this->gmmResourceInfo->getRenderPitch();
@@ -172,6 +194,10 @@ void Gmm::queryImageParams(ImageInfo &imgInfo) {
     }
 
     imgInfo.qPitch = queryQPitch(this->resourceParams.Type);
+
+    if (layoutCache) {
+        layoutCache->storeLayout(imgInfo);
+    }
 }
 
 uint32_t Gmm::queryQPitch(GMM_RESOURCE_TYPE resType) {
@@ -17,6 +17,7 @@ enum class OCLPlane;
 struct HardwareInfo;
 struct ImageInfo;
 class GmmResourceInfo;
+class ImageLayoutCache;
 
 class Gmm {
   public:
@@ -28,6 +29,7 @@ class Gmm {
     Gmm(GMM_RESOURCE_INFO *inputGmm);
 
     void queryImageParams(ImageInfo &inputOutputImgInfo);
+    static void queryImageLayout(ImageInfo &inputOutputImgInfo);
 
     uint32_t getRenderHAlignment();
     uint32_t getRenderVAlignment();
@@ -47,5 +49,9 @@ class Gmm {
 
     bool isRenderCompressed = false;
     bool useSystemMemoryPool = true;
+
+  protected:
+    Gmm(ImageInfo &inputOutputImgInfo, ImageLayoutCache *layoutCache);
+    void queryImageParams(ImageInfo &inputOutputImgInfo, ImageLayoutCache *layoutCache);
 };
 } // namespace OCLRT
@@ -9,6 +9,7 @@
 #include "runtime/execution_environment/execution_environment.h"
 #include "runtime/gmm_helper/gmm.h"
 #include "runtime/gmm_helper/gmm_helper.h"
+#include "runtime/gmm_helper/image_layout_cache.h"
 #include "runtime/gmm_helper/resource_info.h"
 #include "runtime/helpers/get_info.h"
 #include "runtime/helpers/aligned_memory.h"
@@ -38,6 +39,13 @@ void GmmHelper::setSimplifiedMocsTableUsage(bool value) {
     useSimplifiedMocsTable = value;
 }
 
+ImageLayoutCache *GmmHelper::getImageLayoutCache() {
+    if (!DebugManager.flags.EnableImageLayoutCache.get()) {
+        return nullptr;
+    }
+    return imageLayoutCache.get();
+}
+
 void GmmHelper::initContext(const PLATFORM *pPlatform,
                             const FeatureTable *pSkuTable,
                             const WorkaroundTable *pWaTable,
@@ -154,6 +162,7 @@ GMM_YUV_PLANE GmmHelper::convertPlane(OCLPlane oclPlane) {
 }
 GmmHelper::GmmHelper(const HardwareInfo *pHwInfo) : hwInfo(pHwInfo) {
     initContext(pHwInfo->pPlatform, pHwInfo->pSkuTable, pHwInfo->pWaTable, pHwInfo->pSysInfo);
+    imageLayoutCache = std::make_unique<ImageLayoutCache>();
 }
 GmmHelper::~GmmHelper() {
     gmmEntries.pfnDestroySingletonContext();
@@ -22,6 +22,7 @@ class GraphicsAllocation;
 class Gmm;
 class OsLibrary;
 class GmmClientContext;
+class ImageLayoutCache;
 
 class GmmHelper {
   public:
@@ -32,6 +33,7 @@ class GmmHelper {
     const HardwareInfo *getHardwareInfo();
     uint32_t getMOCS(uint32_t type);
     void setSimplifiedMocsTableUsage(bool value);
+    ImageLayoutCache *getImageLayoutCache();
 
     static constexpr uint32_t cacheDisabledIndex = 0;
     static constexpr uint32_t cacheEnabledIndex = 4;
@@ -61,6 +63,7 @@ class GmmHelper {
     const HardwareInfo *hwInfo = nullptr;
     std::unique_ptr<OsLibrary> gmmLib;
     std::unique_ptr<GmmClientContext> gmmClientContext;
+    std::unique_ptr<ImageLayoutCache> imageLayoutCache;
     GmmExportEntries gmmEntries = {};
 };
 } // namespace OCLRT
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/gmm_helper/image_layout_cache.h"
+#include "runtime/gmm_helper/gmm_helper.h"
+#include "runtime/helpers/surface_formats.h"
+
+#include <tuple>
+
+namespace OCLRT {
+
+constexpr size_t ImageLayoutCache::maxEntries;
+
+ImageLayoutCacheKey::ImageLayoutCacheKey(const ImageInfo &imgInfo) {
+    auto &imgDesc = *imgInfo.imgDesc;
+    imageType = imgDesc.image_type;
+    width = imgDesc.image_width;
+    switch (imageType) {
+    case CL_MEM_OBJECT_IMAGE3D:
+        depth = imgDesc.image_depth;
+        height = imgDesc.image_height;
+        break;
+    case CL_MEM_OBJECT_IMAGE2D_ARRAY:
+        arraySize = imgDesc.image_array_size;
+        height = imgDesc.image_height;
+        break;
+    case CL_MEM_OBJECT_IMAGE2D:
+        height = imgDesc.image_height;
+        break;
+    case CL_MEM_OBJECT_IMAGE1D_ARRAY:
+        arraySize = imgDesc.image_array_size;
+        break;
+    default:
+        break;
+    }
+    if (imgDesc.image_row_pitch && imgDesc.mem_object) {
+        overridePitch = imgDesc.image_row_pitch;
+    }
+    gmmFormat = imgInfo.surfaceFormat->GMMSurfaceFormat;
+    plane = imgInfo.plane;
+    baseMipLevel = imgInfo.baseMipLevel;
+    mipCount = imgInfo.mipCount;
+    tilingAllowed = GmmHelper::allowTiling(imgDesc);
+    preferRenderCompression = imgInfo.preferRenderCompression;
+    useLocalMemory = imgInfo.useLocalMemory;
+}
+
+bool ImageLayoutCacheKey::operator<(const ImageLayoutCacheKey &other) const {
+    return std::tie(width, height, depth, arraySize, overridePitch, imageType, gmmFormat, plane, baseMipLevel, mipCount, tilingAllowed, preferRenderCompression, useLocalMemory) <
+           std::tie(other.width, other.height, other.depth, other.arraySize, other.overridePitch, other.imageType, other.gmmFormat, other.plane, other.baseMipLevel, other.mipCount,
+                    other.tilingAllowed, other.preferRenderCompression, other.useLocalMemory);
+}
+
+ImageLayout::ImageLayout(const ImageInfo &imgInfo) {
+    size = imgInfo.size;
+    rowPitch = imgInfo.rowPitch;
+    slicePitch = imgInfo.slicePitch;
+    qPitch = imgInfo.qPitch;
+    offset = imgInfo.offset;
+    xOffset = imgInfo.xOffset;
+    yOffset = imgInfo.yOffset;
+    yOffsetForUVPlane = imgInfo.yOffsetForUVPlane;
+}
+
+void ImageLayout::applyTo(ImageInfo &imgInfo) const {
+    imgInfo.size = size;
+    imgInfo.rowPitch = rowPitch;
+    imgInfo.slicePitch = slicePitch;
+    imgInfo.qPitch = qPitch;
+    if (imgInfo.plane != GMM_NO_PLANE) {
+        imgInfo.offset = offset;
+        imgInfo.xOffset = xOffset;
+        imgInfo.yOffset = yOffset;
+    }
+    if (imgInfo.surfaceFormat->GMMSurfaceFormat == GMM_FORMAT_NV12) {
+        imgInfo.yOffsetForUVPlane = yOffsetForUVPlane;
+    }
+}
+
+bool ImageLayoutCache::getLayout(ImageInfo &imgInfo) {
+    ImageLayoutCacheKey key(imgInfo);
+    ImageLayout layout;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = layouts.find(key);
+        if (it == layouts.end()) {
+            missCount++;
+            return false;
+        }
+        layout = it->second;
+    }
+    hitCount++;
+    layout.applyTo(imgInfo);
+    return true;
+}
+
+void ImageLayoutCache::storeLayout(const ImageInfo &imgInfo) {
+    ImageLayoutCacheKey key(imgInfo);
+    ImageLayout layout(imgInfo);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    if (layouts.size() >= maxEntries) {
+        layouts.clear();
+    }
+    layouts[key] = layout;
+}
+
+void ImageLayoutCache::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    layouts.clear();
+}
+
+size_t ImageLayoutCache::getEntriesCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return layouts.size();
+}
+} // namespace OCLRT
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+#include "runtime/api/cl_types.h"
+#include "runtime/gmm_helper/gmm_lib.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+namespace OCLRT {
+struct ImageInfo;
+
+struct ImageLayoutCacheKey {
+    ImageLayoutCacheKey(const ImageInfo &imgInfo);
+
+    bool operator<(const ImageLayoutCacheKey &other) const;
+
+    uint64_t width = 0;
+    uint64_t height = 0;
+    uint64_t depth = 0;
+    uint64_t arraySize = 0;
+    uint64_t overridePitch = 0;
+    cl_mem_object_type imageType = 0;
+    GMM_RESOURCE_FORMAT gmmFormat = GMM_FORMAT_INVALID;
+    GMM_YUV_PLANE_ENUM plane = GMM_NO_PLANE;
+    uint32_t baseMipLevel = 0;
+    uint32_t mipCount = 0;
+    bool tilingAllowed = false;
+    bool preferRenderCompression = false;
+    bool useLocalMemory = false;
+};
+
+struct ImageLayout {
+    ImageLayout() = default;
+    ImageLayout(const ImageInfo &imgInfo);
+
+    void applyTo(ImageInfo &imgInfo) const;
+
+    size_t size = 0;
+    size_t rowPitch = 0;
+    size_t slicePitch = 0;
+    uint32_t qPitch = 0;
+    size_t offset = 0;
+    uint32_t xOffset = 0;
+    uint32_t yOffset = 0;
+    uint32_t yOffsetForUVPlane = 0;
+};
+
+// Layout of an image depends only on its descriptor and on the hardware GMM was initialized with,
+// so results of GMM queries are kept per GmmHelper and reused for repeated descriptors.
+class ImageLayoutCache {
+  public:
+    static constexpr size_t maxEntries = 1024u;
+
+    bool getLayout(ImageInfo &imgInfo);
+    void storeLayout(const ImageInfo &imgInfo);
+    void clear();
+
+    uint64_t getHitCount() const { return hitCount; }
+    uint64_t getMissCount() const { return missCount; }
+    size_t getEntriesCount();
+
+  protected:
+    std::mutex mtx;
+    std::map<ImageLayoutCacheKey, ImageLayout> layouts;
+    std::atomic<uint64_t> hitCount{0};
+    std::atomic<uint64_t> missCount{0};
+};
+} // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -21,7 +21,9 @@
 #include "runtime/platform/platform.h"
 #include "runtime/program/program.h"
 #include "runtime/utilities/spinlock.h"
+#include <algorithm>
 #include <deque>
+#include <memory>
 #include <vector>
 
 using namespace gtpin;
@@ -33,8 +35,46 @@ extern gtpin::ocl::gtpin_events_t GTPinCallbacks;
 igc_init_t *pIgcInit = nullptr;
 std::atomic<int> sequenceCount(1);
 CommandQueue *pCmdQueueForFlushTask = nullptr;
-std::deque<gtpinkexec_t> kernelExecQueue;
-SpinLock kernelExecQueueLock;
+std::vector<std::shared_ptr<GTPinQueueKernelExecs>> queueKernelExecs;
+SpinLock queueKernelExecsLock;
+
+static std::shared_ptr<GTPinQueueKernelExecs> getQueueKernelExecs(CommandQueue *pCmdQueue) {
+    auto records = std::atomic_load(&pCmdQueue->gtpinKernelExecs);
+    if (!records) {
+        // Records are attached on queue creation, queues created before GT-Pin initialization get them on first submission
+        std::unique_lock<SpinLock> lock{queueKernelExecsLock};
+        records = std::atomic_load(&pCmdQueue->gtpinKernelExecs);
+        if (!records) {
+            records = std::make_shared<GTPinQueueKernelExecs>();
+            queueKernelExecs.push_back(records);
+            std::atomic_store(&pCmdQueue->gtpinKernelExecs, records);
+        }
+    }
+    return records;
+}
+
+template <typename MakeResidentFunc>
+static void makeGtpinResourceResident(void *pKernel, MakeResidentFunc makeResident) {
+    if (pKernel == nullptr) {
+        return;
+    }
+    // Residency is requested for the queue the kernel was last submitted to
+    auto records = std::atomic_load(&static_cast<Kernel *>(pKernel)->gtpinKernelExecs);
+    if (!records) {
+        return;
+    }
+    std::unique_lock<SpinLock> queueLock{records->lock};
+    // Residency is requested before flush, so only not yet flushed records are looked up
+    for (size_t n = records->flushedCount; n < records->kernelExecs.size(); n++) {
+        auto &kExec = records->kernelExecs[n];
+        if ((kExec.pKernel == pKernel) && !kExec.isResourceResident && kExec.gtpinResource) {
+            auto pBuffer = castToObjectOrAbort<Buffer>(kExec.gtpinResource);
+            makeResident(pBuffer->getGraphicsAllocation());
+            kExec.isResourceResident = true;
+            return;
+        }
+    }
+}
 
 void gtpinNotifyContextCreate(cl_context context) {
     if (isGTPinInitialized) {
@@ -121,9 +161,11 @@ void gtpinNotifyKernelSubmit(cl_kernel kernel, void *pCmdQueue) {
         kExec.gtpinResource = (cl_mem)resource;
         kExec.commandBuffer = commandBuffer;
         kExec.pCommandQueue = (CommandQueue *)pCmdQueue;
-        std::unique_lock<SpinLock> lock{kernelExecQueueLock};
-        kernelExecQueue.push_back(kExec);
+        auto records = getQueueKernelExecs(kExec.pCommandQueue);
+        std::unique_lock<SpinLock> lock{records->lock};
+        records->kernelExecs.push_back(kExec);
         lock.unlock();
+        std::atomic_store(&pKernel->gtpinKernelExecs, records);
         // Patch SSH[gtpinBTI] with GT-Pin resource
         if (!resource) {
             return;
@@ -148,14 +190,14 @@ void gtpinNotifyPreFlushTask(void *pCmdQueue) {
 
 void gtpinNotifyFlushTask(uint32_t flushedTaskCount) {
     if (isGTPinInitialized) {
-        std::unique_lock<SpinLock> lock{kernelExecQueueLock};
-        size_t numElems = kernelExecQueue.size();
-        for (size_t n = 0; n < numElems; n++) {
-            if ((kernelExecQueue[n].pCommandQueue == pCmdQueueForFlushTask) && !kernelExecQueue[n].isTaskCountValid) {
+        auto records = pCmdQueueForFlushTask ? std::atomic_load(&pCmdQueueForFlushTask->gtpinKernelExecs) : nullptr;
+        if (records) {
+            std::unique_lock<SpinLock> lock{records->lock};
+            if (records->flushedCount < records->kernelExecs.size()) {
                 // Update record in Kernel Execution Queue with kernel's TC
-                kernelExecQueue[n].isTaskCountValid = true;
-                kernelExecQueue[n].taskCount = flushedTaskCount;
-                break;
+                auto &kExec = records->kernelExecs[records->flushedCount++];
+                kExec.isTaskCountValid = true;
+                kExec.taskCount = flushedTaskCount;
             }
         }
         pCmdQueueForFlushTask = nullptr;
@@ -164,65 +206,75 @@ void gtpinNotifyFlushTask(uint32_t flushedTaskCount) {
 
 void gtpinNotifyTaskCompletion(uint32_t completedTaskCount) {
     if (isGTPinInitialized) {
-        std::unique_lock<SpinLock> lock{kernelExecQueueLock};
-        size_t numElems = kernelExecQueue.size();
-        for (size_t n = 0; n < numElems;) {
-            if (kernelExecQueue[n].isTaskCountValid && (kernelExecQueue[n].taskCount <= completedTaskCount)) {
+        std::unique_lock<SpinLock> lock{queueKernelExecsLock};
+        for (auto it = queueKernelExecs.begin(); it != queueKernelExecs.end();) {
+            auto &records = **it;
+            std::unique_lock<SpinLock> queueLock{records.lock};
+            // Flushed records are ordered by task count, so completed ones are at the front
+            while (records.flushedCount > 0 && records.kernelExecs.front().taskCount <= completedTaskCount) {
                 // Notify GT-Pin that execution of "command buffer" was completed
-                (*GTPinCallbacks.onCommandBufferComplete)(kernelExecQueue[n].commandBuffer);
+                (*GTPinCallbacks.onCommandBufferComplete)(records.kernelExecs.front().commandBuffer);
                 // Remove kernel's record from Kernel Execution Queue
-                kernelExecQueue.erase(kernelExecQueue.begin() + n);
-                numElems--;
-            } else {
-                n++;
+                records.kernelExecs.pop_front();
+                records.flushedCount--;
             }
+            bool drained = records.queueReleased && records.kernelExecs.empty();
+            queueLock.unlock();
+            it = drained ? queueKernelExecs.erase(it) : it + 1;
         }
     }
 }
 
 void gtpinNotifyMakeResident(void *pKernel, void *pCSR) {
     if (isGTPinInitialized) {
-        std::unique_lock<SpinLock> lock{kernelExecQueueLock};
-        size_t numElems = kernelExecQueue.size();
-        for (size_t n = 0; n < numElems; n++) {
-            if ((kernelExecQueue[n].pKernel == pKernel) && !kernelExecQueue[n].isResourceResident && kernelExecQueue[n].gtpinResource) {
-                // It's time for kernel to make resident its GT-Pin resource
-                CommandStreamReceiver *pCommandStreamReceiver = reinterpret_cast<CommandStreamReceiver *>(pCSR);
-                cl_mem gtpinBuffer = kernelExecQueue[n].gtpinResource;
-                auto pBuffer = castToObjectOrAbort<Buffer>(gtpinBuffer);
-                GraphicsAllocation *pGfxAlloc = pBuffer->getGraphicsAllocation();
-                pCommandStreamReceiver->makeResident(*pGfxAlloc);
-                kernelExecQueue[n].isResourceResident = true;
-                break;
-            }
-        }
+        // It's time for kernel to make resident its GT-Pin resource
+        CommandStreamReceiver *pCommandStreamReceiver = reinterpret_cast<CommandStreamReceiver *>(pCSR);
+        makeGtpinResourceResident(pKernel, [&](GraphicsAllocation *pGfxAlloc) {
+            pCommandStreamReceiver->makeResident(*pGfxAlloc);
+        });
     }
 }
 
 void gtpinNotifyUpdateResidencyList(void *pKernel, void *pResVec) {
     if (isGTPinInitialized) {
-        std::unique_lock<SpinLock> lock{kernelExecQueueLock};
-        size_t numElems = kernelExecQueue.size();
-        for (size_t n = 0; n < numElems; n++) {
-            if ((kernelExecQueue[n].pKernel == pKernel) && !kernelExecQueue[n].isResourceResident && kernelExecQueue[n].gtpinResource) {
-                // It's time for kernel to update its residency list with its GT-Pin resource
-                std::vector<Surface *> *pResidencyVector = (std::vector<Surface *> *)pResVec;
-                cl_mem gtpinBuffer = kernelExecQueue[n].gtpinResource;
-                auto pBuffer = castToObjectOrAbort<Buffer>(gtpinBuffer);
-                GraphicsAllocation *pGfxAlloc = pBuffer->getGraphicsAllocation();
-                GeneralSurface *pSurface = new GeneralSurface(pGfxAlloc);
-                pResidencyVector->push_back(pSurface);
-                kernelExecQueue[n].isResourceResident = true;
-                break;
-            }
+        // It's time for kernel to update its residency list with its GT-Pin resource
+        std::vector<Surface *> *pResidencyVector = (std::vector<Surface *> *)pResVec;
+        makeGtpinResourceResident(pKernel, [&](GraphicsAllocation *pGfxAlloc) {
+            pResidencyVector->push_back(new GeneralSurface(pGfxAlloc));
+        });
+    }
+}
+
+void gtpinNotifyCommandQueueCreate(void *pCmdQueue) {
+    if (isGTPinInitialized) {
+        getQueueKernelExecs((CommandQueue *)pCmdQueue);
+    }
+}
+
+void gtpinNotifyCommandQueueRelease(void *pCmdQueue) {
+    auto records = std::atomic_exchange(&((CommandQueue *)pCmdQueue)->gtpinKernelExecs, std::shared_ptr<GTPinQueueKernelExecs>());
+    if (!records) {
+        return;
+    }
+    std::unique_lock<SpinLock> lock{queueKernelExecsLock};
+    std::unique_lock<SpinLock> queueLock{records->lock};
+    // Records not flushed yet will never get a task count, flushed ones are kept until they complete
+    records->kernelExecs.resize(records->flushedCount);
+    records->queueReleased = true;
+    if (records->kernelExecs.empty()) {
+        queueLock.unlock();
+        auto it = std::find(queueKernelExecs.begin(), queueKernelExecs.end(), records);
+        if (it != queueKernelExecs.end()) {
+            queueKernelExecs.erase(it);
         }
     }
 }
 
 void gtpinNotifyPlatformShutdown() {
     if (isGTPinInitialized) {
-        // Clear Kernel Execution Queue
-        kernelExecQueue.clear();
+        // Clear Kernel Execution Queues
+        std::unique_lock<SpinLock> lock{queueKernelExecsLock};
+        std::vector<std::shared_ptr<GTPinQueueKernelExecs>>().swap(queueKernelExecs);
     }
 }
 void *gtpinGetIgcInit() {
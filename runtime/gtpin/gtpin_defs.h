@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -9,6 +9,8 @@
 #include "CL/cl.h"
 #include "runtime/command_queue/command_queue.h"
 #include "runtime/kernel/kernel.h"
+#include "runtime/utilities/spinlock.h"
+#include <deque>
 
 namespace OCLRT {
 
@@ -33,4 +35,14 @@ struct GTPinKernelExec {
 };
 typedef struct GTPinKernelExec gtpinkexec_t;
 
+// Kernels submitted to one command queue, in submission order. Task counts are assigned
+// in the same order, so the first flushedCount records are the flushed ones.
+// Attached to the command queue, kept until completion of remaining records once the queue is released.
+struct GTPinQueueKernelExecs {
+    SpinLock lock;
+    std::deque<gtpinkexec_t> kernelExecs;
+    size_t flushedCount = 0;
+    bool queueReleased = false;
+};
+
 } // namespace OCLRT
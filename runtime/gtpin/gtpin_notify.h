@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -19,6 +19,8 @@ void gtpinNotifyFlushTask(uint32_t flushedTaskCount);
 void gtpinNotifyTaskCompletion(uint32_t completedTaskCount);
 void gtpinNotifyMakeResident(void *pKernel, void *pCommandStreamReceiver);
 void gtpinNotifyUpdateResidencyList(void *pKernel, void *pResidencyVector);
+void gtpinNotifyCommandQueueCreate(void *pCmdQueue);
+void gtpinNotifyCommandQueueRelease(void *pCmdQueue);
 void gtpinNotifyPlatformShutdown();
 inline bool gtpinIsGTPinInitialized() { return isGTPinInitialized; }
 void *gtpinGetIgcInit();
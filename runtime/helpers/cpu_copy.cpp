@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/helpers/cpu_copy.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CPU_COPY_STREAMING_STORES 1
+#endif
+
+namespace OCLRT {
+namespace CpuCopy {
+
+namespace {
+size_t thresholdFromDebugVariable(int32_t valueKB, size_t defaultValue) {
+    if (valueKB < 0) {
+        return defaultValue;
+    }
+    return static_cast<size_t>(valueKB) * 1024;
+}
+
+void copyChunk(void *dst, const void *src, size_t size) {
+    auto nonTemporalThreshold = getNonTemporalThreshold();
+    if (nonTemporalThreshold != 0 && size >= nonTemporalThreshold) {
+        copyNonTemporal(dst, src, size);
+    } else {
+        memcpy(dst, src, size);
+    }
+}
+
+template <typename WorkT>
+void splitAcrossThreads(uint32_t threadsCount, size_t itemsCount, WorkT &&work) {
+    std::vector<std::thread> workers;
+    workers.reserve(threadsCount - 1);
+
+    auto itemsPerThread = itemsCount / threadsCount;
+    auto remainder = itemsCount % threadsCount;
+    size_t begin = 0;
+    for (uint32_t i = 0; i < threadsCount; i++) {
+        auto end = begin + itemsPerThread + (i < remainder ? 1 : 0);
+        if (i + 1 == threadsCount) {
+            // calling thread takes the last part instead of waiting idle
+            work(begin, end);
+        } else {
+            workers.emplace_back(work, begin, end);
+        }
+        begin = end;
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+} // namespace
+
+size_t getNonTemporalThreshold() {
+    return thresholdFromDebugVariable(DebugManager.flags.CpuCopyNonTemporalThresholdKB.get(), defaultNonTemporalThreshold);
+}
+
+size_t getMultithreadThreshold() {
+    return thresholdFromDebugVariable(DebugManager.flags.CpuCopyMultithreadThresholdKB.get(), defaultMultithreadThreshold);
+}
+
+uint32_t getMaxThreads() {
+    auto maxThreads = DebugManager.flags.CpuCopyMaxThreads.get();
+    if (maxThreads > 0) {
+        return static_cast<uint32_t>(maxThreads);
+    }
+    return std::max(1u, std::min(std::thread::hardware_concurrency(), defaultMaxThreads));
+}
+
+uint32_t getThreadsCount(size_t size) {
+    auto multithreadThreshold = getMultithreadThreshold();
+    if (multithreadThreshold == 0 || size < multithreadThreshold) {
+        return 1u;
+    }
+    auto threadsBySize = std::max(static_cast<size_t>(1u), size / minBytesPerThread);
+    return static_cast<uint32_t>(std::min(static_cast<size_t>(getMaxThreads()), threadsBySize));
+}
+
+void copyNonTemporal(void *dst, const void *src, size_t size) {
+#if defined(CPU_COPY_STREAMING_STORES)
+    constexpr size_t vectorSize = sizeof(__m128i);
+    constexpr size_t blockSize = 4 * vectorSize;
+
+    auto headSize = std::min(size, (vectorSize - (castToUint64(dst) & (vectorSize - 1))) & (vectorSize - 1));
+    memcpy(dst, src, headSize);
+
+    auto dstVector = reinterpret_cast<__m128i *>(ptrOffset(dst, headSize));
+    auto srcVector = reinterpret_cast<const __m128i *>(ptrOffset(src, headSize));
+    auto remaining = size - headSize;
+    for (; remaining >= blockSize; remaining -= blockSize) {
+        auto v0 = _mm_loadu_si128(srcVector + 0);
+        auto v1 = _mm_loadu_si128(srcVector + 1);
+        auto v2 = _mm_loadu_si128(srcVector + 2);
+        auto v3 = _mm_loadu_si128(srcVector + 3);
+        _mm_stream_si128(dstVector + 0, v0);
+        _mm_stream_si128(dstVector + 1, v1);
+        _mm_stream_si128(dstVector + 2, v2);
+        _mm_stream_si128(dstVector + 3, v3);
+        srcVector += 4;
+        dstVector += 4;
+    }
+    memcpy(dstVector, srcVector, remaining);
+    // streaming stores are weakly ordered, make them visible before the copy is reported as done
+    _mm_sfence();
+#else
+    memcpy(dst, src, size);
+#endif
+}
+
+void copy(void *dst, const void *src, size_t size) {
+    if (dst == nullptr || src == nullptr || dst == src || size == 0) {
+        return;
+    }
+    auto threadsCount = getThreadsCount(size);
+    if (threadsCount <= 1) {
+        copyChunk(dst, src, size);
+        return;
+    }
+    // split on cache line boundaries so that threads never write to the same line
+    constexpr size_t lineSize = 64;
+    auto linesCount = (size + lineSize - 1) / lineSize;
+    splitAcrossThreads(threadsCount, linesCount, [=](size_t beginLine, size_t endLine) {
+        auto begin = beginLine * lineSize;
+        auto end = std::min(size, endLine * lineSize);
+        copyChunk(ptrOffset(dst, begin), ptrOffset(src, begin), end - begin);
+    });
+}
+
+void copyRegion(void *dst, size_t dstRowPitch, size_t dstSlicePitch,
+                const void *src, size_t srcRowPitch, size_t srcSlicePitch,
+                size_t rowSize, size_t rowsCount, size_t slicesCount) {
+    if (dst == nullptr || src == nullptr || rowSize == 0 || rowsCount == 0 || slicesCount == 0) {
+        return;
+    }
+    // collapse dense rows and slices into longer copies
+    if (rowsCount > 1 && rowSize == dstRowPitch && rowSize == srcRowPitch) {
+        rowSize *= rowsCount;
+        rowsCount = 1;
+        dstRowPitch = srcRowPitch = rowSize;
+    }
+    if (rowsCount == 1 && slicesCount > 1 && rowSize == dstSlicePitch && rowSize == srcSlicePitch) {
+        rowSize *= slicesCount;
+        slicesCount = 1;
+    }
+    if (rowsCount == 1 && slicesCount == 1) {
+        copy(dst, src, rowSize);
+        return;
+    }
+
+    auto copyRows = [=](size_t beginRow, size_t endRow) {
+        for (auto row = beginRow; row < endRow; row++) {
+            auto slice = row / rowsCount;
+            auto rowInSlice = row % rowsCount;
+            copyChunk(ptrOffset(dst, slice * dstSlicePitch + rowInSlice * dstRowPitch),
+                      ptrOffset(src, slice * srcSlicePitch + rowInSlice * srcRowPitch),
+                      rowSize);
+        }
+    };
+
+    auto totalRows = rowsCount * slicesCount;
+    auto threadsCount = std::min(static_cast<size_t>(getThreadsCount(rowSize * totalRows)), totalRows);
+    if (threadsCount <= 1) {
+        copyRows(0, totalRows);
+        return;
+    }
+    splitAcrossThreads(static_cast<uint32_t>(threadsCount), totalRows, copyRows);
+}
+} // namespace CpuCopy
+} // namespace OCLRT
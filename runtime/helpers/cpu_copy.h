@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace OCLRT {
+namespace CpuCopy {
+constexpr size_t defaultNonTemporalThreshold = 4 * 1024 * 1024;
+constexpr size_t defaultMultithreadThreshold = 16 * 1024 * 1024;
+constexpr uint32_t defaultMaxThreads = 4u;
+constexpr size_t minBytesPerThread = 1024 * 1024;
+
+// Thresholds in bytes, 0 means that given copy path is disabled
+size_t getNonTemporalThreshold();
+size_t getMultithreadThreshold();
+uint32_t getMaxThreads();
+uint32_t getThreadsCount(size_t size);
+
+// Copies with streaming stores, bypassing caches for destination lines
+void copyNonTemporal(void *dst, const void *src, size_t size);
+
+// Host to host copy used by zero-copy transfer paths, large copies are split across worker threads
+void copy(void *dst, const void *src, size_t size);
+
+// Copies rowsCount * slicesCount rows of rowSize bytes between pitched surfaces
+void copyRegion(void *dst, size_t dstRowPitch, size_t dstSlicePitch,
+                const void *src, size_t srcRowPitch, size_t srcSlicePitch,
+                size_t rowSize, size_t rowsCount, size_t slicesCount);
+} // namespace CpuCopy
+} // namespace OCLRT
@@ -34,6 +34,7 @@ void debugBreak(int line, const char *file) {
 }
 void abortUnrecoverable(int line, const char *file) {
     printf("Abort was called at %d line in file:\n%s\n", line, file);
+    DebugManager.flushLogs();
     abortExecution();
 }
 } // namespace OCLRT
\ No newline at end of file
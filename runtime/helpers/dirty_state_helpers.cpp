@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -7,6 +7,7 @@
 
 #include "runtime/helpers/dirty_state_helpers.h"
 #include "runtime/indirect_heap/indirect_heap.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 
 using namespace OCLRT;
 
@@ -16,6 +17,10 @@ bool HeapDirtyState::updateAndCheck(const IndirectHeap *heap) {
         return true;
     }
     bool dirty = gpuBaseAddress != heap->getHeapGpuBase() || sizeInPages != heap->getHeapSizeInPages();
+    if (DebugManager.flags.EnableHeapBaseAddressReuse.get()) {
+        // programmed size may be kept as long as it still covers the heap
+        dirty = gpuBaseAddress != heap->getHeapGpuBase() || sizeInPages < heap->getHeapSizeInPages();
+    }
     if (dirty) {
         gpuBaseAddress = heap->getHeapGpuBase();
         sizeInPages = heap->getHeapSizeInPages();
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -47,6 +47,13 @@ void FlushStampTracker::replaceStampObject(FlushStampTrackingObj *stampObj) {
     }
 }
 
+void FlushStampTracker::releaseStampObject() {
+    if (flushStampSharedHandle) {
+        flushStampSharedHandle->decRefInternal();
+        flushStampSharedHandle = nullptr;
+    }
+}
+
 void FlushStampUpdateHelper::insert(FlushStampTrackingObj *stampObj) {
     if (stampObj) {
         flushStampsToUpdate.push_back(stampObj);
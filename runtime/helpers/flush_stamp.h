@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -26,6 +26,7 @@ class FlushStampTracker {
     FlushStamp peekStamp() const;
     void setStamp(FlushStamp stamp);
     void replaceStampObject(FlushStampTrackingObj *stampObj);
+    void releaseStampObject();
 
     // Temporary. Method will be removed
     FlushStampTrackingObj *getStampReference() {
@@ -220,6 +220,7 @@ CompletionStamp &CommandComputeKernel::submit(uint32_t taskLevel, bool terminate
 
     gtpinNotifyPreFlushTask(&commandQueue);
 
+    commandStreamReceiver.setRequiredScratchSize(kernel->getScratchSize());
     completionStamp = commandStreamReceiver.flushTask(queueCommandStream,
                                                       offset,
                                                       *dsh,
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -9,7 +9,9 @@
 
 #include "runtime/helpers/kernel_commands.h"
 #include "runtime/helpers/properties_helper.h"
+#include "runtime/utilities/stackvec.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <array>
 #include <atomic>
@@ -51,6 +53,10 @@ class TimestampPacket {
                implicitDependenciesCount.load() == 0;
     }
 
+    bool isCompleted() const {
+        return data[static_cast<uint32_t>(DataIndex::ContextEnd)] != 1;
+    }
+
     uint64_t pickAddressForDataWrite(DataIndex operationType) const {
         auto index = static_cast<uint32_t>(operationType);
         return reinterpret_cast<uint64_t>(&data[index]);
@@ -76,6 +82,17 @@ static_assert(((static_cast<uint32_t>(TimestampPacket::DataIndex::Max) * Timesta
               "This structure is consumed by GPU and has to follow specific restrictions for padding and size");
 
 struct TimestampPacketHelper {
+    using WaitedPackets = StackVec<const TimestampPacket *, 32>;
+
+    // semaphore is not needed when GPU already signaled the packet or it was waited on earlier in the same stream
+    static bool isSemaphoreRequired(const TimestampPacket &timestampPacket, WaitedPackets &waitedPackets) {
+        if (timestampPacket.isCompleted() || std::find(waitedPackets.begin(), waitedPackets.end(), &timestampPacket) != waitedPackets.end()) {
+            return false;
+        }
+        waitedPackets.push_back(&timestampPacket);
+        return true;
+    }
+
     template <typename GfxFamily>
     static void programSemaphoreWithImplicitDependency(LinearStream &cmdStream, TimestampPacket &timestampPacket) {
         using MI_ATOMIC = typename GfxFamily::MI_ATOMIC;
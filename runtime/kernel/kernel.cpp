@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -174,6 +174,23 @@ template void Kernel::patchWithImplicitSurface(void *ptrToPatchInCrossThreadData
 cl_int Kernel::initialize() {
     cl_int retVal = CL_OUT_OF_HOST_MEMORY;
     do {
+        // ISA upload may be deferred until kernel creation, a retry happens on each creation attempt
+        if (!program->createDeferredKernelAllocation(const_cast<KernelInfo &>(kernelInfo))) {
+            retVal = CL_OUT_OF_RESOURCES;
+            break;
+        }
+        if (isParentKernel) {
+            auto blockManager = program->getBlockKernelManager();
+            bool blocksAllocated = true;
+            for (size_t i = 0; i < blockManager->getCount(); i++) {
+                blocksAllocated &= program->createDeferredKernelAllocation(const_cast<KernelInfo &>(*blockManager->getBlockKernelInfo(i)));
+            }
+            if (!blocksAllocated) {
+                retVal = CL_OUT_OF_RESOURCES;
+                break;
+            }
+        }
+
         const auto &workloadInfo = kernelInfo.workloadInfo;
         const auto &heapInfo = kernelInfo.heapInfo;
         const auto &patchInfo = kernelInfo.patchInfo;
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -7,6 +7,7 @@
 
 #pragma once
 #include "runtime/api/cl_types.h"
+#include "runtime/command_queue/local_work_size_cache.h"
 #include "runtime/command_stream/thread_arbitration_policy.h"
 #include "runtime/device_queue/device_queue.h"
 #include "runtime/helpers/base_object.h"
@@ -23,6 +24,7 @@ struct CompletionStamp;
 class Buffer;
 class GraphicsAllocation;
 class ImageTransformer;
+struct GTPinQueueKernelExecs;
 class Surface;
 class PrintfHandler;
 
@@ -163,6 +165,9 @@ class Kernel : public BaseObject<_cl_kernel> {
     uint32_t getStartOffset() const;
     void setStartOffset(uint32_t offset);
 
+    // GT-Pin records of the queue this kernel was last submitted to
+    std::shared_ptr<GTPinQueueKernelExecs> gtpinKernelExecs;
+
     const std::vector<SimpleKernelArgInfo> &getKernelArguments() const {
         return kernelArguments;
     }
@@ -199,6 +204,10 @@ class Kernel : public BaseObject<_cl_kernel> {
         this->context = context;
     }
 
+    LocalWorkSizeCache &getLocalWorkSizeCache() {
+        return localWorkSizeCache;
+    }
+
     Program *getProgram() const { return program; }
 
     static uint32_t getScratchSizeValueToProgramMediaVfeState(int scratchSize);
@@ -487,6 +496,10 @@ class Kernel : public BaseObject<_cl_kernel> {
     uint64_t privateSurfaceSize;
 
     GraphicsAllocation *kernelReflectionSurface;
+    bool blocksCurbePatched = false;
+    uint64_t blocksCurbeQueueGpuAddress = 0;
+    uint64_t blocksCurbeEventPoolGpuAddress = 0;
+    uint64_t blocksCurbePrintfGpuAddress = 0;
 
     bool usingSharedObjArgs;
     bool usingImagesOnly = false;
@@ -500,5 +513,6 @@ class Kernel : public BaseObject<_cl_kernel> {
     bool specialPipelineSelectMode = false;
     bool svmAllocationsRequireCacheFlush = false;
     std::vector<GraphicsAllocation *> kernelArgRequiresCacheFlush;
+    LocalWorkSizeCache localWorkSizeCache;
 };
 } // namespace OCLRT
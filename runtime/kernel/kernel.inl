@@ -30,6 +30,25 @@ void Kernel::patchReflectionSurface(DeviceQueue *devQueue, PrintfHandler *printf
     BlockKernelManager *blockManager = program->getBlockKernelManager();
     uint32_t blockCount = static_cast<uint32_t>(blockManager->getCount());
 
+    uint64_t queueGpuAddress = devQueue->getQueueBuffer()->getGpuAddress();
+    uint64_t eventPoolGpuAddress = devQueue->getEventPoolBuffer()->getGpuAddress();
+    uint64_t printfGpuAddress = 0;
+
+    if (printfHandler) {
+        GraphicsAllocation *printfSurface = printfHandler->getSurface();
+
+        if (printfSurface)
+            printfGpuAddress = printfSurface->getGpuAddress();
+    }
+
+    // Block curbes depend only on these addresses and on private surfaces created once per program
+    if (blocksCurbePatched && DebugManager.flags.EnableBlockCurbePatchReuse.get() &&
+        blocksCurbeQueueGpuAddress == queueGpuAddress &&
+        blocksCurbeEventPoolGpuAddress == eventPoolGpuAddress &&
+        blocksCurbePrintfGpuAddress == printfGpuAddress) {
+        blockCount = 0;
+    }
+
     for (uint32_t i = 0; i < blockCount; i++) {
         const KernelInfo *pBlockInfo = blockManager->getBlockKernelInfo(i);
 
@@ -50,7 +69,6 @@ void Kernel::patchReflectionSurface(DeviceQueue *devQueue, PrintfHandler *printf
             pBlockInfo->patchInfo.pAllocateStatelessPrintfSurface->DataParamOffset : ReflectionSurfaceHelper::undefinedOffset;
         uint32_t printfBufferPatchSize = pBlockInfo->patchInfo.pAllocateStatelessPrintfSurface ?
             pBlockInfo->patchInfo.pAllocateStatelessPrintfSurface->DataParamSize : 0;
-        uint64_t printfGpuAddress = 0;
         // clang-format on
 
         uint64_t privateSurfaceOffset = ReflectionSurfaceHelper::undefinedOffset;
@@ -67,13 +85,6 @@ void Kernel::patchReflectionSurface(DeviceQueue *devQueue, PrintfHandler *printf
             privateSurfaceGpuAddress = privateSurface->getGpuAddressToPatch();
         }
 
-        if (printfHandler) {
-            GraphicsAllocation *printfSurface = printfHandler->getSurface();
-
-            if (printfSurface)
-                printfGpuAddress = printfSurface->getGpuAddress();
-        }
-
         if (pBlockInfo->kernelArgInfo.size() > 0) {
             for (uint32_t i = 0; i < pBlockInfo->kernelArgInfo.size(); i++) {
                 if (pBlockInfo->kernelArgInfo[i].isDeviceQueue) {
@@ -85,13 +96,18 @@ void Kernel::patchReflectionSurface(DeviceQueue *devQueue, PrintfHandler *printf
         }
 
         ReflectionSurfaceHelper::patchBlocksCurbe<mockable>(reflectionSurface, i,
-                                                            defaultQueueOffset, defaultQueueSize, devQueue->getQueueBuffer()->getGpuAddress(),
-                                                            eventPoolOffset, eventPoolSize, devQueue->getEventPoolBuffer()->getGpuAddress(),
-                                                            deviceQueueOffset, deviceQueueSize, devQueue->getQueueBuffer()->getGpuAddress(),
+                                                            defaultQueueOffset, defaultQueueSize, queueGpuAddress,
+                                                            eventPoolOffset, eventPoolSize, eventPoolGpuAddress,
+                                                            deviceQueueOffset, deviceQueueSize, queueGpuAddress,
                                                             printfBufferOffset, printfBufferPatchSize, printfGpuAddress,
                                                             privateSurfaceOffset, privateSurfacePatchSize, privateSurfaceGpuAddress);
     }
 
+    blocksCurbePatched = true;
+    blocksCurbeQueueGpuAddress = queueGpuAddress;
+    blocksCurbeEventPoolGpuAddress = eventPoolGpuAddress;
+    blocksCurbePrintfGpuAddress = printfGpuAddress;
+
     ReflectionSurfaceHelper::setParentImageParams(reflectionSurface, this->kernelArguments, this->kernelInfo);
     ReflectionSurfaceHelper::setParentSamplerParams(reflectionSurface, this->kernelArguments, this->kernelInfo);
 }
@@ -13,6 +13,7 @@
 #include "runtime/gmm_helper/gmm.h"
 #include "runtime/gmm_helper/gmm_helper.h"
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/cpu_copy.h"
 #include "runtime/helpers/hw_helper.h"
 #include "runtime/helpers/hw_info.h"
 #include "runtime/helpers/ptr_math.h"
@@ -166,6 +167,10 @@ Buffer *Buffer::create(Context *context,
         }
 
         memory = context->getSVMAllocsManager()->getSVMAlloc(hostPtr);
+        if (memory && memory->getUnderlyingBuffer() != hostPtr) {
+            // buffer storage must start at SVM allocation, pointers inside of it (e.g. small allocations carved out of slab) are treated as regular host pointers
+            memory = nullptr;
+        }
         if (memory) {
             allocationType = GraphicsAllocation::AllocationType::BUFFER_HOST_MEMORY;
             isHostPtrSVM = true;
@@ -261,7 +266,7 @@ Buffer *Buffer::create(Context *context,
                 errcodeRet = CL_OUT_OF_RESOURCES;
             }
         } else {
-            memcpy_s(memory->getUnderlyingBuffer(), size, hostPtr, size);
+            CpuCopy::copy(memory->getUnderlyingBuffer(), hostPtr, size);
         }
     }
 
@@ -431,7 +436,7 @@ void Buffer::transferData(void *dst, void *src, size_t copySize, size_t copyOffs
     DBG_LOG(LogMemoryObject, __FUNCTION__, " hostPtr: ", hostPtr, ", size: ", copySize, ", offset: ", copyOffset, ", memoryStorage: ", memoryStorage);
     auto dstPtr = ptrOffset(dst, copyOffset);
     auto srcPtr = ptrOffset(src, copyOffset);
-    memcpy_s(dstPtr, copySize, srcPtr, copySize);
+    CpuCopy::copy(dstPtr, srcPtr, copySize);
 }
 
 void Buffer::transferDataToHostPtr(MemObjSizeArray &copySize, MemObjOffsetArray &copyOffset) {
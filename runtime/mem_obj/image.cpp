@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -16,6 +16,7 @@
 #include "runtime/gmm_helper/resource_info.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/basic_math.h"
+#include "runtime/helpers/cpu_copy.h"
 #include "runtime/helpers/get_info.h"
 #include "runtime/helpers/hw_info.h"
 #include "runtime/helpers/mipmap.h"
@@ -23,6 +24,7 @@
 #include "runtime/helpers/string.h"
 #include "runtime/helpers/surface_formats.h"
 #include "runtime/mem_obj/buffer.h"
+#include "runtime/mem_obj/image_allocation_pool.h"
 #include "runtime/mem_obj/mem_obj_helper.h"
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/os_interface/debug_settings_manager.h"
@@ -87,22 +89,25 @@ void Image::transferData(void *dest, size_t destRowPitch, size_t destSlicePitch,
         std::swap(copyRegion[1], copyRegion[2]);
     }
 
-    for (size_t slice = copyOrigin[2]; slice < (copyOrigin[2] + copyRegion[2]); slice++) {
-        auto srcSliceOffset = ptrOffset(src, srcSlicePitch * slice);
-        auto dstSliceOffset = ptrOffset(dest, destSlicePitch * slice);
+    auto originOffset = copyOrigin[0] * pixelSize;
+    auto dstOrigin = ptrOffset(dest, destSlicePitch * copyOrigin[2] + destRowPitch * copyOrigin[1] + originOffset);
+    auto srcOrigin = ptrOffset(src, srcSlicePitch * copyOrigin[2] + srcRowPitch * copyOrigin[1] + originOffset);
 
-        for (size_t height = copyOrigin[1]; height < (copyOrigin[1] + copyRegion[1]); height++) {
-            auto srcRowOffset = ptrOffset(srcSliceOffset, srcRowPitch * height);
-            auto dstRowOffset = ptrOffset(dstSliceOffset, destRowPitch * height);
+    CpuCopy::copyRegion(dstOrigin, destRowPitch, destSlicePitch,
+                        srcOrigin, srcRowPitch, srcSlicePitch,
+                        lineWidth, copyRegion[1], copyRegion[2]);
+}
 
-            memcpy_s(ptrOffset(dstRowOffset, copyOrigin[0] * pixelSize), lineWidth,
-                     ptrOffset(srcRowOffset, copyOrigin[0] * pixelSize), lineWidth);
-        }
+Image::~Image() {
+    auto imageAllocationPool = context ? context->getImageAllocationPool() : nullptr;
+    if (pooledLayout && imageAllocationPool && graphicsAllocation && memoryManager &&
+        graphicsAllocation->peekReuseCount() == 0 && allocatedMapPtr == nullptr &&
+        mapOperationsHandler.size() == 0 && destructorCallbacks.empty()) {
+        imageAllocationPool->storeAllocation(graphicsAllocation, *pooledLayout);
+        graphicsAllocation = nullptr;
     }
 }
 
-Image::~Image() = default;
-
 Image *Image::create(Context *context,
                      cl_mem_flags flags,
                      const SurfaceFormatInfo *surfaceFormat,
@@ -135,6 +140,7 @@ Image *Image::create(Context *context,
         imgInfo.surfaceFormat = surfaceFormat;
         imgInfo.mipCount = imageDesc->num_mip_levels;
         Gmm *gmm = nullptr;
+        std::unique_ptr<PooledImageLayout> pooledLayout;
 
         if (imageDesc->image_type == CL_MEM_OBJECT_IMAGE1D_ARRAY || imageDesc->image_type == CL_MEM_OBJECT_IMAGE2D_ARRAY) {
             imageCount = imageDesc->image_array_size;
@@ -196,8 +202,8 @@ Image *Image::create(Context *context,
             if (memoryManager->peekVirtualPaddingSupport() && (imageDesc->image_type == CL_MEM_OBJECT_IMAGE2D)) {
                 // Retrieve sizes from GMM and apply virtual padding if buffer storage is not big enough
                 auto queryGmmImgInfo(imgInfo);
-                std::unique_ptr<Gmm> gmm(new Gmm(queryGmmImgInfo));
-                auto gmmAllocationSize = gmm->gmmResourceInfo->getSizeAllocation();
+                Gmm::queryImageLayout(queryGmmImgInfo);
+                auto gmmAllocationSize = queryGmmImgInfo.size;
                 if (gmmAllocationSize > memory->getUnderlyingBufferSize()) {
                     memory = memoryManager->createGraphicsAllocationWithPadding(memory, gmmAllocationSize);
                 }
@@ -228,12 +234,20 @@ Image *Image::create(Context *context,
                 }
 
             } else {
-                MemoryProperties properties = {};
-                properties.flags = flags;
-                AllocationProperties allocProperties = MemObjHelper::getAllocationProperties(&imgInfo);
-                DevicesBitfield devices = MemObjHelper::getDevicesBitfield(properties);
+                auto imageAllocationPool = context->getImageAllocationPool();
+                if (imageAllocationPool && !context->isSharedContext) {
+                    pooledLayout.reset(new PooledImageLayout(imgInfo, flags));
+                    memory = imageAllocationPool->obtainAllocation(imgInfo, *pooledLayout);
+                }
 
-                memory = memoryManager->allocateGraphicsMemoryInPreferredPool(allocProperties, devices, nullptr);
+                if (!memory) {
+                    MemoryProperties properties = {};
+                    properties.flags = flags;
+                    AllocationProperties allocProperties = MemObjHelper::getAllocationProperties(&imgInfo);
+                    DevicesBitfield devices = MemObjHelper::getDevicesBitfield(properties);
+
+                    memory = memoryManager->allocateGraphicsMemoryInPreferredPool(allocProperties, devices, nullptr);
+                }
 
                 if (memory && MemoryPool::isSystemMemoryPool(memory->getMemoryPool())) {
                     zeroCopy = true;
@@ -311,6 +325,10 @@ Image *Image::create(Context *context,
         image->setQPitch(imgInfo.qPitch);
         image->setSurfaceOffsets(imgInfo.offset, imgInfo.xOffset, imgInfo.yOffset, imgInfo.yOffsetForUVPlane);
         image->setMipCount(imgInfo.mipCount);
+        if (pooledLayout) {
+            pooledLayout->layout = ImageLayout(imgInfo);
+            image->pooledLayout = std::move(pooledLayout);
+        }
         if (parentImage) {
             image->setMediaPlaneType(static_cast<cl_uint>(imageDesc->image_depth));
             image->setParentSharingHandler(parentImage->getSharingHandler());
@@ -637,7 +655,7 @@ cl_int Image::getImageParams(Context *context,
     imgInfo.imgDesc = &imageDescriptor;
     imgInfo.surfaceFormat = surfaceFormat;
 
-    std::unique_ptr<Gmm> gmm(new Gmm(imgInfo)); // query imgInfo
+    Gmm::queryImageLayout(imgInfo);
 
     *imageRowPitch = imgInfo.rowPitch;
     *imageSlicePitch = imgInfo.slicePitch;
@@ -14,6 +14,7 @@
 namespace OCLRT {
 class Image;
 struct KernelInfo;
+struct PooledImageLayout;
 struct SurfaceFormatInfo;
 
 struct SurfaceOffsets {
@@ -215,6 +216,7 @@ class Image : public MemObj {
     SurfaceOffsets surfaceOffsets = {0};
     uint32_t baseMipLevel = 0;
     uint32_t mipCount = 1;
+    std::unique_ptr<PooledImageLayout> pooledLayout;
 
     static bool isValidSingleChannelFormat(const cl_image_format *imageFormat);
     static bool isValidIntensityFormat(const cl_image_format *imageFormat);
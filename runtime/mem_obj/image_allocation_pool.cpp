@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/mem_obj/image_allocation_pool.h"
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "runtime/memory_manager/memory_manager.h"
+#include "runtime/os_interface/os_context.h"
+
+namespace OCLRT {
+
+ImageAllocationPool::ImageAllocationPool(MemoryManager &memoryManager, size_t maxPooledAllocations)
+    : memoryManager(memoryManager), maxPooledAllocations(maxPooledAllocations) {
+}
+
+ImageAllocationPool::~ImageAllocationPool() {
+    for (auto &pooledAllocation : pooledAllocations) {
+        memoryManager.checkGpuUsageAndDestroyGraphicsAllocations(pooledAllocation.allocation);
+    }
+}
+
+GraphicsAllocation *ImageAllocationPool::obtainAllocation(ImageInfo &imgInfo, const PooledImageLayout &pooledLayout) {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto it = pooledAllocations.begin(); it != pooledAllocations.end(); it++) {
+        if (it->pooledLayout.matches(pooledLayout) && isAllocationIdle(*it->allocation)) {
+            auto allocation = it->allocation;
+            it->pooledLayout.layout.applyTo(imgInfo);
+            pooledAllocations.erase(it);
+            return allocation;
+        }
+    }
+    return nullptr;
+}
+
+void ImageAllocationPool::storeAllocation(GraphicsAllocation *allocation, const PooledImageLayout &pooledLayout) {
+    GraphicsAllocation *allocationToRelease = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (pooledAllocations.size() >= maxPooledAllocations) {
+            allocationToRelease = pooledAllocations.front().allocation;
+            pooledAllocations.pop_front();
+        }
+        pooledAllocations.push_back({allocation, pooledLayout});
+    }
+    if (allocationToRelease) {
+        memoryManager.checkGpuUsageAndDestroyGraphicsAllocations(allocationToRelease);
+    }
+}
+
+size_t ImageAllocationPool::getPooledAllocationsCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return pooledAllocations.size();
+}
+
+bool ImageAllocationPool::isAllocationIdle(GraphicsAllocation &allocation) const {
+    if (!allocation.isUsed()) {
+        return true;
+    }
+    for (auto &deviceCsrs : memoryManager.getCommandStreamReceivers()) {
+        for (auto &csr : deviceCsrs) {
+            if (csr) {
+                auto osContextId = csr->getOsContext().getContextId();
+                if (allocation.isUsedByOsContext(osContextId) &&
+                    allocation.getTaskCount(osContextId) > *csr->getTagAddress()) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+} // namespace OCLRT
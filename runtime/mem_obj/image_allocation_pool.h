@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+#include "runtime/api/cl_types.h"
+#include "runtime/gmm_helper/image_layout_cache.h"
+
+#include <deque>
+#include <mutex>
+
+namespace OCLRT {
+class GraphicsAllocation;
+class MemoryManager;
+
+struct PooledImageLayout {
+    PooledImageLayout(const ImageInfo &imgInfo, cl_mem_flags flags) : key(imgInfo), flags(flags) {}
+
+    bool matches(const PooledImageLayout &other) const {
+        return flags == other.flags && !(key < other.key) && !(other.key < key);
+    }
+
+    ImageLayoutCacheKey key;
+    ImageLayout layout;
+    cl_mem_flags flags;
+};
+
+// Keeps allocations of released images so that images created later with the same descriptor and flags
+// can take them over instead of going through GMM and the OS for a new allocation.
+class ImageAllocationPool {
+  public:
+    ImageAllocationPool(MemoryManager &memoryManager, size_t maxPooledAllocations);
+    ~ImageAllocationPool();
+
+    GraphicsAllocation *obtainAllocation(ImageInfo &imgInfo, const PooledImageLayout &pooledLayout);
+    void storeAllocation(GraphicsAllocation *allocation, const PooledImageLayout &pooledLayout);
+
+    size_t getPooledAllocationsCount();
+    size_t getMaxPooledAllocations() const { return maxPooledAllocations; }
+
+  protected:
+    struct PooledAllocation {
+        GraphicsAllocation *allocation;
+        PooledImageLayout pooledLayout;
+    };
+
+    bool isAllocationIdle(GraphicsAllocation &allocation) const;
+
+    MemoryManager &memoryManager;
+    const size_t maxPooledAllocations;
+    std::mutex mtx;
+    std::deque<PooledAllocation> pooledAllocations;
+};
+} // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -10,6 +10,8 @@
 #include "runtime/memory_manager/internal_allocation_storage.h"
 #include "runtime/memory_manager/memory_manager.h"
 
+#include <algorithm>
+
 using namespace OCLRT;
 
 HostPtrFragmentsContainer::iterator HostPtrManager::findElement(const void *ptr) {
@@ -104,7 +106,7 @@ OsHandleStorage HostPtrManager::populateAlreadyAllocatedFragments(AllocationRequ
         }
 
         if (overlapStatus == OverlapStatus::FRAGMENT_NOT_CHECKED)
-            fragmentStorage = getFragmentAndCheckForOverlaps(const_cast<void *>(requirements.AllocationFragments[i].allocationPtr), requirements.AllocationFragments[i].allocationSize, overlapStatus);
+            fragmentStorage = getFragmentAndCheckForOverlapsImpl(const_cast<void *>(requirements.AllocationFragments[i].allocationPtr), requirements.AllocationFragments[i].allocationSize, overlapStatus);
 
         if (overlapStatus == OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT) {
             DEBUG_BREAK_IF(fragmentStorage == nullptr);
@@ -135,7 +137,11 @@ OsHandleStorage HostPtrManager::populateAlreadyAllocatedFragments(AllocationRequ
 }
 
 void HostPtrManager::storeFragment(FragmentStorage &fragment) {
-    std::lock_guard<decltype(allocationsMutex)> lock(allocationsMutex);
+    std::unique_lock<std::shared_timed_mutex> lock(allocationsMutex);
+    storeFragmentImpl(fragment);
+}
+
+void HostPtrManager::storeFragmentImpl(FragmentStorage &fragment) {
     auto element = findElement(fragment.fragmentCpuPointer);
     if (element != partialAllocations.end()) {
         element->second.refCount++;
@@ -163,7 +169,7 @@ void HostPtrManager::releaseHandleStorage(OsHandleStorage &fragments) {
 }
 
 bool HostPtrManager::releaseHostPtr(const void *ptr) {
-    std::lock_guard<decltype(allocationsMutex)> lock(allocationsMutex);
+    std::unique_lock<std::shared_timed_mutex> lock(allocationsMutex);
     bool fragmentReadyToBeReleased = false;
 
     auto element = findElement(ptr);
@@ -180,7 +186,7 @@ bool HostPtrManager::releaseHostPtr(const void *ptr) {
 }
 
 FragmentStorage *HostPtrManager::getFragment(const void *inputPtr) {
-    std::lock_guard<decltype(allocationsMutex)> lock(allocationsMutex);
+    std::shared_lock<std::shared_timed_mutex> lock(allocationsMutex);
     auto element = findElement(inputPtr);
     if (element != partialAllocations.end()) {
         return &element->second;
@@ -190,7 +196,11 @@ FragmentStorage *HostPtrManager::getFragment(const void *inputPtr) {
 
 //for given inputs see if any allocation overlaps
 FragmentStorage *HostPtrManager::getFragmentAndCheckForOverlaps(const void *inPtr, size_t size, OverlapStatus &overlappingStatus) {
-    std::lock_guard<decltype(allocationsMutex)> lock(allocationsMutex);
+    std::shared_lock<std::shared_timed_mutex> lock(allocationsMutex);
+    return getFragmentAndCheckForOverlapsImpl(inPtr, size, overlappingStatus);
+}
+
+FragmentStorage *HostPtrManager::getFragmentAndCheckForOverlapsImpl(const void *inPtr, size_t size, OverlapStatus &overlappingStatus) {
     void *inputPtr = const_cast<void *>(inPtr);
     auto nextElement = partialAllocations.lower_bound(inputPtr);
     auto element = nextElement;
@@ -248,20 +258,52 @@ FragmentStorage *HostPtrManager::getFragmentAndCheckForOverlaps(const void *inPt
     return nullptr;
 }
 
+void HostPtrManager::reserveRange(uintptr_t start, uintptr_t end) {
+    std::unique_lock<std::mutex> lock(reservedRangesMutex);
+    auto overlapsReservedRange = [&]() {
+        return std::any_of(reservedRanges.begin(), reservedRanges.end(), [&](const std::pair<uintptr_t, uintptr_t> &range) {
+            return start < range.second && range.first < end;
+        });
+    };
+    while (overlapsReservedRange()) {
+        reservedRangesCondition.wait(lock);
+    }
+    reservedRanges.push_back(std::make_pair(start, end));
+}
+
+void HostPtrManager::releaseRange(uintptr_t start, uintptr_t end) {
+    {
+        std::lock_guard<std::mutex> lock(reservedRangesMutex);
+        auto range = std::find(reservedRanges.begin(), reservedRanges.end(), std::make_pair(start, end));
+        DEBUG_BREAK_IF(range == reservedRanges.end());
+        reservedRanges.erase(range);
+    }
+    reservedRangesCondition.notify_all();
+}
+
 OsHandleStorage HostPtrManager::prepareOsStorageForAllocation(MemoryManager &memoryManager, size_t size, const void *ptr) {
-    std::lock_guard<decltype(allocationsMutex)> lock(allocationsMutex);
     auto requirements = HostPtrManager::getAllocationRequirements(ptr, size);
+    auto rangeStart = reinterpret_cast<uintptr_t>(alignDown(ptr, MemoryConstants::pageSize));
+    auto rangeEnd = rangeStart + requirements.totalRequiredSize;
+    reserveRange(rangeStart, rangeEnd);
 
     CheckedFragments checkedFragments;
     UNRECOVERABLE_IF(checkAllocationsForOverlapping(memoryManager, &requirements, &checkedFragments) == RequirementsStatus::FATAL);
 
-    auto osStorage = populateAlreadyAllocatedFragments(requirements, &checkedFragments);
+    OsHandleStorage osStorage;
+    {
+        // fragments might have been released since the check, look them up again while taking references
+        std::unique_lock<std::shared_timed_mutex> lock(allocationsMutex);
+        osStorage = populateAlreadyAllocatedFragments(requirements, nullptr);
+    }
     if (osStorage.fragmentCount > 0) {
         if (memoryManager.populateOsHandles(osStorage) != MemoryManager::AllocationStatus::Success) {
             memoryManager.cleanOsHandles(osStorage);
             osStorage.fragmentCount = 0;
         }
     }
+
+    releaseRange(rangeStart, rangeEnd);
     return osStorage;
 }
 
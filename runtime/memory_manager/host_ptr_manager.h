@@ -1,13 +1,16 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
  */
 
 #pragma once
+#include <condition_variable>
 #include <map>
 #include <mutex>
+#include <shared_mutex>
+#include <vector>
 #include "runtime/memory_manager/host_ptr_defines.h"
 
 namespace OCLRT {
@@ -29,8 +32,21 @@ class HostPtrManager {
     FragmentStorage *getFragmentAndCheckForOverlaps(const void *inputPtr, size_t size, OverlapStatus &overlappingStatus);
     RequirementsStatus checkAllocationsForOverlapping(MemoryManager &memoryManager, AllocationRequirements *requirements, CheckedFragments *checkedFragments);
 
+    FragmentStorage *getFragmentAndCheckForOverlapsImpl(const void *inputPtr, size_t size, OverlapStatus &overlappingStatus);
+    void storeFragmentImpl(FragmentStorage &fragment);
+
+    void reserveRange(uintptr_t start, uintptr_t end);
+    void releaseRange(uintptr_t start, uintptr_t end);
+
     HostPtrFragmentsContainer::iterator findElement(const void *ptr);
     HostPtrFragmentsContainer partialAllocations;
-    std::recursive_mutex allocationsMutex;
+    // guards fragments container only, lookups share the lock
+    std::shared_timed_mutex allocationsMutex;
+
+    // page ranges of host pointers being prepared, preparations of overlapping ranges are serialized,
+    // while preparations of disjoint ranges proceed in parallel
+    std::mutex reservedRangesMutex;
+    std::condition_variable reservedRangesCondition;
+    std::vector<std::pair<uintptr_t, uintptr_t>> reservedRanges;
 };
 } // namespace OCLRT
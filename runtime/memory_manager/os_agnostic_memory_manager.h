@@ -8,6 +8,7 @@
 #pragma once
 #include "runtime/helpers/basic_math.h"
 #include "runtime/memory_manager/memory_manager.h"
+#include <atomic>
 #include <map>
 
 namespace OCLRT {
@@ -75,7 +76,7 @@ class OsAgnosticMemoryManager : public MemoryManager {
     GraphicsAllocation *allocateGraphicsMemory64kb(AllocationData allocationData) override;
 
   private:
-    unsigned long long counter = 0;
+    std::atomic<unsigned long long> counter{0};
     bool fakeBigAllocations = false;
 };
 } // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -8,7 +8,12 @@
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/memory_manager/svm_memory_manager.h"
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/basic_math.h"
+#include "runtime/helpers/ptr_math.h"
 #include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+
+#include <algorithm>
 
 namespace OCLRT {
 
@@ -46,39 +51,169 @@ GraphicsAllocation *SVMAllocsManager::MapBasedAllocationTracker::get(const void
     return nullptr;
 }
 
-SVMAllocsManager::SVMAllocsManager(MemoryManager *memoryManager) : memoryManager(memoryManager) {
+SVMAllocsManager::SmallAllocationSlab::SmallAllocationSlab(GraphicsAllocation &allocation, size_t chunkSize, bool coherent, bool readOnly)
+    : allocation(allocation), chunkSize(chunkSize), coherent(coherent), readOnly(readOnly) {
+    auto chunksCount = static_cast<uint32_t>(allocation.getUnderlyingBufferSize() / chunkSize);
+    usedChunks.resize(chunksCount, false);
+    freeChunks.reserve(chunksCount);
+    for (auto chunk = chunksCount; chunk > 0; chunk--) {
+        freeChunks.push_back(chunk - 1);
+    }
 }
 
-void *SVMAllocsManager::createSVMAlloc(size_t size, bool coherent, bool readOnly) {
-    if (size == 0)
+void *SVMAllocsManager::SmallAllocationSlab::allocateChunk() {
+    if (freeChunks.empty()) {
         return nullptr;
+    }
+    auto chunk = freeChunks.back();
+    freeChunks.pop_back();
+    usedChunks[chunk] = true;
+    return ptrOffset(allocation.getUnderlyingBuffer(), chunk * chunkSize);
+}
 
-    std::unique_lock<std::mutex> lock(mtx);
+bool SVMAllocsManager::SmallAllocationSlab::freeChunk(const void *ptr) {
+    auto offset = ptrDiff(ptr, allocation.getUnderlyingBuffer());
+    if (offset % chunkSize != 0) {
+        return false;
+    }
+    auto chunk = static_cast<uint32_t>(offset / chunkSize);
+    if (chunk >= usedChunks.size() || !usedChunks[chunk]) {
+        return false;
+    }
+    usedChunks[chunk] = false;
+    freeChunks.push_back(chunk);
+    return true;
+}
+
+constexpr size_t SVMAllocsManager::smallAllocationSlabSize;
+constexpr size_t SVMAllocsManager::minSmallAllocationChunkSize;
+constexpr size_t SVMAllocsManager::maxSmallAllocationSize;
+
+SVMAllocsManager::SVMAllocsManager(MemoryManager *memoryManager) : memoryManager(memoryManager) {
+    if (DebugManager.flags.SVMSmallAllocationThreshold.get() > 0) {
+        smallAllocationThreshold = std::min(static_cast<size_t>(DebugManager.flags.SVMSmallAllocationThreshold.get()), maxSmallAllocationSize);
+    }
+}
+
+SVMAllocsManager::~SVMAllocsManager() {
+    for (auto &slab : slabs) {
+        if (slab.second->isEmpty()) {
+            SVMAllocs.remove(slab.second->allocation);
+            memoryManager->freeGraphicsMemory(&slab.second->allocation);
+        }
+    }
+}
+
+GraphicsAllocation *SVMAllocsManager::createSVMGraphicsAllocation(size_t size, bool coherent, bool readOnly) {
     GraphicsAllocation *GA = memoryManager->allocateGraphicsMemoryWithProperties({size, GraphicsAllocation::AllocationType::SVM});
     if (!GA) {
         return nullptr;
     }
     GA->setMemObjectsAllocationWithWritableFlags(!readOnly);
     GA->setCoherent(coherent);
+
+    std::unique_lock<std::shared_timed_mutex> lock(mtx);
     this->SVMAllocs.insert(*GA);
+    return GA;
+}
+
+void *SVMAllocsManager::createSVMAlloc(size_t size, bool coherent, bool readOnly) {
+    if (size == 0)
+        return nullptr;
+
+    if (size <= smallAllocationThreshold) {
+        return createSmallSVMAlloc(size, coherent, readOnly);
+    }
 
+    GraphicsAllocation *GA = createSVMGraphicsAllocation(size, coherent, readOnly);
+    if (!GA) {
+        return nullptr;
+    }
     return GA->getUnderlyingBuffer();
 }
 
+void *SVMAllocsManager::createSmallSVMAlloc(size_t size, bool coherent, bool readOnly) {
+    auto chunkSize = std::max(static_cast<size_t>(Math::nextPowerOfTwo(static_cast<uint32_t>(size))), minSmallAllocationChunkSize);
+
+    std::lock_guard<std::mutex> lock(slabsMtx);
+    for (auto &slab : slabs) {
+        if (slab.second->chunkSize == chunkSize && slab.second->coherent == coherent && slab.second->readOnly == readOnly && !slab.second->isFull()) {
+            return slab.second->allocateChunk();
+        }
+    }
+
+    GraphicsAllocation *GA = createSVMGraphicsAllocation(smallAllocationSlabSize, coherent, readOnly);
+    if (!GA) {
+        return nullptr;
+    }
+    auto slab = std::make_unique<SmallAllocationSlab>(*GA, chunkSize, coherent, readOnly);
+    auto ptr = slab->allocateChunk();
+    slabs.emplace(GA->getUnderlyingBuffer(), std::move(slab));
+    return ptr;
+}
+
+bool SVMAllocsManager::freeSmallSVMAlloc(void *ptr) {
+    std::lock_guard<std::mutex> lock(slabsMtx);
+    auto it = slabs.upper_bound(ptr);
+    if (it == slabs.begin()) {
+        return false;
+    }
+    --it;
+    auto &slab = *it->second;
+    if (ptr >= ptrOffset(slab.allocation.getUnderlyingBuffer(), slab.allocation.getUnderlyingBufferSize())) {
+        return false;
+    }
+    if (!slab.freeChunk(ptr)) {
+        // pointer inside slab, but not a live chunk
+        return true;
+    }
+
+    if (slab.isEmpty()) {
+        // keep the last slab of its kind to avoid reallocating it on next small request
+        auto sameKind = std::count_if(slabs.begin(), slabs.end(), [&slab](const decltype(slabs)::value_type &other) {
+            return other.second->chunkSize == slab.chunkSize && other.second->coherent == slab.coherent && other.second->readOnly == slab.readOnly;
+        });
+        if (sameKind > 1) {
+            auto &allocation = slab.allocation;
+            {
+                std::unique_lock<std::shared_timed_mutex> trackerLock(mtx);
+                SVMAllocs.remove(allocation);
+            }
+            slabs.erase(it);
+            memoryManager->freeGraphicsMemory(&allocation);
+        }
+    }
+    return true;
+}
+
 GraphicsAllocation *SVMAllocsManager::getSVMAlloc(const void *ptr) {
-    std::unique_lock<std::mutex> lock(mtx);
+    std::shared_lock<std::shared_timed_mutex> lock(mtx);
     return SVMAllocs.get(ptr);
 }
 
 void SVMAllocsManager::freeSVMAlloc(void *ptr) {
-    GraphicsAllocation *GA = getSVMAlloc(ptr);
+    if (smallAllocationThreshold > 0 && freeSmallSVMAlloc(ptr)) {
+        return;
+    }
+
+    GraphicsAllocation *GA = nullptr;
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(mtx);
+        GA = SVMAllocs.get(ptr);
+        if (GA) {
+            SVMAllocs.remove(*GA);
+        }
+    }
     if (GA) {
-        std::unique_lock<std::mutex> lock(mtx);
-        SVMAllocs.remove(*GA);
         memoryManager->freeGraphicsMemory(GA);
     }
 }
 
+size_t SVMAllocsManager::getSmallAllocationSlabsCount() {
+    std::lock_guard<std::mutex> lock(slabsMtx);
+    return slabs.size();
+}
+
 bool SVMAllocsManager::memFlagIsReadOnly(cl_svm_mem_flags flags) {
     return (flags & (CL_MEM_READ_ONLY | CL_MEM_HOST_READ_ONLY | CL_MEM_HOST_NO_ACCESS)) != 0;
 }
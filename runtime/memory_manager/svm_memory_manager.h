@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -8,7 +8,10 @@
 #pragma once
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <vector>
 #include "CL/cl.h"
 
 namespace OCLRT {
@@ -30,16 +33,49 @@ class SVMAllocsManager {
         std::map<const void *, GraphicsAllocation *> allocs;
     };
 
+    // Single SVM allocation divided into equally sized chunks handed out for small requests.
+    // Slabs are tracked like regular SVM allocations, so lookup of chunk pointer returns the slab.
+    struct SmallAllocationSlab {
+        SmallAllocationSlab(GraphicsAllocation &allocation, size_t chunkSize, bool coherent, bool readOnly);
+
+        void *allocateChunk();
+        bool freeChunk(const void *ptr);
+        bool isFull() const { return freeChunks.empty(); }
+        bool isEmpty() const { return freeChunks.size() == usedChunks.size(); }
+
+        GraphicsAllocation &allocation;
+        size_t chunkSize;
+        bool coherent;
+        bool readOnly;
+        std::vector<bool> usedChunks;
+        std::vector<uint32_t> freeChunks;
+    };
+
+    static constexpr size_t smallAllocationSlabSize = 64 * 1024;
+    static constexpr size_t minSmallAllocationChunkSize = 128;
+    static constexpr size_t maxSmallAllocationSize = 4096;
+
     SVMAllocsManager(MemoryManager *memoryManager);
+    ~SVMAllocsManager();
     void *createSVMAlloc(size_t size, bool coherent, bool readOnly);
     GraphicsAllocation *getSVMAlloc(const void *ptr);
     void freeSVMAlloc(void *ptr);
     size_t getNumAllocs() const { return SVMAllocs.getNumAllocs(); }
+    size_t getSmallAllocationSlabsCount();
     static bool memFlagIsReadOnly(cl_svm_mem_flags flags);
 
   protected:
+    GraphicsAllocation *createSVMGraphicsAllocation(size_t size, bool coherent, bool readOnly);
+    void *createSmallSVMAlloc(size_t size, bool coherent, bool readOnly);
+    bool freeSmallSVMAlloc(void *ptr);
+
     MapBasedAllocationTracker SVMAllocs;
     MemoryManager *memoryManager;
-    std::mutex mtx;
+    // lookups are far more frequent than allocations, readers share the lock
+    std::shared_timed_mutex mtx;
+
+    size_t smallAllocationThreshold = 0;
+    std::mutex slabsMtx;
+    std::map<const void *, std::unique_ptr<SmallAllocationSlab>> slabs;
 };
 } // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -13,6 +13,7 @@
 #include "runtime/helpers/dispatch_info.h"
 #include "runtime/helpers/string.h"
 #include "runtime/helpers/timestamp_packet.h"
+#include "runtime/utilities/async_log_writer.h"
 #include "runtime/utilities/debug_settings_reader_creator.h"
 
 #include "CL/cl.h"
@@ -34,6 +35,9 @@ DebugSettingsManager<DebugLevel>::DebugSettingsManager() {
     }
 
     std::remove(logFileName.c_str());
+    if (debugLoggingAvailable()) {
+        logWriter = std::make_unique<AsyncLogWriter>(logFileName);
+    }
 } // namespace OCLRT
 
 template <DebugFunctionalityLevel DebugLevel>
@@ -45,6 +49,35 @@ void DebugSettingsManager<DebugLevel>::writeToFile(std::string filename, const c
     }
 }
 
+template <DebugFunctionalityLevel DebugLevel>
+void DebugSettingsManager<DebugLevel>::writeToLog(const std::string &str) {
+    if (logWriter) {
+        logWriter->write(str);
+    }
+}
+
+template <DebugFunctionalityLevel DebugLevel>
+void DebugSettingsManager<DebugLevel>::flushLogs() {
+    if (logWriter) {
+        logWriter->flush();
+    }
+}
+
+template <DebugFunctionalityLevel DebugLevel>
+void DebugSettingsManager<DebugLevel>::closeLogWriter() {
+    if (logWriter) {
+        logWriter->closeThread();
+    }
+}
+
+template <DebugFunctionalityLevel DebugLevel>
+void DebugSettingsManager<DebugLevel>::setLogFileName(std::string filename) {
+    logFileName = filename;
+    if (logWriter) {
+        logWriter->setFileName(filename);
+    }
+}
+
 template <DebugFunctionalityLevel DebugLevel>
 DebugSettingsManager<DebugLevel>::~DebugSettingsManager() = default;
 
@@ -78,7 +111,6 @@ void DebugSettingsManager<DebugLevel>::logApiCall(const char *function, bool ent
     }
 
     if (flags.LogApiCalls.get()) {
-        std::unique_lock<std::mutex> theLock(mtx);
         std::thread::id thisThread = std::this_thread::get_id();
 
         std::stringstream ss;
@@ -89,8 +121,7 @@ void DebugSettingsManager<DebugLevel>::logApiCall(const char *function, bool ent
             ss << "Function Leave (" << errorCode << "): ";
         ss << function << std::endl;
 
-        auto str = ss.str();
-        writeToFile(logFileName, str.c_str(), str.size(), std::ios::app);
+        writeToLog(ss.str());
     }
 }
 
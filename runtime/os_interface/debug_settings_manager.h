@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -11,6 +11,7 @@
 #include <string>
 #include <fstream>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -41,6 +42,7 @@ void printDebugString(bool showDebugLogs, Args &&... args) {
 #define NO_SANITIZE
 #endif
 
+class AsyncLogWriter;
 class Kernel;
 struct MultiDispatchInfo;
 class SettingsReader;
@@ -113,6 +115,9 @@ class DebugSettingsManager {
     const std::string getMemObjects(const uintptr_t *input, uint32_t numOfObjects);
 
     MOCKABLE_VIRTUAL void writeToFile(std::string filename, const char *str, size_t length, std::ios_base::openmode mode);
+    void writeToLog(const std::string &str);
+    void flushLogs();
+    void closeLogWriter();
 
     void dumpBinaryProgram(int32_t numDevices, const size_t *lengths, const unsigned char **binaries);
     void dumpKernelArgs(const Kernel *kernel);
@@ -169,13 +174,12 @@ class DebugSettingsManager {
     void logInputs(Types &&... params) {
         if (debugLoggingAvailable()) {
             if (this->flags.LogApiCalls.get()) {
-                std::unique_lock<std::mutex> theLock(mtx);
                 std::thread::id thisThread = std::this_thread::get_id();
                 std::stringstream ss;
                 ss << "------------------------------\n";
                 printInputs(ss, "ThreadID", thisThread, params...);
                 ss << "------------------------------" << std::endl;
-                writeToFile(logFileName, ss.str().c_str(), ss.str().length(), std::ios::app);
+                writeToLog(ss.str());
             }
         }
     }
@@ -193,11 +197,10 @@ class DebugSettingsManager {
     void log(bool enableLog, Types... params) {
         if (debugLoggingAvailable()) {
             if (enableLog) {
-                std::unique_lock<std::mutex> theLock(mtx);
                 std::thread::id thisThread = std::this_thread::get_id();
                 std::stringstream ss;
                 print(ss, "ThreadID", thisThread, params...);
-                writeToFile(logFileName, ss.str().c_str(), ss.str().length(), std::ios::app);
+                writeToLog(ss.str());
             }
         }
     }
@@ -209,9 +212,7 @@ class DebugSettingsManager {
         return logFileName.c_str();
     }
 
-    void setLogFileName(std::string filename) {
-        logFileName = filename;
-    }
+    void setLogFileName(std::string filename);
     void setReaderImpl(SettingsReader *newReaderImpl) {
         readerImpl.reset(newReaderImpl);
     }
@@ -221,6 +222,7 @@ class DebugSettingsManager {
 
   protected:
     std::unique_ptr<SettingsReader> readerImpl;
+    std::unique_ptr<AsyncLogWriter> logWriter;
     std::mutex mtx;
     std::string logFileName;
 
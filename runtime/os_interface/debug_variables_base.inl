@@ -61,6 +61,8 @@ DECLARE_DEBUG_VARIABLE(bool, PrintEMDebugInformation, false, "prints execution m
 DECLARE_DEBUG_VARIABLE(bool, PrintLWSSizes, false, "prints driver choosen local workgroup sizes")
 DECLARE_DEBUG_VARIABLE(bool, PrintDispatchParameters, false, "prints dispatch paramters of kernels passed to clEnqueueNDRangeKernel")
 DECLARE_DEBUG_VARIABLE(int32_t, PrintDriverDiagnostics, -1, "prints driver diagnostics messages to standard output, value corresponds to hint level")
+DECLARE_DEBUG_VARIABLE(int32_t, PerfTraceBufferSize, 0, "0: default - disabled, >0: number of trace events buffered per thread for enqueue, flush, submission and wait phases")
+DECLARE_DEBUG_VARIABLE(std::string, PerfTraceFile, std::string("unk"), "File where collected trace events are written in Chrome trace format, unk: default - PerfTrace.json")
 /*PERFORMANCE FLAGS*/
 DECLARE_DEBUG_VARIABLE(bool, EnableNullHardware, false, "works on Windows only, sets the Null Hardware flag that makes all Command buffers completed while GPU does nothing")
 DECLARE_DEBUG_VARIABLE(bool, ForceLinearImages, false, "Force linear images. Default is Y-tiled.")
@@ -77,6 +79,24 @@ DECLARE_DEBUG_VARIABLE(bool, DisableZeroCopyForBuffers, false, "When active all
 DECLARE_DEBUG_VARIABLE(bool, ForceResourceLockOnTransferCalls, false, "Forces resource locking on memory transfer calls")
 DECLARE_DEBUG_VARIABLE(bool, EnableMakeResidentOnMapGpuVa, false, "Make allocations resident on call mapGpuVirtualAddress")
 DECLARE_DEBUG_VARIABLE(bool, EnableHostPtrTracking, true, "Enable host ptr tracking")
+DECLARE_DEBUG_VARIABLE(bool, EnableImageLayoutCache, true, "Reuse image layouts queried from GMM for images with identical descriptors")
+DECLARE_DEBUG_VARIABLE(int32_t, EnableImageAllocationPool, 0, "0: default - disabled, >0: number of released image allocations kept per context for reuse by images with identical descriptors")
+DECLARE_DEBUG_VARIABLE(int32_t, UserptrBufferObjectCacheSizeMB, 0, "0: default - disabled, >0: amount of memory in MB kept in idle userptr buffer objects for reuse by driver allocations (Linux only)")
+DECLARE_DEBUG_VARIABLE(int32_t, GemCloseWorkerMaxQueueDepth, 0, "0: default - unbounded, >0: maximum number of buffer objects queued for closing, producers wait for the worker when the queue is full (Linux only)")
+DECLARE_DEBUG_VARIABLE(int32_t, SVMSmallAllocationThreshold, 0, "0: default - disabled, >0: SVM allocations up to this size in bytes (at most 4096) are carved out of shared slab allocations")
+DECLARE_DEBUG_VARIABLE(int32_t, CpuCopyNonTemporalThresholdKB, -1, "-1: default (4096), 0: disabled, >0: size in KB from which host side copies use non-temporal stores")
+DECLARE_DEBUG_VARIABLE(int32_t, CpuCopyMultithreadThresholdKB, -1, "-1: default (16384), 0: disabled, >0: size in KB from which host side copies are split across worker threads")
+DECLARE_DEBUG_VARIABLE(int32_t, CpuCopyMaxThreads, -1, "-1: default (number of hardware threads, at most 4), >0: maximum number of threads used by single host side copy")
+DECLARE_DEBUG_VARIABLE(bool, EnableLocalWorkSizeCache, true, "Memoize driver deduced local work sizes per kernel and dispatch shape")
+DECLARE_DEBUG_VARIABLE(bool, EnableLocalWorkSizeAutotune, false, "Cycle driver deduced local work sizes through candidates and keep the fastest one, measured with events of queues with profiling enabled")
+DECLARE_DEBUG_VARIABLE(std::string, LocalWorkSizeAutotuneCacheDir, std::string("unk"), "Directory where autotuned local work sizes are persisted, unk: default - not persisted")
+DECLARE_DEBUG_VARIABLE(bool, EnableParallelKernelParsing, true, "Parse patch tokens of kernels in program binary on multiple threads")
+DECLARE_DEBUG_VARIABLE(bool, EnableLazyKernelIsaAllocation, false, "Copy kernel ISA to graphics memory when kernel is first requested instead of during build")
+DECLARE_DEBUG_VARIABLE(int32_t, ProfilingClockCalibrationIntervalMs, -1, "-1: default (100), 0: disabled - GPU clock is read for every profiled enqueue, >0: longest interval in ms between GPU clock reads calibrating CPU to GPU clock model")
+DECLARE_DEBUG_VARIABLE(bool, EnableScratchSpacePooling, true, "Grow scratch space geometrically, share outgrown scratch between engines of a device and release oversized scratch after low demand")
+DECLARE_DEBUG_VARIABLE(bool, EnableCommandStreamRing, true, "Reuse fixed set of command buffer chunks round-robin instead of replacing exhausted command stream allocation")
+DECLARE_DEBUG_VARIABLE(bool, EnableHeapBaseAddressReuse, true, "Rewind completed exhausted heaps in place and keep state base address programmed when it still covers the heap")
+DECLARE_DEBUG_VARIABLE(bool, EnableBlockCurbePatchReuse, true, "Skip repatching block curbes in reflection surface when device queue, event pool and printf surface did not change")
 
 /*FEATURE FLAGS*/
 DECLARE_DEBUG_VARIABLE(bool, EnableNV12, true, "Enables NV12 extension")
@@ -104,6 +124,7 @@ DECLARE_DEBUG_VARIABLE(int32_t, OverrideEnableQuickKmdSleep, -1, "-1: dont overr
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideQuickKmdSleepDelayMicroseconds, -1, "-1: dont override, 0: infinite timeout, >0: timeout in microseconds")
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideEnableQuickKmdSleepForSporadicWaits, -1, "-1: dont override, 0: disable, 1: enable. It works only when QuickKmdSleep is enabled.")
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideDelayQuickKmdSleepForSporadicWaitsMicroseconds, -1, "-1: dont override, >0: timeout in microseconds")
+DECLARE_DEBUG_VARIABLE(int32_t, OverrideDrmFlushStampWaitTimeoutMicroseconds, -1, "-1: dont override - wait for flush stamp in 1 ms slices, >=0: length of the slice in microseconds, after which tag is polled before waiting again (Linux only)")
 DECLARE_DEBUG_VARIABLE(int32_t, PowerSavingMode, 0, "0: default 1: enable. Whenever driver waits on GPU and its not ready, put waiting thread to sleep and wait for notification.")
 DECLARE_DEBUG_VARIABLE(int32_t, CsrDispatchMode, 0, "Chooses DispatchMode for Csr")
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideDefaultFP64Settings, -1, "-1: dont override, 0: disable, 1: enable.")
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -74,11 +74,15 @@ bool BufferObject::close() {
 int BufferObject::wait(int64_t timeoutNs) {
     drm_i915_gem_wait wait = {};
     wait.bo_handle = this->handle;
-    wait.timeout_ns = -1;
+    wait.timeout_ns = timeoutNs;
 
     int ret = this->drm->ioctl(DRM_IOCTL_I915_GEM_WAIT, &wait);
     if (ret != 0) {
-        int err = errno;
+        int err = this->drm->getErrno();
+        if (timeoutNs >= 0 && err == ETIME) {
+            // bounded wait expired, object is still busy
+            return ETIME;
+        }
         printDebugString(DebugManager.flags.PrintDebugMessages.get(), stderr, "ioctl(I915_GEM_WAIT) failed with %d. errno=%d(%s)\n", ret, err, strerror(err));
     }
     UNRECOVERABLE_IF(ret != 0);
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -48,6 +48,7 @@ class BufferObject {
 
     int exec(uint32_t used, size_t startOffset, unsigned int flags, bool requiresCoherency, uint32_t drmContextId);
 
+    // timeoutNs < 0 waits until completion, returns ETIME when object is still busy after the timeout
     int wait(int64_t timeoutNs);
     bool close();
 
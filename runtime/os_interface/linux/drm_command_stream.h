@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -56,5 +56,8 @@ class DrmCommandStreamReceiver : public DeviceCommandStreamReceiver<GfxFamily> {
     std::vector<drm_i915_gem_exec_object2> execObjectsStorage;
     Drm *drm;
     gemCloseWorkerMode gemCloseWorkerOperationMode;
+    // KMD wait for flush stamp is done in slices, so that caller can fall back to polling the tag
+    static constexpr int64_t defaultFlushStampWaitTimeoutNs = 1000 * 1000;
+    int64_t flushStampWaitTimeoutNs = defaultFlushStampWaitTimeoutNs;
 };
 } // namespace OCLRT
@@ -20,6 +20,7 @@
 #include "runtime/os_interface/linux/os_context_linux.h"
 #include "runtime/os_interface/linux/os_interface.h"
 #include "runtime/platform/platform.h"
+#include "runtime/utilities/perf_profiler.h"
 #include <cstdlib>
 #include <cstring>
 
@@ -39,10 +40,15 @@ DrmCommandStreamReceiver<GfxFamily>::DrmCommandStreamReceiver(const HardwareInfo
     CommandStreamReceiver::osInterface = executionEnvironment.osInterface.get();
     auto gmmHelper = platform()->peekExecutionEnvironment()->getGmmHelper();
     gmmHelper->setSimplifiedMocsTableUsage(this->drm->getSimplifiedMocsTableUsage());
+
+    if (DebugManager.flags.OverrideDrmFlushStampWaitTimeoutMicroseconds.get() >= 0) {
+        flushStampWaitTimeoutNs = static_cast<int64_t>(DebugManager.flags.OverrideDrmFlushStampWaitTimeoutMicroseconds.get()) * 1000;
+    }
 }
 
 template <typename GfxFamily>
 FlushStamp DrmCommandStreamReceiver<GfxFamily>::flush(BatchBuffer &batchBuffer, ResidencyContainer &allocationsForResidency) {
+    PERF_TRACE_SCOPE("DrmCommandStreamReceiver::flush", Submission);
     unsigned int engineFlag = osContext->get()->getEngineFlag();
 
     DrmAllocation *alloc = static_cast<DrmAllocation *>(batchBuffer.commandBufferAllocation);
@@ -156,10 +162,10 @@ template <typename GfxFamily>
 bool DrmCommandStreamReceiver<GfxFamily>::waitForFlushStamp(FlushStamp &flushStamp) {
     drm_i915_gem_wait wait = {};
     wait.bo_handle = static_cast<uint32_t>(flushStamp);
-    wait.timeout_ns = -1;
+    wait.timeout_ns = flushStampWaitTimeoutNs;
 
-    drm->ioctl(DRM_IOCTL_I915_GEM_WAIT, &wait);
-    return true;
+    // when bounded wait expires caller falls back to polling the tag
+    return drm->ioctl(DRM_IOCTL_I915_GEM_WAIT, &wait) == 0;
 }
 
 } // namespace OCLRT
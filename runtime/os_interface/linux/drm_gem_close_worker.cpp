@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -7,9 +7,10 @@
 
 #include <atomic>
 #include <iostream>
-#include <queue>
 #include <stdio.h>
+#include <vector>
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/linux/drm_buffer_object.h"
 #include "runtime/os_interface/linux/drm_command_stream.h"
 #include "runtime/os_interface/linux/drm_gem_close_worker.h"
@@ -19,6 +20,9 @@
 namespace OCLRT {
 
 DrmGemCloseWorker::DrmGemCloseWorker(DrmMemoryManager &memoryManager) : memoryManager(memoryManager) {
+    if (DebugManager.flags.GemCloseWorkerMaxQueueDepth.get() > 0) {
+        maxQueueDepth = static_cast<size_t>(DebugManager.flags.GemCloseWorkerMaxQueueDepth.get());
+    }
     thread = Thread::create(worker, reinterpret_cast<void *>(this));
 }
 
@@ -40,14 +44,31 @@ DrmGemCloseWorker::~DrmGemCloseWorker() {
 
 void DrmGemCloseWorker::push(BufferObject *bo) {
     std::unique_lock<std::mutex> lock(closeWorkerMutex);
+    while (maxQueueDepth > 0 && queue.size() >= maxQueueDepth && !workerDone.load()) {
+        queueSpaceCondition.wait(lock);
+    }
     workCount++;
-    queue.push(bo);
+
+    if (workerDone.load()) {
+        lock.unlock();
+        close(bo);
+        return;
+    }
+
+    // worker sleeps only on empty queue, otherwise it picks the object up with the current batch
+    bool wakeWorker = queue.empty();
+    queue.push_back(bo);
     lock.unlock();
-    condition.notify_one();
+    if (wakeWorker) {
+        condition.notify_one();
+    }
 }
 
 void DrmGemCloseWorker::close(bool blocking) {
-    active = false;
+    {
+        std::lock_guard<std::mutex> lock(closeWorkerMutex);
+        active = false;
+    }
     condition.notify_all();
     if (blocking) {
         closeThread();
@@ -64,42 +85,43 @@ inline void DrmGemCloseWorker::close(BufferObject *bo) {
     workCount--;
 }
 
+void DrmGemCloseWorker::close(std::vector<BufferObject *> &batch) {
+    // objects were submitted in order, so after first waits complete remaining ones are mostly idle
+    for (auto bo : batch) {
+        bo->wait(-1);
+    }
+    for (auto bo : batch) {
+        memoryManager.unreference(bo);
+    }
+    workCount -= static_cast<uint32_t>(batch.size());
+    batch.clear();
+}
+
 void *DrmGemCloseWorker::worker(void *arg) {
     DrmGemCloseWorker *self = reinterpret_cast<DrmGemCloseWorker *>(arg);
-    BufferObject *workItem = nullptr;
-    std::queue<BufferObject *> localQueue;
+    std::vector<BufferObject *> batch;
     std::unique_lock<std::mutex> lock(self->closeWorkerMutex);
-    lock.unlock();
-
-    while (self->active) {
-        lock.lock();
-        workItem = nullptr;
 
+    while (true) {
         while (self->queue.empty() && self->active) {
             self->condition.wait(lock);
         }
 
-        if (!self->queue.empty()) {
-            localQueue.swap(self->queue);
+        if (self->queue.empty()) {
+            break;
         }
 
+        batch.swap(self->queue);
         lock.unlock();
-        while (!localQueue.empty()) {
-            workItem = localQueue.front();
-            localQueue.pop();
-            self->close(workItem);
-        }
-    }
+        self->queueSpaceCondition.notify_all();
 
-    lock.lock();
-    while (!self->queue.empty()) {
-        workItem = self->queue.front();
-        self->queue.pop();
-        self->close(workItem);
+        self->close(batch);
+        lock.lock();
     }
 
-    lock.unlock();
     self->workerDone.store(true);
+    lock.unlock();
+    self->queueSpaceCondition.notify_all();
     return nullptr;
 }
 } // namespace OCLRT
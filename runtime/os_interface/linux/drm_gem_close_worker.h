@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -11,7 +11,7 @@
 #include <mutex>
 #include <map>
 #include <set>
-#include <queue>
+#include <vector>
 #include <cstdint>
 
 namespace OCLRT {
@@ -36,22 +36,28 @@ class DrmGemCloseWorker {
     void close(bool blocking);
 
     bool isEmpty();
+    bool isActive() const { return active.load(); }
 
   protected:
     void close(BufferObject *workItem);
+    void close(std::vector<BufferObject *> &batch);
     void closeThread();
     static void *worker(void *arg);
-    bool active = true;
+    std::atomic<bool> active{true};
 
     std::unique_ptr<Thread> thread;
 
-    std::queue<BufferObject *> queue;
+    // pending objects are handed over to the worker as a whole batch,
+    // with maxQueueDepth > 0 producers wait until the worker takes the batch
+    std::vector<BufferObject *> queue;
+    size_t maxQueueDepth = 0;
     std::atomic<uint32_t> workCount{0};
 
     DrmMemoryManager &memoryManager;
 
     std::mutex closeWorkerMutex;
     std::condition_variable condition;
+    std::condition_variable queueSpaceCondition;
     std::atomic<bool> workerDone{false};
 };
 } // namespace OCLRT
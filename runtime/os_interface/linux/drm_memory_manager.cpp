@@ -18,6 +18,7 @@
 #include "runtime/helpers/surface_formats.h"
 #include <cstring>
 #include <iostream>
+#include <thread>
 
 #include "drm/i915_drm.h"
 #include "drm/drm.h"
@@ -54,6 +55,10 @@ DrmMemoryManager::DrmMemoryManager(Drm *drm, gemCloseWorkerMode mode, bool force
     }
 
     initInternalRangeAllocator(platformDevices[0]->capabilityTable.gpuAddressSpace);
+
+    if (DebugManager.flags.UserptrBufferObjectCacheSizeMB.get() > 0) {
+        userptrBufferObjectCacheLimit = static_cast<size_t>(DebugManager.flags.UserptrBufferObjectCacheSizeMB.get()) * MemoryConstants::megaByte;
+    }
 }
 
 DrmMemoryManager::~DrmMemoryManager() {
@@ -63,6 +68,7 @@ DrmMemoryManager::~DrmMemoryManager() {
         this->limitedGpuAddressRangeAllocator->free(this->internal32bitAllocator->getBase(), size);
     }
     applyCommonCleanup();
+    trimUserptrBufferObjectCache(0u);
     if (gemCloseWorker) {
         gemCloseWorker->close(false);
     }
@@ -106,8 +112,9 @@ uint32_t DrmMemoryManager::unreference(OCLRT::BufferObject *bo, bool synchronous
         return -1;
 
     if (synchronousDestroy) {
-        while (bo->refCount > 1)
-            ;
+        while (bo->refCount > 1) {
+            std::this_thread::yield();
+        }
     }
 
     std::unique_lock<std::mutex> lock(mtx, std::defer_lock);
@@ -203,6 +210,105 @@ OCLRT::BufferObject *DrmMemoryManager::allocUserptr(uintptr_t address, size_t si
     return res;
 }
 
+BufferObject *DrmMemoryManager::createUserptrBufferObject(size_t size, size_t alignment) {
+    auto res = alignedMallocWrapper(size, alignment);
+
+    if (!res)
+        return nullptr;
+
+    BufferObject *bo = allocUserptr(reinterpret_cast<uintptr_t>(res), size, 0, true);
+
+    if (!bo) {
+        alignedFreeWrapper(res);
+        return nullptr;
+    }
+
+    bo->isAllocated = true;
+    return bo;
+}
+
+BufferObject *DrmMemoryManager::obtainUserptrBufferObjectFromCache(size_t size, size_t alignment) {
+    std::lock_guard<std::mutex> lock(userptrBufferObjectCacheMtx);
+    auto range = userptrBufferObjectCache.equal_range(size);
+    for (auto it = range.first; it != range.second; ++it) {
+        auto bo = it->second;
+        if (reinterpret_cast<uintptr_t>(bo->peekAddress()) % alignment == 0) {
+            userptrBufferObjectCache.erase(it);
+            userptrBufferObjectCacheSize -= size;
+            return bo;
+        }
+    }
+    return nullptr;
+}
+
+bool DrmMemoryManager::isUserptrBufferObjectCacheable(DrmAllocation &allocation, BufferObject &bo) const {
+    // only BOs created by allocateGraphicsMemoryWithAlignment - softpinned at their own, driver allocated memory
+    return userptrBufferObjectCacheLimit > 0 &&
+           &bo != pinBB &&
+           bo.peekIsAllocated() &&
+           !bo.peekIsReusableAllocation() &&
+           bo.peekUnmapSize() == 0 &&
+           bo.getRefCount() == 1 &&
+           bo.peekAddress() == allocation.getUnderlyingBuffer() &&
+           bo.peekSize() == allocation.getUnderlyingBufferSize() &&
+           allocation.getMemoryPool() == MemoryPool::System4KBPages &&
+           allocation.driverAllocatedCpuPointer == nullptr &&
+           allocation.peekSharedHandle() == Sharing::nonSharedResource;
+}
+
+bool DrmMemoryManager::storeUserptrBufferObjectInCache(BufferObject *bo) {
+    auto size = bo->peekSize();
+    if (size > userptrBufferObjectCacheLimit) {
+        return false;
+    }
+    trimUserptrBufferObjectCache(userptrBufferObjectCacheLimit - size);
+
+    std::lock_guard<std::mutex> lock(userptrBufferObjectCacheMtx);
+    userptrBufferObjectCache.insert({size, bo});
+    userptrBufferObjectCacheSize += size;
+    return true;
+}
+
+void DrmMemoryManager::trimUserptrBufferObjectCache(size_t targetSize) {
+    std::vector<BufferObject *> bosToRelease;
+    {
+        std::lock_guard<std::mutex> lock(userptrBufferObjectCacheMtx);
+        // largest buffers go first, so the ceiling is reached with the fewest ioctls
+        while (userptrBufferObjectCacheSize > targetSize) {
+            auto largest = std::prev(userptrBufferObjectCache.end());
+            userptrBufferObjectCacheSize -= largest->first;
+            bosToRelease.push_back(largest->second);
+            userptrBufferObjectCache.erase(largest);
+        }
+    }
+    for (auto bo : bosToRelease) {
+        unreference(bo);
+    }
+}
+
+size_t DrmMemoryManager::getUserptrBufferObjectCacheSize() {
+    std::lock_guard<std::mutex> lock(userptrBufferObjectCacheMtx);
+    return userptrBufferObjectCacheSize;
+}
+
+bool DrmMemoryManager::isAllocationBusy(const GraphicsAllocation &graphicsAllocation) const {
+    if (!graphicsAllocation.isUsed()) {
+        return false;
+    }
+    for (auto &deviceCsrs : getCommandStreamReceivers()) {
+        for (auto &csr : deviceCsrs) {
+            if (csr) {
+                auto osContextId = csr->getOsContext().getContextId();
+                if (graphicsAllocation.isUsedByOsContext(osContextId) &&
+                    graphicsAllocation.getTaskCount(osContextId) > *csr->getTagAddress()) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
 DrmAllocation *DrmMemoryManager::createGraphicsAllocation(OsHandleStorage &handleStorage, size_t hostPtrSize, const void *hostPtr) {
     auto allocation = new DrmAllocation(nullptr, const_cast<void *>(hostPtr), hostPtrSize, MemoryPool::System4KBPages, getOsContextCount(), false);
     allocation->fragmentsStorage = handleStorage;
@@ -216,19 +322,21 @@ DrmAllocation *DrmMemoryManager::allocateGraphicsMemoryWithAlignment(const Alloc
     // It's needed to prevent overlapping pages with user pointers
     size_t cSize = std::max(alignUp(allocationData.size, minAlignment), minAlignment);
 
-    auto res = alignedMallocWrapper(cSize, cAlignment);
-
-    if (!res)
-        return nullptr;
-
-    BufferObject *bo = allocUserptr(reinterpret_cast<uintptr_t>(res), cSize, 0, true);
+    BufferObject *bo = obtainUserptrBufferObjectFromCache(cSize, cAlignment);
 
     if (!bo) {
-        alignedFreeWrapper(res);
-        return nullptr;
+        bo = createUserptrBufferObject(cSize, cAlignment);
+        if (!bo && getUserptrBufferObjectCacheSize() > 0) {
+            // memory pressure - give cached buffers back and retry
+            trimUserptrBufferObjectCache(0u);
+            bo = createUserptrBufferObject(cSize, cAlignment);
+        }
     }
 
-    bo->isAllocated = true;
+    if (!bo)
+        return nullptr;
+
+    auto res = bo->peekAddress();
     if (forcePinEnabled && pinBB != nullptr && allocationData.flags.forcePin && allocationData.size >= this->pinThreshold) {
         pinBB->pin(&bo, 1, getDefaultCommandStreamReceiver(0)->getOsContext().get()->getDrmContextId());
     }
@@ -560,6 +668,8 @@ void DrmMemoryManager::freeGraphicsMemoryImpl(GraphicsAllocation *gfxAllocation)
     }
 
     BufferObject *search = input->getBO();
+    bool cacheable = isUserptrBufferObjectCacheable(*input, *search);
+    bool releaseOnWorker = gemCloseWorker && gemCloseWorker->isActive() && isAllocationBusy(*input);
 
     if (gfxAllocation->peekSharedHandle() != Sharing::nonSharedResource) {
         closeFunction(gfxAllocation->peekSharedHandle());
@@ -567,7 +677,16 @@ void DrmMemoryManager::freeGraphicsMemoryImpl(GraphicsAllocation *gfxAllocation)
 
     delete gfxAllocation;
 
+    if (releaseOnWorker) {
+        // GPU still uses the buffer, wait for it and close it on the worker thread instead of stalling the caller
+        gemCloseWorker->push(search);
+        return;
+    }
+
     search->wait(-1);
+    if (cacheable && storeUserptrBufferObjectInCache(search)) {
+        return;
+    }
     unreference(search);
 }
 
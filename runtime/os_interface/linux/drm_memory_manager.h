@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -57,12 +57,21 @@ class DrmMemoryManager : public MemoryManager {
 
     DrmGemCloseWorker *peekGemCloseWorker() { return this->gemCloseWorker.get(); }
 
+    void trimUserptrBufferObjectCache(size_t targetSize);
+    size_t getUserptrBufferObjectCacheSize();
+    size_t getUserptrBufferObjectCacheLimit() const { return userptrBufferObjectCacheLimit; }
+
   protected:
     BufferObject *findAndReferenceSharedBufferObject(int boHandle);
     BufferObject *createSharedBufferObject(int boHandle, size_t size, bool requireSpecificBitness);
     void eraseSharedBufferObject(BufferObject *bo);
     void pushSharedBufferObject(BufferObject *bo);
     BufferObject *allocUserptr(uintptr_t address, size_t size, uint64_t flags, bool softpin);
+    BufferObject *createUserptrBufferObject(size_t size, size_t alignment);
+    BufferObject *obtainUserptrBufferObjectFromCache(size_t size, size_t alignment);
+    bool isUserptrBufferObjectCacheable(DrmAllocation &allocation, BufferObject &bo) const;
+    bool isAllocationBusy(const GraphicsAllocation &graphicsAllocation) const;
+    bool storeUserptrBufferObjectInCache(BufferObject *bo);
     bool setDomainCpu(GraphicsAllocation &graphicsAllocation, bool writeEnable);
     uint64_t acquireGpuRange(size_t &size, StorageAllocatorType &allocType, bool requireSpecificBitness);
     void releaseGpuRange(void *address, size_t unmapSize, StorageAllocatorType allocatorType);
@@ -86,5 +95,11 @@ class DrmMemoryManager : public MemoryManager {
     std::mutex mtx;
     std::unique_ptr<Allocator32bit> internal32bitAllocator;
     std::unique_ptr<AllocatorLimitedRange> limitedGpuAddressRangeAllocator;
+
+    // idle userptr BOs together with their backing memory, bucketed by size
+    std::multimap<size_t, BufferObject *> userptrBufferObjectCache;
+    size_t userptrBufferObjectCacheSize = 0;
+    size_t userptrBufferObjectCacheLimit = 0;
+    std::mutex userptrBufferObjectCacheMtx;
 };
 } // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -9,6 +9,7 @@
 #include "runtime/os_interface/os_library.h"
 #include "os_library.h"
 #include <dlfcn.h>
+#include <link.h>
 
 namespace OCLRT {
 OsLibrary *OsLibrary::load(const std::string &name) {
@@ -48,5 +49,13 @@ void *OsLibrary::getProcAddress(const std::string &procName) {
 
     return dlsym(this->handle, procName.c_str());
 }
+
+std::string OsLibrary::getFullPath() {
+    struct link_map *map = nullptr;
+    if (this->handle == nullptr || dlinfo(this->handle, RTLD_DI_LINKMAP, &map) != 0 || map == nullptr) {
+        return std::string();
+    }
+    return std::string(map->l_name);
+}
 } // namespace Linux
 } // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -21,6 +21,7 @@ class OsLibrary : public OCLRT::OsLibrary {
 
     bool isLoaded() override;
     void *getProcAddress(const std::string &procName) override;
+    std::string getFullPath() override;
 };
 } // namespace Linux
 } // namespace OCLRT
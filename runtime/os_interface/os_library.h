@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -38,5 +38,6 @@ class OsLibrary {
     }
     virtual void *getProcAddress(const std::string &procName) = 0;
     virtual bool isLoaded() = 0;
+    virtual std::string getFullPath() = 0;
 };
 } // namespace OCLRT
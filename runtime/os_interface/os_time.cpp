@@ -21,11 +21,87 @@
  */
 
 #include "runtime/helpers/hw_info.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/os_time.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace OCLRT {
 
+const uint64_t OSTime::defaultClockCalibrationIntervalNs;
+const uint64_t OSTime::minClockCalibrationIntervalNs;
+const uint64_t OSTime::maxClockModelErrorNs;
+
 double OSTime::getDeviceTimerResolution(HardwareInfo const &hwInfo) {
     return hwInfo.capabilityTable.defaultProfilingTimerResolution;
 };
+
+uint64_t OSTime::getMaxClockCalibrationIntervalNs() {
+    auto intervalMs = DebugManager.flags.ProfilingClockCalibrationIntervalMs.get();
+    if (intervalMs < 0) {
+        return defaultClockCalibrationIntervalNs;
+    }
+    return static_cast<uint64_t>(intervalMs) * 1000000ull;
+}
+
+bool OSTime::getCalibratedCpuGpuTime(TimeStampData *pGpuCpuTime) {
+    auto maxIntervalNs = getMaxClockCalibrationIntervalNs();
+    uint64_t cpuTime = 0;
+    if (maxIntervalNs == 0 || !getCpuTime(&cpuTime)) {
+        return getCpuGpuTime(pGpuCpuTime);
+    }
+
+    std::lock_guard<std::mutex> lock(clockModelMutex);
+    if (clockModel.hasSlope &&
+        (cpuTime < clockModel.anchor.CPUTimeinNS || cpuTime - clockModel.anchor.CPUTimeinNS < clockModel.calibrationIntervalNs)) {
+        pGpuCpuTime->CPUTimeinNS = cpuTime;
+        pGpuCpuTime->GPUTimeStamp = estimateGpuTime(cpuTime);
+        return true;
+    }
+    return calibrateClockModel(pGpuCpuTime, maxIntervalNs);
+}
+
+bool OSTime::calibrateClockModel(TimeStampData *pGpuCpuTime, uint64_t maxIntervalNs) {
+    TimeStampData sample = {0, 0};
+    if (!getCpuGpuTime(&sample)) {
+        return false;
+    }
+    clockCalibrationsCount++;
+    *pGpuCpuTime = sample;
+
+    // interval between GPU clock reads grows while predictions stay accurate and shrinks as soon as they drift away
+    auto &model = clockModel;
+    if (model.hasSlope) {
+        auto errorNs = std::abs(static_cast<double>(estimateGpuTime(sample.CPUTimeinNS)) - static_cast<double>(sample.GPUTimeStamp)) / model.gpuTicksPerNs;
+        if (errorNs > static_cast<double>(maxClockModelErrorNs)) {
+            model.calibrationIntervalNs = std::max(model.calibrationIntervalNs / 2, minClockCalibrationIntervalNs);
+        } else {
+            model.calibrationIntervalNs = std::min(model.calibrationIntervalNs * 2, maxIntervalNs);
+        }
+    }
+    model.calibrationIntervalNs = std::min(std::max(model.calibrationIntervalNs, minClockCalibrationIntervalNs), maxIntervalNs);
+
+    if (model.hasReference && sample.GPUTimeStamp > model.reference.GPUTimeStamp && sample.CPUTimeinNS > model.reference.CPUTimeinNS) {
+        auto cpuDelta = sample.CPUTimeinNS - model.reference.CPUTimeinNS;
+        if (cpuDelta >= minClockCalibrationIntervalNs) {
+            model.gpuTicksPerNs = static_cast<double>(sample.GPUTimeStamp - model.reference.GPUTimeStamp) / static_cast<double>(cpuDelta);
+            model.hasSlope = true;
+            model.reference = sample;
+        }
+    } else {
+        // first read or GPU clock wrapped around
+        model.reference = sample;
+        model.hasReference = true;
+        model.hasSlope = false;
+    }
+    model.anchor = sample;
+    return true;
+}
+
+uint64_t OSTime::estimateGpuTime(uint64_t cpuTime) const {
+    auto cpuDelta = static_cast<double>(static_cast<int64_t>(cpuTime - clockModel.anchor.CPUTimeinNS));
+    auto gpuTime = static_cast<int64_t>(clockModel.anchor.GPUTimeStamp) + static_cast<int64_t>(std::llround(cpuDelta * clockModel.gpuTicksPerNs));
+    return static_cast<uint64_t>(gpuTime);
+}
 } // namespace OCLRT
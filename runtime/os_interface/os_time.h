@@ -21,7 +21,9 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <memory>
+#include <mutex>
 
 #define NSEC_PER_SEC (1000000000ULL)
 
@@ -35,13 +37,31 @@ struct TimeStampData {
     uint64_t CPUTimeinNS;  // CPU time in ns
 };
 
+// Linear relation between CPU and GPU clocks fitted from two GPU clock reads,
+// used to derive GPU timestamps from CPU clock without querying the device.
+struct CpuGpuClockModel {
+    TimeStampData reference = {0, 0};
+    TimeStampData anchor = {0, 0};
+    double gpuTicksPerNs = 0.0;
+    uint64_t calibrationIntervalNs = 0;
+    bool hasReference = false;
+    bool hasSlope = false;
+};
+
 class OSTime {
   public:
     static std::unique_ptr<OSTime> create(OSInterface *osInterface);
 
+    static const uint64_t defaultClockCalibrationIntervalNs = 100000000ull;
+    static const uint64_t minClockCalibrationIntervalNs = 1000000ull;
+    static const uint64_t maxClockModelErrorNs = 5000ull;
+
     virtual ~OSTime() = default;
     virtual bool getCpuTime(uint64_t *timeStamp) = 0;
     virtual bool getCpuGpuTime(TimeStampData *pGpuCpuTime) = 0;
+    bool getCalibratedCpuGpuTime(TimeStampData *pGpuCpuTime);
+    uint64_t getClockCalibrationsCount() const { return clockCalibrationsCount; }
+    const CpuGpuClockModel &peekClockModel() const { return clockModel; }
     virtual double getHostTimerResolution() const = 0;
     virtual double getDynamicDeviceTimerResolution(HardwareInfo const &hwInfo) const = 0;
     virtual uint64_t getCpuRawTimestamp() = 0;
@@ -53,6 +73,13 @@ class OSTime {
 
   protected:
     OSTime() {}
+    bool calibrateClockModel(TimeStampData *pGpuCpuTime, uint64_t maxIntervalNs);
+    uint64_t estimateGpuTime(uint64_t cpuTime) const;
+    static uint64_t getMaxClockCalibrationIntervalNs();
+
     OSInterface *osInterface = nullptr;
+    CpuGpuClockModel clockModel;
+    uint64_t clockCalibrationsCount = 0;
+    std::mutex clockModelMutex;
 };
 } // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -66,5 +66,11 @@ bool OsLibrary::isLoaded() {
 void *OsLibrary::getProcAddress(const std::string &procName) {
     return ::GetProcAddress(this->handle, procName.c_str());
 }
+
+std::string OsLibrary::getFullPath() {
+    char dllPath[MAX_PATH];
+    DWORD length = getModuleFileNameA(this->handle, dllPath, MAX_PATH);
+    return std::string(dllPath, length);
+}
 } // namespace Windows
 } // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -24,6 +24,7 @@ class OsLibrary : public OCLRT::OsLibrary {
 
     bool isLoaded();
     void *getProcAddress(const std::string &procName);
+    std::string getFullPath();
 
   protected:
     HMODULE loadDependency(const std::string &dependencyFileName) const;
@@ -24,6 +24,7 @@
 #include "runtime/event/async_events_handler.h"
 #include "runtime/sharings/sharing_factory.h"
 #include "runtime/platform/extensions.h"
+#include "runtime/utilities/perf_profiler.h"
 #include "runtime/source_level_debugger/source_level_debugger.h"
 #include "CL/cl_ext.h"
 
@@ -53,6 +54,7 @@ Platform::Platform() {
 
 Platform::~Platform() {
     asyncEventsHandler->closeThread();
+    perfTraceCollector.reset();
     for (auto dev : this->devices) {
         if (dev) {
             dev->decRefInternal();
@@ -61,6 +63,7 @@ Platform::~Platform() {
 
     gtpinNotifyPlatformShutdown();
     executionEnvironment->decRefInternal();
+    DebugManager.closeLogWriter();
 }
 
 cl_int Platform::getInfo(cl_platform_info paramName,
@@ -179,6 +182,14 @@ bool Platform::initialize() {
         executionEnvironment->initAubCenter(&hwInfo[0], this->devices[0]->getEnableLocalMemory(), "aubfile");
     }
 
+    if (PerfProfiler::isTracingEnabled()) {
+        auto traceFile = DebugManager.flags.PerfTraceFile.get();
+        if (traceFile == "unk") {
+            traceFile = "PerfTrace.json";
+        }
+        perfTraceCollector.reset(new PerfTraceCollector(traceFile, PerfTraceCollector::defaultDrainIntervalMs));
+    }
+
     this->fillGlobalDispatchTable();
     DEBUG_BREAK_IF(DebugManager.flags.CreateMultipleDevices.get() > 1 && !this->devices[0]->getDefaultEngine().commandStreamReceiver->peekTimestampPacketWriteEnabled());
     state = StateInited;
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -19,6 +19,7 @@ class CompilerInterface;
 class Device;
 class AsyncEventsHandler;
 class ExecutionEnvironment;
+class PerfTraceCollector;
 struct HardwareInfo;
 
 template <>
@@ -54,6 +55,7 @@ class Platform : public BaseObject<_cl_platform_id> {
     AsyncEventsHandler *getAsyncEventsHandler();
     std::unique_ptr<AsyncEventsHandler> setAsyncEventsHandler(std::unique_ptr<AsyncEventsHandler> handler);
     ExecutionEnvironment *peekExecutionEnvironment() { return executionEnvironment; }
+    PerfTraceCollector *peekPerfTraceCollector() const { return perfTraceCollector.get(); }
 
   protected:
     enum {
@@ -68,6 +70,7 @@ class Platform : public BaseObject<_cl_platform_id> {
     DeviceVector devices;
     std::string compilerExtensions;
     std::unique_ptr<AsyncEventsHandler> asyncEventsHandler;
+    std::unique_ptr<PerfTraceCollector> perfTraceCollector;
     ExecutionEnvironment *executionEnvironment = nullptr;
 };
 
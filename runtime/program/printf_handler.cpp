@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -13,6 +13,7 @@
 #include "runtime/helpers/dispatch_info.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/memory_manager/internal_allocation_storage.h"
 #include "runtime/memory_manager/memory_manager.h"
 
 namespace OCLRT {
@@ -20,7 +21,17 @@ namespace OCLRT {
 PrintfHandler::PrintfHandler(Device &deviceArg) : device(deviceArg) {}
 
 PrintfHandler::~PrintfHandler() {
-    device.getMemoryManager()->freeGraphicsMemory(printfSurface);
+    if (printfSurface) {
+        // output is read only after enqueue completes, so surface can be handed out again right away
+        getSurfaceStorage()->storeAllocation(std::unique_ptr<GraphicsAllocation>(printfSurface), REUSABLE_ALLOCATION);
+    }
+    if (kernel) {
+        kernel->decRefInternal();
+    }
+}
+
+InternalAllocationStorage *PrintfHandler::getSurfaceStorage() const {
+    return device.getDefaultEngine().commandStreamReceiver->getInternalAllocationStorage();
 }
 
 PrintfHandler *PrintfHandler::create(const MultiDispatchInfo &multiDispatchInfo, Device &device) {
@@ -37,7 +48,13 @@ void PrintfHandler::prepareDispatch(const MultiDispatchInfo &multiDispatchInfo)
         return;
     }
     kernel = multiDispatchInfo.peekMainKernel();
-    printfSurface = device.getMemoryManager()->allocateGraphicsMemoryWithProperties({printfSurfaceSize, GraphicsAllocation::AllocationType::PRINTF_SURFACE});
+    // output may be printed after enqueue returns, keep kernel with its string table alive until then
+    kernel->incRefInternal();
+    printfSurface = getSurfaceStorage()->obtainReusableAllocation(printfSurfaceSize, false).release();
+    if (!printfSurface) {
+        printfSurface = device.getMemoryManager()->allocateGraphicsMemoryWithProperties({printfSurfaceSize, GraphicsAllocation::AllocationType::PRINTF_SURFACE});
+    }
+    printfSurface->setAllocationType(GraphicsAllocation::AllocationType::PRINTF_SURFACE);
     *reinterpret_cast<uint32_t *>(printfSurface->getUnderlyingBuffer()) = printfSurfaceInitialDataSize;
 
     auto printfPatchAddress = ptrOffset(reinterpret_cast<uintptr_t *>(kernel->getCrossThreadData()),
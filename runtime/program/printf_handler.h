@@ -27,6 +27,7 @@
 
 namespace OCLRT {
 
+class InternalAllocationStorage;
 struct MultiDispatchInfo;
 
 class PrintfHandler {
@@ -45,6 +46,7 @@ class PrintfHandler {
 
   protected:
     PrintfHandler(Device &device);
+    InternalAllocationStorage *getSurfaceStorage() const;
 
     static const uint32_t printfSurfaceInitialDataSize = sizeof(uint32_t);
     Device &device;
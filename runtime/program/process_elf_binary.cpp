@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -21,11 +21,9 @@ cl_int Program::processElfBinary(
 
     binaryVersion = iOpenCL::CURRENT_ICBE_VERSION;
 
-    elfBinarySize = binarySize;
-    elfBinary = CLElfLib::ElfBinaryStorage(reinterpret_cast<const char *>(pBinary), reinterpret_cast<const char *>(reinterpret_cast<const char *>(pBinary) + binarySize));
-
     try {
-        CLElfLib::CElfReader elfReader(elfBinary);
+        // parse in place, the binary is copied only once it is known to be valid
+        CLElfLib::CElfReader elfReader(reinterpret_cast<const char *>(pBinary), binarySize);
 
         pElfHeader = elfReader.getElfHeader();
 
@@ -46,8 +44,8 @@ cl_int Program::processElfBinary(
             return CL_INVALID_BINARY;
         }
         // section 0 is always null
-        for (size_t i = 1u; i < elfReader.getSectionHeaders().size(); ++i) {
-            const auto &sectionHeader = elfReader.getSectionHeaders()[i];
+        for (size_t i = 1u; i < elfReader.getSectionsCount(); ++i) {
+            const auto sectionHeader = elfReader.getSectionHeader(i);
             switch (sectionHeader.Type) {
             case CLElfLib::E_SH_TYPE::SH_TYPE_SPIRV:
                 isSpirV = true;
@@ -83,6 +81,8 @@ cl_int Program::processElfBinary(
             }
         }
 
+        elfBinarySize = binarySize;
+        elfBinary = CLElfLib::ElfBinaryStorage(reinterpret_cast<const char *>(pBinary), reinterpret_cast<const char *>(pBinary) + binarySize);
         isProgramBinaryResolved = true;
 
         // Create an empty build log since program is effectively built
@@ -133,20 +133,18 @@ cl_int Program::resolveProgramBinary() {
         CLElfLib::CElfWriter elfWriter(headerType, CLElfLib::E_EH_MACHINE::EH_MACHINE_NONE, 0);
 
         elfWriter.addSection(CLElfLib::SSectionNode(CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_OPTIONS, CLElfLib::E_SH_FLAG::SH_FLAG_NONE, "BuildOptions", options, static_cast<uint32_t>(strlen(options.c_str()) + 1u)));
-        std::string irBinaryTemp = irBinary ? std::string(irBinary, irBinarySize) : "";
+        // Sections reference program's binaries directly, they are copied only once - into the resolved binary
         // Add the LLVM component if available
-        elfWriter.addSection(CLElfLib::SSectionNode(getIsSpirV() ? CLElfLib::E_SH_TYPE::SH_TYPE_SPIRV : CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_LLVM_BINARY, CLElfLib::E_SH_FLAG::SH_FLAG_NONE,
-                                                    headerType == CLElfLib::E_EH_TYPE::EH_TYPE_OPENCL_LIBRARY ? "Intel(R) OpenCL LLVM Archive" : "Intel(R) OpenCL LLVM Object", std::move(irBinaryTemp), static_cast<uint32_t>(irBinarySize)));
+        elfWriter.addSectionWithDataReference(getIsSpirV() ? CLElfLib::E_SH_TYPE::SH_TYPE_SPIRV : CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_LLVM_BINARY, CLElfLib::E_SH_FLAG::SH_FLAG_NONE,
+                                              headerType == CLElfLib::E_EH_TYPE::EH_TYPE_OPENCL_LIBRARY ? "Intel(R) OpenCL LLVM Archive" : "Intel(R) OpenCL LLVM Object", irBinary, static_cast<uint32_t>(irBinary ? irBinarySize : 0u));
         // Add the device binary if it exists
         if (genBinary) {
-            std::string genBinaryTemp = genBinary ? std::string(genBinary, genBinarySize) : "";
-            elfWriter.addSection(CLElfLib::SSectionNode(CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_DEV_BINARY, CLElfLib::E_SH_FLAG::SH_FLAG_NONE, "Intel(R) OpenCL Device Binary", std::move(genBinaryTemp), static_cast<uint32_t>(genBinarySize)));
+            elfWriter.addSectionWithDataReference(CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_DEV_BINARY, CLElfLib::E_SH_FLAG::SH_FLAG_NONE, "Intel(R) OpenCL Device Binary", genBinary, static_cast<uint32_t>(genBinarySize));
         }
 
         // Add the device debug data if it exists
         if (debugData != nullptr) {
-            std::string debugDataTemp = debugData ? std::string(debugData, debugDataSize) : "";
-            elfWriter.addSection(CLElfLib::SSectionNode(CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_DEV_DEBUG, CLElfLib::E_SH_FLAG::SH_FLAG_NONE, "Intel(R) OpenCL Device Debug", std::move(debugDataTemp), static_cast<uint32_t>(debugDataSize)));
+            elfWriter.addSectionWithDataReference(CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_DEV_DEBUG, CLElfLib::E_SH_FLAG::SH_FLAG_NONE, "Intel(R) OpenCL Device Debug", debugData, static_cast<uint32_t>(debugDataSize));
         }
 
         elfBinarySize = elfWriter.getTotalBinarySize();
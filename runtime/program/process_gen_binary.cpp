@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -18,12 +18,15 @@
 #include "runtime/gtpin/gtpin_notify.h"
 
 #include <algorithm>
+#include <thread>
 
 using namespace iOpenCL;
 
 namespace OCLRT {
 extern bool familyEnabled[];
 
+constexpr size_t Program::minKernelsPerParsingThread;
+
 const KernelInfo *Program::getKernelInfo(
     const char *kernelName) const {
     if (kernelName == nullptr) {
@@ -33,7 +36,11 @@ const KernelInfo *Program::getKernelInfo(
     auto it = std::find_if(kernelInfoArray.begin(), kernelInfoArray.end(),
                            [=](const KernelInfo *kInfo) { return (0 == strcmp(kInfo->name.c_str(), kernelName)); });
 
-    return (it != kernelInfoArray.end()) ? *it : nullptr;
+    if (it == kernelInfoArray.end()) {
+        return nullptr;
+    }
+    createDeferredKernelAllocation(**it);
+    return *it;
 }
 
 size_t Program::getNumKernels() const {
@@ -42,6 +49,9 @@ size_t Program::getNumKernels() const {
 
 const KernelInfo *Program::getKernelInfo(size_t ordinal) const {
     DEBUG_BREAK_IF(ordinal >= kernelInfoArray.size());
+    if (ordinal < kernelInfoArray.size()) {
+        createDeferredKernelAllocation(*kernelInfoArray[ordinal]);
+    }
     return kernelInfoArray[ordinal];
 }
 
@@ -58,83 +68,97 @@ std::string Program::getKernelNamesString() const {
     return semiColonDelimitedKernelNameStr;
 }
 
-size_t Program::processKernel(
-    const void *pKernelBlob,
-    cl_int &retVal) {
-    size_t sizeProcessed = 0;
+KernelInfo *Program::createKernelInfo(const void *pKernelBlob) {
+    auto pKernelInfo = new KernelInfo();
 
-    do {
-        auto pKernelInfo = new KernelInfo();
-        if (!pKernelInfo) {
-            retVal = CL_OUT_OF_HOST_MEMORY;
-            break;
-        }
+    auto pCurKernelPtr = pKernelBlob;
+    pKernelInfo->heapInfo.pBlob = pKernelBlob;
 
-        auto pCurKernelPtr = pKernelBlob;
-        pKernelInfo->heapInfo.pBlob = pKernelBlob;
+    pKernelInfo->heapInfo.pKernelHeader = reinterpret_cast<const SKernelBinaryHeaderCommon *>(pCurKernelPtr);
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, sizeof(SKernelBinaryHeaderCommon));
 
-        pKernelInfo->heapInfo.pKernelHeader = reinterpret_cast<const SKernelBinaryHeaderCommon *>(pCurKernelPtr);
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, sizeof(SKernelBinaryHeaderCommon));
+    pKernelInfo->name.assign(reinterpret_cast<const char *>(pCurKernelPtr), strnlen(reinterpret_cast<const char *>(pCurKernelPtr), pKernelInfo->heapInfo.pKernelHeader->KernelNameSize));
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->KernelNameSize);
 
-        std::string readName{reinterpret_cast<const char *>(pCurKernelPtr), pKernelInfo->heapInfo.pKernelHeader->KernelNameSize};
-        pKernelInfo->name = readName.c_str();
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->KernelNameSize);
+    pKernelInfo->heapInfo.pKernelHeap = pCurKernelPtr;
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->KernelHeapSize);
 
-        pKernelInfo->heapInfo.pKernelHeap = pCurKernelPtr;
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->KernelHeapSize);
+    pKernelInfo->heapInfo.pGsh = pCurKernelPtr;
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->GeneralStateHeapSize);
 
-        pKernelInfo->heapInfo.pGsh = pCurKernelPtr;
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->GeneralStateHeapSize);
+    pKernelInfo->heapInfo.pDsh = pCurKernelPtr;
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->DynamicStateHeapSize);
 
-        pKernelInfo->heapInfo.pDsh = pCurKernelPtr;
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->DynamicStateHeapSize);
+    pKernelInfo->heapInfo.pSsh = const_cast<void *>(pCurKernelPtr);
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->SurfaceStateHeapSize);
 
-        pKernelInfo->heapInfo.pSsh = const_cast<void *>(pCurKernelPtr);
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->SurfaceStateHeapSize);
+    pKernelInfo->heapInfo.pPatchList = pCurKernelPtr;
 
-        pKernelInfo->heapInfo.pPatchList = pCurKernelPtr;
+    auto pKernelHeader = pKernelInfo->heapInfo.pKernelHeader;
+    uint32_t kernelSize =
+        pKernelHeader->DynamicStateHeapSize +
+        pKernelHeader->GeneralStateHeapSize +
+        pKernelHeader->KernelHeapSize +
+        pKernelHeader->KernelNameSize +
+        pKernelHeader->PatchListSize +
+        pKernelHeader->SurfaceStateHeapSize;
 
-        retVal = parsePatchList(*pKernelInfo);
-        if (retVal != CL_SUCCESS) {
-            delete pKernelInfo;
-            sizeProcessed = ptrDiff(pCurKernelPtr, pKernelBlob);
-            break;
-        }
+    pKernelInfo->heapInfo.blobSize = kernelSize + sizeof(SKernelBinaryHeaderCommon);
+
+    return pKernelInfo;
+}
 
-        auto pKernelHeader = pKernelInfo->heapInfo.pKernelHeader;
-        auto pKernel = ptrOffset(pKernelBlob, sizeof(SKernelBinaryHeaderCommon));
+cl_int Program::parseKernelInfo(KernelInfo &kernelInfo) {
+    auto retVal = parsePatchList(kernelInfo);
 
-        if (genBinary)
-            pKernelInfo->gpuPointerSize = reinterpret_cast<const SProgramBinaryHeader *>(genBinary)->GPUPointerSizeInBytes;
+    if (genBinary)
+        kernelInfo.gpuPointerSize = reinterpret_cast<const SProgramBinaryHeader *>(genBinary)->GPUPointerSizeInBytes;
 
-        uint32_t kernelSize =
-            pKernelHeader->DynamicStateHeapSize +
-            pKernelHeader->GeneralStateHeapSize +
-            pKernelHeader->KernelHeapSize +
-            pKernelHeader->KernelNameSize +
-            pKernelHeader->PatchListSize +
-            pKernelHeader->SurfaceStateHeapSize;
+    auto pKernel = ptrOffset(kernelInfo.heapInfo.pBlob, sizeof(SKernelBinaryHeaderCommon));
+    auto kernelSize = kernelInfo.heapInfo.blobSize - sizeof(SKernelBinaryHeaderCommon);
+    uint32_t kernelCheckSum = kernelInfo.heapInfo.pKernelHeader->CheckSum;
 
-        pKernelInfo->heapInfo.blobSize = kernelSize + sizeof(SKernelBinaryHeaderCommon);
+    uint64_t hashValue = Hash::hash(reinterpret_cast<const char *>(pKernel), kernelSize);
 
-        uint32_t kernelCheckSum = pKernelInfo->heapInfo.pKernelHeader->CheckSum;
+    uint32_t calcCheckSum = hashValue & 0xFFFFFFFF;
+    kernelInfo.isValid = (calcCheckSum == kernelCheckSum);
 
-        uint64_t hashValue = Hash::hash(reinterpret_cast<const char *>(pKernel), kernelSize);
+    return retVal;
+}
 
-        uint32_t calcCheckSum = hashValue & 0xFFFFFFFF;
-        pKernelInfo->isValid = (calcCheckSum == kernelCheckSum);
+cl_int Program::registerKernelInfo(KernelInfo *pKernelInfo, cl_int parseRetVal) {
+    auto retVal = parseRetVal;
+    if (retVal == CL_SUCCESS && pKernelInfo->heapInfo.pKernelHeader->KernelHeapSize && this->pDevice && !deferKernelAllocations) {
+        retVal = pKernelInfo->createKernelAllocation(this->pDevice->getMemoryManager()) ? CL_SUCCESS : CL_OUT_OF_HOST_MEMORY;
+    }
+    DEBUG_BREAK_IF(pKernelInfo->heapInfo.pKernelHeader->KernelHeapSize && !this->pDevice);
 
-        retVal = CL_SUCCESS;
-        sizeProcessed = sizeof(SKernelBinaryHeaderCommon) + kernelSize;
-        kernelInfoArray.push_back(pKernelInfo);
-        if (pKernelInfo->hasDeviceEnqueue()) {
-            parentKernelInfoArray.push_back(pKernelInfo);
-        }
-        if (pKernelInfo->requiresSubgroupIndependentForwardProgress()) {
-            subgroupKernelInfoArray.push_back(pKernelInfo);
-        }
-    } while (false);
+    if (retVal != CL_SUCCESS) {
+        delete pKernelInfo;
+        return retVal;
+    }
+
+    kernelInfoArray.push_back(pKernelInfo);
+    if (pKernelInfo->hasDeviceEnqueue()) {
+        parentKernelInfoArray.push_back(pKernelInfo);
+    }
+    if (pKernelInfo->requiresSubgroupIndependentForwardProgress()) {
+        subgroupKernelInfoArray.push_back(pKernelInfo);
+    }
+    return CL_SUCCESS;
+}
+
+size_t Program::processKernel(
+    const void *pKernelBlob,
+    cl_int &retVal) {
+    auto pKernelInfo = createKernelInfo(pKernelBlob);
+    size_t sizeProcessed = pKernelInfo->heapInfo.blobSize;
+    size_t patchListOffset = ptrDiff(pKernelInfo->heapInfo.pPatchList, pKernelBlob);
 
+    retVal = registerKernelInfo(pKernelInfo, parseKernelInfo(*pKernelInfo));
+    if (retVal != CL_SUCCESS) {
+        sizeProcessed = patchListOffset;
+    }
     return sizeProcessed;
 }
 
@@ -825,12 +849,6 @@ cl_int Program::parsePatchList(KernelInfo &kernelInfo) {
         }
     }
 
-    if (kernelInfo.heapInfo.pKernelHeader->KernelHeapSize && this->pDevice) {
-        retVal = kernelInfo.createKernelAllocation(this->pDevice->getMemoryManager()) ? CL_SUCCESS : CL_OUT_OF_HOST_MEMORY;
-    }
-
-    DEBUG_BREAK_IF(kernelInfo.heapInfo.pKernelHeader->KernelHeapSize && !this->pDevice);
-
     return retVal;
 }
 
@@ -960,6 +978,7 @@ cl_int Program::processGenBinary() {
     cl_int retVal = CL_SUCCESS;
 
     cleanCurrentKernelInfo();
+    deferKernelAllocations = DebugManager.flags.EnableLazyKernelIsaAllocation.get();
 
     do {
         if (!genBinary || genBinarySize == 0) {
@@ -984,17 +1003,87 @@ cl_int Program::processGenBinary() {
 
         pCurBinaryPtr = ptrOffset(pCurBinaryPtr, pGenBinaryHeader->PatchListSize);
 
+        if (retVal != CL_SUCCESS) {
+            break;
+        }
+
+        // Kernels reference heaps in the binary, only the walk over headers has to be sequential
         auto numKernels = pGenBinaryHeader->NumberOfKernels;
-        for (uint32_t i = 0; i < numKernels && retVal == CL_SUCCESS; i++) {
+        std::vector<KernelInfo *> kernelInfos;
+        kernelInfos.reserve(numKernels);
+        for (uint32_t i = 0; i < numKernels; i++) {
+            auto pKernelInfo = createKernelInfo(pCurBinaryPtr);
+            kernelInfos.push_back(pKernelInfo);
+            pCurBinaryPtr = ptrOffset(pCurBinaryPtr, pKernelInfo->heapInfo.blobSize);
+        }
+
+        std::vector<cl_int> parseResults(numKernels, CL_SUCCESS);
+        parseKernelInfos(kernelInfos, parseResults);
 
-            size_t bytesProcessed = processKernel(pCurBinaryPtr, retVal);
-            pCurBinaryPtr = ptrOffset(pCurBinaryPtr, bytesProcessed);
+        for (uint32_t i = 0; i < numKernels; i++) {
+            if (retVal == CL_SUCCESS) {
+                retVal = registerKernelInfo(kernelInfos[i], parseResults[i]);
+            } else {
+                delete kernelInfos[i];
+            }
         }
     } while (false);
 
     return retVal;
 }
 
+uint32_t Program::getKernelParsingThreadsCount(size_t numKernels) {
+    if (!DebugManager.flags.EnableParallelKernelParsing.get() || DebugManager.flags.LogPatchTokens.get()) {
+        return 1;
+    }
+    size_t threadsCount = std::max(std::thread::hardware_concurrency(), 1u);
+    threadsCount = std::min(threadsCount, numKernels / minKernelsPerParsingThread);
+    return static_cast<uint32_t>(std::max(threadsCount, size_t{1}));
+}
+
+void Program::parseKernelInfos(std::vector<KernelInfo *> &kernelInfos, std::vector<cl_int> &parseResults) {
+    auto numKernels = kernelInfos.size();
+    auto threadsCount = getKernelParsingThreadsCount(numKernels);
+    if (threadsCount == 1) {
+        for (size_t i = 0; i < numKernels; i++) {
+            parseResults[i] = parseKernelInfo(*kernelInfos[i]);
+        }
+        return;
+    }
+
+    if (this->pDevice) {
+        // SLM window is created lazily, make sure workers only read it
+        this->pDevice->getSLMWindowStartAddress();
+    }
+
+    auto parseRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            parseResults[i] = parseKernelInfo(*kernelInfos[i]);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    auto kernelsPerThread = (numKernels + threadsCount - 1) / threadsCount;
+    for (size_t begin = kernelsPerThread; begin < numKernels; begin += kernelsPerThread) {
+        workers.emplace_back(parseRange, begin, std::min(begin + kernelsPerThread, numKernels));
+    }
+    parseRange(0, kernelsPerThread);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+bool Program::createDeferredKernelAllocation(KernelInfo &kernelInfo) const {
+    if (!deferKernelAllocations || this->pDevice == nullptr) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(kernelAllocationMutex);
+    if (kernelInfo.kernelAllocation == nullptr && kernelInfo.heapInfo.pKernelHeader->KernelHeapSize) {
+        return kernelInfo.createKernelAllocation(this->pDevice->getMemoryManager());
+    }
+    return true;
+}
+
 bool Program::validateGenBinaryDevice(GFXCORE_FAMILY device) const {
     bool isValid = familyEnabled[device];
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -351,6 +351,7 @@ void Program::separateBlockKernels() {
             }
             if (baseKernelFound) {
                 //Parent or subgroup kernel found -> child kernel
+                createDeferredKernelAllocation(*i);
                 blockKernelManager->addBlockKernelInfo(i);
             } else {
                 kernelInfoArray.push_back(i);
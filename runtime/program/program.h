@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -20,6 +20,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <mutex>
 
 #define OCLRT_ALIGN(a, b) ((((a) % (b)) != 0) ? ((a) - ((a) % (b)) + (b)) : (a))
 
@@ -193,6 +194,7 @@ class Program : public BaseObject<_cl_program> {
         return blockKernelManager;
     }
 
+    bool createDeferredKernelAllocation(KernelInfo &kernelInfo) const;
     void allocateBlockPrivateSurfaces();
     void freeBlockResources();
     void cleanCurrentKernelInfo();
@@ -253,6 +255,14 @@ class Program : public BaseObject<_cl_program> {
 
     size_t processKernel(const void *pKernelBlob, cl_int &retVal);
 
+    KernelInfo *createKernelInfo(const void *pKernelBlob);
+    cl_int parseKernelInfo(KernelInfo &kernelInfo);
+    void parseKernelInfos(std::vector<KernelInfo *> &kernelInfos, std::vector<cl_int> &parseResults);
+    cl_int registerKernelInfo(KernelInfo *pKernelInfo, cl_int parseRetVal);
+    static uint32_t getKernelParsingThreadsCount(size_t numKernels);
+
+    static constexpr size_t minKernelsPerParsingThread = 8;
+
     void storeBinary(char *&pDst, size_t &dstSize, const void *pSrc, const size_t srcSize);
 
     bool validateGenBinaryDevice(GFXCORE_FAMILY device) const;
@@ -323,6 +333,9 @@ class Program : public BaseObject<_cl_program> {
 
     bool                      isBuiltIn;
     bool                      kernelDebugEnabled = false;
+    // kernel ISA is copied to graphics memory on first request for given kernel
+    bool                      deferKernelAllocations = false;
+    mutable std::mutex        kernelAllocationMutex;
     friend class OfflineCompiler;
     // clang-format on
 };
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/utilities/async_log_writer.h"
+#include "runtime/os_interface/os_thread.h"
+
+namespace OCLRT {
+
+constexpr size_t AsyncLogWriter::maxPendingSize;
+
+AsyncLogWriter::AsyncLogWriter(const std::string &fileName) : fileName(fileName) {
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    closeThread();
+}
+
+void AsyncLogWriter::write(const std::string &str) {
+    std::unique_lock<std::mutex> lock(mtx);
+    if (threadClosed) {
+        writeToSink(str.c_str(), str.size());
+        return;
+    }
+    //Create on first use
+    openThread();
+
+    drainedCond.wait(lock, [this] { return pending.size() < maxPendingSize; });
+    pending.append(str);
+    pendingCond.notify_one();
+}
+
+void AsyncLogWriter::flush() {
+    std::unique_lock<std::mutex> lock(mtx);
+    drainedCond.wait(lock, [this] { return pending.empty() && !writeInProgress; });
+}
+
+void *AsyncLogWriter::asyncWrite(void *arg) {
+    auto self = reinterpret_cast<AsyncLogWriter *>(arg);
+    std::unique_lock<std::mutex> lock(self->mtx);
+
+    while (true) {
+        self->pendingCond.wait(lock, [self] { return !self->pending.empty() || !self->allowAsyncWrite; });
+        if (self->pending.empty()) {
+            break;
+        }
+        self->inFlight.swap(self->pending);
+        self->writeInProgress = true;
+        lock.unlock();
+
+        self->writeToSink(self->inFlight.c_str(), self->inFlight.size());
+        self->inFlight.clear();
+
+        lock.lock();
+        self->writeInProgress = false;
+        self->drainedCond.notify_all();
+    }
+    return nullptr;
+}
+
+void AsyncLogWriter::closeThread() {
+    std::unique_lock<std::mutex> lock(mtx);
+    threadClosed = true;
+    if (allowAsyncWrite) {
+        allowAsyncWrite = false;
+        pendingCond.notify_one();
+        lock.unlock();
+        thread->join();
+        thread.reset(nullptr);
+    }
+}
+
+void AsyncLogWriter::setFileName(const std::string &newFileName) {
+    std::unique_lock<std::mutex> lock(mtx);
+    drainedCond.wait(lock, [this] { return pending.empty() && !writeInProgress; });
+    if (logFile.is_open()) {
+        logFile.close();
+    }
+    fileName = newFileName;
+}
+
+void AsyncLogWriter::openThread() {
+    if (!thread) {
+        allowAsyncWrite = true;
+        thread = Thread::create(asyncWrite, reinterpret_cast<void *>(this));
+    }
+}
+
+void AsyncLogWriter::writeToSink(const char *str, size_t length) {
+    if (!logFile.is_open()) {
+        logFile.open(fileName, std::ios::app);
+    }
+    if (logFile.is_open()) {
+        logFile.write(str, length);
+        logFile.flush();
+    }
+}
+} // namespace OCLRT
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace OCLRT {
+class Thread;
+
+// Log lines are appended to a pending buffer and written out in batches by a background
+// thread keeping the log file open. Producers block only when the pending buffer is full.
+// Once the thread is closed, remaining lines are written synchronously by the caller.
+class AsyncLogWriter {
+  public:
+    static constexpr size_t maxPendingSize = 1024 * 1024;
+
+    AsyncLogWriter(const std::string &fileName);
+    virtual ~AsyncLogWriter();
+
+    void write(const std::string &str);
+    void flush();
+    void closeThread();
+    void setFileName(const std::string &newFileName);
+
+  protected:
+    static void *asyncWrite(void *arg);
+    MOCKABLE_VIRTUAL void openThread();
+    MOCKABLE_VIRTUAL void writeToSink(const char *str, size_t length);
+
+    std::string fileName;
+    std::ofstream logFile;
+    std::string pending;
+    std::string inFlight;
+    bool writeInProgress = false;
+    bool allowAsyncWrite = false;
+    bool threadClosed = false;
+
+    std::unique_ptr<Thread> thread;
+    std::mutex mtx;
+    std::condition_variable pendingCond;
+    std::condition_variable drainedCond;
+};
+} // namespace OCLRT
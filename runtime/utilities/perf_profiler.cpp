@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -7,9 +7,13 @@
 
 #include "os_inc.h"
 #include "runtime/utilities/perf_profiler.h"
+#include "runtime/helpers/basic_math.h"
+#include "runtime/os_interface/os_thread.h"
 #include <runtime/utilities/stackvec.h>
+#include <algorithm>
 #include <atomic>
 #include <cstring>
+#include <iomanip>
 #include <sstream>
 #include <thread>
 
@@ -173,4 +177,198 @@ void PerfProfiler::logTimes(long long start, long long end, long long span, unsi
 void PerfProfiler::logSysTimes(long long start, unsigned long long time, unsigned int id) {
     systemLogs.emplace_back(SystemLog{id, start, time});
 }
+
+const size_t PerfTraceCollector::maxCollectedEvents;
+
+PerfTraceBuffer::PerfTraceBuffer(uint32_t threadId, size_t capacity) : threadId(threadId) {
+    auto alignedCapacity = Math::nextPowerOfTwo(static_cast<uint32_t>(std::max(capacity, size_t(2))));
+    events.reset(new PerfTraceEvent[alignedCapacity]);
+    capacityMask = alignedCapacity - 1;
+}
+
+size_t PerfTraceBuffer::drain(std::vector<PerfTraceEvent> &output) {
+    auto read = readIndex.load(std::memory_order_relaxed);
+    auto write = writeIndex.load(std::memory_order_acquire);
+    for (auto i = read; i < write; i++) {
+        output.push_back(events[i & capacityMask]);
+    }
+    readIndex.store(write, std::memory_order_release);
+    return static_cast<size_t>(write - read);
+}
+
+namespace {
+struct PerfTraceRegistry {
+    std::mutex mtx;
+    std::vector<std::unique_ptr<PerfTraceBuffer>> buffers;
+    uint32_t nextThreadId = 0;
+};
+
+PerfTraceRegistry &getPerfTraceRegistry() {
+    static PerfTraceRegistry registry;
+    return registry;
+}
+
+struct PerfTraceBufferHolder {
+    ~PerfTraceBufferHolder() {
+        if (buffer) {
+            PerfProfiler::releaseTraceBuffer(buffer);
+        }
+    }
+    PerfTraceBuffer *buffer = nullptr;
+};
+
+thread_local PerfTraceBufferHolder perfTraceBufferHolder;
+} // namespace
+
+PerfTraceBuffer *PerfProfiler::getTraceBuffer() {
+    auto &holder = perfTraceBufferHolder;
+    if (holder.buffer) {
+        return holder.buffer;
+    }
+    auto capacity = DebugManager.flags.PerfTraceBufferSize.get();
+    if (capacity <= 0) {
+        return nullptr;
+    }
+
+    auto &registry = getPerfTraceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    auto threadId = registry.nextThreadId++;
+    for (auto &buffer : registry.buffers) {
+        // buffers of exited threads are reused only when collector already consumed their events
+        if (!buffer->inUse.load(std::memory_order_acquire) && buffer->isEmpty()) {
+            buffer->inUse.store(true, std::memory_order_relaxed);
+            buffer->setThreadId(threadId);
+            holder.buffer = buffer.get();
+            return holder.buffer;
+        }
+    }
+    registry.buffers.emplace_back(new PerfTraceBuffer(threadId, static_cast<size_t>(capacity)));
+    holder.buffer = registry.buffers.back().get();
+    return holder.buffer;
+}
+
+void PerfProfiler::releaseTraceBuffer(PerfTraceBuffer *buffer) {
+    buffer->inUse.store(false, std::memory_order_release);
+}
+
+size_t PerfProfiler::drainTraceEvents(std::vector<PerfTraceEvent> &output) {
+    auto &registry = getPerfTraceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    size_t drained = 0;
+    for (auto &buffer : registry.buffers) {
+        drained += buffer->drain(output);
+    }
+    return drained;
+}
+
+uint64_t PerfProfiler::getDroppedTraceEventsCount() {
+    auto &registry = getPerfTraceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    uint64_t dropped = 0;
+    for (auto &buffer : registry.buffers) {
+        dropped += buffer->getDroppedCount();
+    }
+    return dropped;
+}
+
+const char *PerfProfiler::getTraceCategoryName(PerfTraceCategory category) {
+    switch (category) {
+    case PerfTraceCategory::Enqueue:
+        return "enqueue";
+    case PerfTraceCategory::FlushTask:
+        return "flushTask";
+    case PerfTraceCategory::Submission:
+        return "submission";
+    case PerfTraceCategory::Wait:
+        return "wait";
+    default:
+        return "unknown";
+    }
+}
+
+void PerfProfiler::writeChromeTrace(std::ostream &out, const std::vector<PerfTraceEvent> &events) {
+    out << "{\"traceEvents\":[";
+    auto flags = out.flags();
+    out << std::fixed << std::setprecision(3);
+    bool first = true;
+    for (auto &event : events) {
+        if (!first) {
+            out << ",";
+        }
+        first = false;
+        out << "\n{\"name\":\"" << event.name << "\",\"cat\":\"" << getTraceCategoryName(event.category)
+            << "\",\"ph\":\"X\",\"ts\":" << static_cast<double>(event.start) / 1000.0
+            << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0
+            << ",\"pid\":0,\"tid\":" << event.threadId << "}";
+    }
+    out.flags(flags);
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+PerfTraceCollector::PerfTraceCollector(const std::string &fileName, uint32_t drainIntervalMs) : fileName(fileName), drainIntervalMs(drainIntervalMs) {
+    worker = Thread::create(run, reinterpret_cast<void *>(this));
+}
+
+PerfTraceCollector::~PerfTraceCollector() {
+    stop();
+    drain();
+    exportChromeTrace();
+}
+
+void *PerfTraceCollector::run(void *arg) {
+    auto self = reinterpret_cast<PerfTraceCollector *>(arg);
+    std::unique_lock<std::mutex> lock(self->workerMutex);
+    while (!self->stopRequested) {
+        self->workerCondition.wait_for(lock, std::chrono::milliseconds(self->drainIntervalMs));
+        lock.unlock();
+        self->drain();
+        lock.lock();
+    }
+    return nullptr;
+}
+
+void PerfTraceCollector::stop() {
+    std::unique_lock<std::mutex> lock(workerMutex);
+    if (worker) {
+        stopRequested = true;
+        workerCondition.notify_one();
+        lock.unlock();
+        worker->join();
+        worker.reset();
+    }
+}
+
+void PerfTraceCollector::drain() {
+    std::vector<PerfTraceEvent> events;
+    PerfProfiler::drainTraceEvents(events);
+
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    auto freeSlots = maxCollectedEvents - std::min(collectedEvents.size(), maxCollectedEvents);
+    auto accepted = std::min(events.size(), freeSlots);
+    collectedEvents.insert(collectedEvents.end(), events.begin(), events.begin() + accepted);
+    droppedCount += events.size() - accepted;
+}
+
+bool PerfTraceCollector::exportChromeTrace() {
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    std::ofstream traceFile(fileName, std::ios::out | std::ios::trunc);
+    if (!traceFile.is_open()) {
+        return false;
+    }
+    std::sort(collectedEvents.begin(), collectedEvents.end(), [](const PerfTraceEvent &left, const PerfTraceEvent &right) {
+        return left.start < right.start;
+    });
+    PerfProfiler::writeChromeTrace(traceFile, collectedEvents);
+    return traceFile.good();
+}
+
+size_t PerfTraceCollector::getEventsCount() {
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    return collectedEvents.size();
+}
+
+uint64_t PerfTraceCollector::getDroppedCount() {
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    return droppedCount + PerfProfiler::getDroppedTraceEventsCount();
+}
 } // namespace OCLRT
@@ -22,14 +22,113 @@
 
 #pragma once
 #include "runtime/helpers/options.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/utilities/timer_util.h"
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <string>
 #include <vector>
 
 namespace OCLRT {
+class Thread;
+
+enum class PerfTraceCategory : uint32_t {
+    Enqueue = 0,
+    FlushTask,
+    Submission,
+    Wait,
+    Count
+};
+
+struct PerfTraceEvent {
+    const char *name;
+    uint64_t start;
+    uint64_t duration;
+    PerfTraceCategory category;
+    uint32_t threadId;
+};
+
+// Ring of trace events written only by owning thread and read only by trace collector,
+// so single producer / single consumer indices are enough to keep it lock free.
+// Events that do not fit before collector catches up are dropped and counted.
+class PerfTraceBuffer {
+  public:
+    PerfTraceBuffer(uint32_t threadId, size_t capacity);
+
+    bool push(const char *name, PerfTraceCategory category, uint64_t start, uint64_t end) {
+        auto write = writeIndex.load(std::memory_order_relaxed);
+        if (write - readIndex.load(std::memory_order_acquire) > capacityMask) {
+            droppedCount.store(droppedCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        auto &event = events[write & capacityMask];
+        event.name = name;
+        event.start = start;
+        event.duration = end - start;
+        event.category = category;
+        event.threadId = threadId;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t drain(std::vector<PerfTraceEvent> &output);
+
+    bool isEmpty() const { return writeIndex.load(std::memory_order_acquire) == readIndex.load(std::memory_order_acquire); }
+    size_t getCapacity() const { return capacityMask + 1; }
+    uint64_t getDroppedCount() const { return droppedCount.load(std::memory_order_relaxed); }
+    uint32_t getThreadId() const { return threadId; }
+    void setThreadId(uint32_t newThreadId) { threadId = newThreadId; }
+
+    std::atomic<bool> inUse{true};
+
+  protected:
+    std::unique_ptr<PerfTraceEvent[]> events;
+    size_t capacityMask = 0;
+    uint32_t threadId = 0;
+    std::atomic<uint64_t> droppedCount{0};
+    std::atomic<uint64_t> writeIndex{0};
+    // keep producer and consumer indices in separate cache lines
+    char padding[64];
+    std::atomic<uint64_t> readIndex{0};
+};
+
+// Periodically moves events out of per thread buffers, so tracing threads never block on output,
+// and writes everything collected in Chrome trace event format when destroyed.
+class PerfTraceCollector {
+  public:
+    PerfTraceCollector(const std::string &fileName, uint32_t drainIntervalMs);
+    ~PerfTraceCollector();
+
+    void drain();
+    void stop();
+    bool exportChromeTrace();
+    size_t getEventsCount();
+    uint64_t getDroppedCount();
+
+    static const size_t maxCollectedEvents = 1024 * 1024;
+    static const uint32_t defaultDrainIntervalMs = 10;
+
+  protected:
+    static void *run(void *arg);
+
+    std::string fileName;
+    uint32_t drainIntervalMs;
+    std::vector<PerfTraceEvent> collectedEvents;
+    uint64_t droppedCount = 0;
+    std::mutex eventsMutex;
+
+    std::unique_ptr<Thread> worker;
+    std::mutex workerMutex;
+    std::condition_variable workerCondition;
+    bool stopRequested = false;
+};
+
 class PerfProfiler {
 
     struct SystemLog {
@@ -101,6 +200,28 @@ class PerfProfiler {
 
     static const unsigned int objectsNumber = 4096;
 
+    static bool isTracingEnabled() {
+        return DebugManager.flags.PerfTraceBufferSize.get() > 0;
+    }
+
+    static uint64_t getTraceTimestamp() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static void traceEvent(const char *name, PerfTraceCategory category, uint64_t start, uint64_t end) {
+        auto buffer = getTraceBuffer();
+        if (buffer) {
+            buffer->push(name, category, start, end);
+        }
+    }
+
+    static PerfTraceBuffer *getTraceBuffer();
+    static void releaseTraceBuffer(PerfTraceBuffer *buffer);
+    static size_t drainTraceEvents(std::vector<PerfTraceEvent> &output);
+    static uint64_t getDroppedTraceEventsCount();
+    static void writeChromeTrace(std::ostream &out, const std::vector<PerfTraceEvent> &events);
+    static const char *getTraceCategoryName(PerfTraceCategory category);
+
   protected:
     static std::atomic<int> counter;
     static PerfProfiler *objects[PerfProfiler::objectsNumber];
@@ -112,6 +233,29 @@ class PerfProfiler {
     std::vector<SystemLog> systemLogs;
 };
 
+struct PerfTraceScope {
+    PerfTraceScope(const char *name, PerfTraceCategory category) {
+        if (PerfProfiler::isTracingEnabled()) {
+            this->name = name;
+            this->category = category;
+            this->start = PerfProfiler::getTraceTimestamp();
+        }
+    }
+
+    ~PerfTraceScope() {
+        if (name) {
+            PerfProfiler::traceEvent(name, category, start, PerfProfiler::getTraceTimestamp());
+        }
+    }
+
+    const char *name = nullptr;
+    PerfTraceCategory category = PerfTraceCategory::Enqueue;
+    uint64_t start = 0;
+};
+
+#define PERF_TRACE_SCOPE(name, category) \
+    PerfTraceScope perfTraceScopeForSingleCall(name, PerfTraceCategory::category)
+
 #if OCL_RUNTIME_PROFILING == 1
 struct PerfProfilerApiWrapper {
     PerfProfilerApiWrapper(const char *funcName)
@@ -542,10 +542,97 @@ HWTEST_P(EnqueueKernelPrintfTest, GivenKernelWithPrintfWhenBeingDispatchedThenL3
     mockKernel.kernelInfo.patchInfo.pAllocateStatelessPrintfSurface = &patchData;
     auto &csr = pCmdQ->getCommandStreamReceiver();
     auto latestSentTaskCount = csr.peekTaskCount();
+    auto latestTaskCountWaited = pCmdQ->latestTaskCountWaited.load();
     enqueueKernel<FamilyType, false>(mockKernel);
     auto newLatestSentTaskCount = csr.peekTaskCount();
     EXPECT_GT(newLatestSentTaskCount, latestSentTaskCount);
-    EXPECT_EQ(pCmdQ->latestTaskCountWaited, newLatestSentTaskCount);
+    EXPECT_EQ(latestTaskCountWaited, pCmdQ->latestTaskCountWaited);
+}
+
+HWTEST_P(EnqueueKernelPrintfTest, GivenKernelWithPrintfWhenEnqueuedNonBlockingThenOutputIsPrintedInOrderOnceTaskCountCompletes) {
+    // In scenarios with 32bit allocator and 64 bit tests this code won't work
+    // due to inability to retrieve original buffer pointer as it is done in this test.
+    if (pDevice->getMemoryManager()->peekForce32BitAllocations()) {
+        return;
+    }
+
+    SPatchAllocateStatelessPrintfSurface patchData;
+    patchData.Size = 256;
+    patchData.DataParamSize = 8;
+    patchData.DataParamOffset = 0;
+
+    MockKernelWithInternals mockKernel(*pDevice);
+    mockKernel.kernelInfo.patchInfo.pAllocateStatelessPrintfSurface = &patchData;
+
+    char firstString[] = "first";
+    char secondString[] = "second";
+    PrintfStringInfo printfStringInfo;
+    printfStringInfo.SizeInBytes = sizeof(firstString);
+    printfStringInfo.pStringData = firstString;
+    mockKernel.kernelInfo.patchInfo.stringDataMap.insert(std::make_pair(0, printfStringInfo));
+    printfStringInfo.SizeInBytes = sizeof(secondString);
+    printfStringInfo.pStringData = secondString;
+    mockKernel.kernelInfo.patchInfo.stringDataMap.insert(std::make_pair(1, printfStringInfo));
+
+    auto crossThreadData = reinterpret_cast<uint64_t *>(mockKernel.mockKernel->getCrossThreadData());
+    auto &csr = pCmdQ->getCommandStreamReceiver();
+    auto tagAddress = csr.getTagAddress();
+    auto initialTag = *tagAddress;
+    *tagAddress = csr.peekTaskCount();
+    auto latestTaskCountWaited = pCmdQ->latestTaskCountWaited.load();
+
+    testing::internal::CaptureStdout();
+    enqueueKernel<FamilyType, false>(mockKernel);
+    auto firstTaskCount = csr.peekTaskCount();
+    auto firstPrintfAllocation = reinterpret_cast<uint32_t *>(*crossThreadData);
+    firstPrintfAllocation[0] = 8;
+    firstPrintfAllocation[1] = 0;
+
+    enqueueKernel<FamilyType, false>(mockKernel);
+    auto secondPrintfAllocation = reinterpret_cast<uint32_t *>(*crossThreadData);
+    EXPECT_NE(firstPrintfAllocation, secondPrintfAllocation);
+    secondPrintfAllocation[0] = 8;
+    secondPrintfAllocation[1] = 1;
+
+    EXPECT_EQ(latestTaskCountWaited, pCmdQ->latestTaskCountWaited);
+    EXPECT_EQ(2u, pCmdQ->getPendingPrintfOutputsCount());
+    EXPECT_STREQ("", testing::internal::GetCapturedStdout().c_str());
+
+    testing::internal::CaptureStdout();
+    *tagAddress = firstTaskCount;
+    pCmdQ->printCompletedPrintfOutput();
+    EXPECT_EQ(1u, pCmdQ->getPendingPrintfOutputsCount());
+    EXPECT_STREQ("first", testing::internal::GetCapturedStdout().c_str());
+
+    testing::internal::CaptureStdout();
+    *tagAddress = csr.peekTaskCount();
+    pCmdQ->finish(false);
+    EXPECT_EQ(0u, pCmdQ->getPendingPrintfOutputsCount());
+    EXPECT_STREQ("second", testing::internal::GetCapturedStdout().c_str());
+
+    *tagAddress = initialTag;
+}
+
+HWTEST_P(EnqueueKernelPrintfTest, GivenPrintfOutputOfCompletedEnqueueWhenKernelWithPrintfIsEnqueuedAgainThenPrintfSurfaceIsReused) {
+    if (pDevice->getMemoryManager()->peekForce32BitAllocations()) {
+        return;
+    }
+
+    SPatchAllocateStatelessPrintfSurface patchData;
+    patchData.Size = 256;
+    patchData.DataParamSize = 8;
+    patchData.DataParamOffset = 0;
+
+    MockKernelWithInternals mockKernel(*pDevice);
+    mockKernel.kernelInfo.patchInfo.pAllocateStatelessPrintfSurface = &patchData;
+    auto crossThreadData = reinterpret_cast<uint64_t *>(mockKernel.mockKernel->getCrossThreadData());
+
+    enqueueKernel<FamilyType, false>(mockKernel);
+    EXPECT_EQ(0u, pCmdQ->getPendingPrintfOutputsCount());
+    auto firstPrintfSurface = *crossThreadData;
+
+    enqueueKernel<FamilyType, false>(mockKernel);
+    EXPECT_EQ(firstPrintfSurface, *crossThreadData);
 }
 
 HWCMDTEST_P(IGFX_GEN8_CORE, EnqueueKernelPrintfTest, GivenKernelWithPrintfBlockedByEventWhenEventUnblockedThenL3CacheIsFlushed) {
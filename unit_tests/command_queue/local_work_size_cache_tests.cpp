@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/command_queue/gpgpu_walker.h"
+#include "runtime/command_queue/local_work_size_cache.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_device.h"
+#include "unit_tests/mocks/mock_kernel.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+
+using namespace OCLRT;
+
+struct LocalWorkSizeCacheTest : public ::testing::Test {
+    void SetUp() override {
+        device.reset(MockDevice::createWithNewExecutionEnvironment<MockDevice>(platformDevices[0]));
+        kernel.reset(new MockKernelWithInternals(*device));
+        kernel->executionEnvironment.CompiledSIMD16 = 1;
+    }
+
+    DispatchInfo createDispatchInfo(size_t x, size_t y, size_t z, uint32_t dim) {
+        return DispatchInfo(kernel->mockKernel, dim, Vec3<size_t>(x, y, z), Vec3<size_t>(0, 0, 0), Vec3<size_t>(0, 0, 0));
+    }
+
+    LocalWorkSizeCache &getCache() {
+        return kernel->mockKernel->getLocalWorkSizeCache();
+    }
+
+    std::unique_ptr<MockDevice> device;
+    std::unique_ptr<MockKernelWithInternals> kernel;
+};
+
+TEST(LocalWorkSizeCacheKeyTest, givenDispatchesWithDifferentShapesWhenKeysAreComparedThenTheyDiffer) {
+    LocalWorkSizeCacheKey key;
+    LocalWorkSizeCacheKey otherKey;
+    EXPECT_FALSE(key < otherKey);
+    EXPECT_FALSE(otherKey < key);
+
+    otherKey.gws[1] = 2;
+    EXPECT_TRUE(key < otherKey);
+
+    otherKey = key;
+    otherKey.slmTotalSize = 1024;
+    EXPECT_TRUE(key < otherKey);
+
+    otherKey = key;
+    otherKey.computeSizeSquared = true;
+    EXPECT_TRUE(key < otherKey);
+}
+
+TEST(LocalWorkSizeCacheStandaloneTest, givenEmptyCacheWhenSizeIsStoredThenNextLookupHits) {
+    LocalWorkSizeCache cache;
+    LocalWorkSizeCacheKey key;
+    key.gws[0] = 1024;
+    key.dim = 1;
+    Vec3<size_t> lws = {0, 0, 0};
+
+    EXPECT_FALSE(cache.getLocalWorkSize(key, lws));
+    EXPECT_EQ(1u, cache.getMissCount());
+
+    cache.storeLocalWorkSize(key, {256, 1, 1}, 1000);
+    EXPECT_TRUE(cache.getLocalWorkSize(key, lws));
+    EXPECT_EQ(Vec3<size_t>(256, 1, 1), lws);
+    EXPECT_EQ(1u, cache.getHitCount());
+    EXPECT_EQ(1000u, cache.getHeuristicTimeNs());
+    EXPECT_EQ(1u, cache.getEntriesCount());
+}
+
+TEST(LocalWorkSizeCacheStandaloneTest, givenFullCacheWhenNewSizeIsStoredThenCacheIsTrimmed) {
+    LocalWorkSizeCache cache;
+    LocalWorkSizeCacheKey key;
+    key.dim = 1;
+    for (size_t i = 0; i < LocalWorkSizeCache::maxEntries; i++) {
+        key.gws[0] = i + 1;
+        cache.storeLocalWorkSize(key, {1, 1, 1}, 0);
+    }
+    EXPECT_EQ(LocalWorkSizeCache::maxEntries, cache.getEntriesCount());
+
+    key.gws[0] = LocalWorkSizeCache::maxEntries + 1;
+    cache.storeLocalWorkSize(key, {1, 1, 1}, 0);
+    EXPECT_EQ(1u, cache.getEntriesCount());
+}
+
+TEST_F(LocalWorkSizeCacheTest, givenSameDispatchShapeWhenWorkgroupSizeIsComputedTwiceThenHeuristicsRunOnce) {
+    auto dispatchInfo = createDispatchInfo(1024, 64, 1, 2);
+
+    auto firstLws = computeWorkgroupSize(dispatchInfo);
+    EXPECT_EQ(0u, getCache().getHitCount());
+    EXPECT_EQ(1u, getCache().getMissCount());
+    auto heuristicTime = getCache().getHeuristicTimeNs();
+
+    auto secondLws = computeWorkgroupSize(dispatchInfo);
+    EXPECT_EQ(firstLws, secondLws);
+    EXPECT_EQ(1u, getCache().getHitCount());
+    EXPECT_EQ(1u, getCache().getMissCount());
+    EXPECT_EQ(heuristicTime, getCache().getHeuristicTimeNs());
+    EXPECT_EQ(1u, getCache().getEntriesCount());
+}
+
+TEST_F(LocalWorkSizeCacheTest, givenDifferentGlobalSizesWhenWorkgroupSizeIsComputedThenEachShapeHasOwnEntry) {
+    auto lws1D = computeWorkgroupSize(createDispatchInfo(1024, 1, 1, 1));
+    auto lws2D = computeWorkgroupSize(createDispatchInfo(1024, 64, 1, 2));
+    computeWorkgroupSize(createDispatchInfo(1024, 1, 1, 1));
+
+    EXPECT_EQ(2u, getCache().getEntriesCount());
+    EXPECT_EQ(1u, getCache().getHitCount());
+    EXPECT_EQ(2u, getCache().getMissCount());
+    EXPECT_EQ(1u, lws1D.y);
+    EXPECT_NE(0u, lws2D.y);
+}
+
+TEST_F(LocalWorkSizeCacheTest, givenCachedSizeWhenComputeWorkSizeModeChangesThenHeuristicsAreRerun) {
+    DebugManagerStateRestore restore;
+    auto dispatchInfo = createDispatchInfo(1024, 64, 1, 2);
+
+    DebugManager.flags.EnableComputeWorkSizeND.set(true);
+    computeWorkgroupSize(dispatchInfo);
+    DebugManager.flags.EnableComputeWorkSizeND.set(false);
+    computeWorkgroupSize(dispatchInfo);
+
+    EXPECT_EQ(0u, getCache().getHitCount());
+    EXPECT_EQ(2u, getCache().getMissCount());
+}
+
+TEST_F(LocalWorkSizeCacheTest, givenCacheDisabledWhenWorkgroupSizeIsComputedThenResultIsNotStored) {
+    DebugManagerStateRestore restore;
+    auto dispatchInfo = createDispatchInfo(1024, 64, 1, 2);
+    auto cachedLws = computeWorkgroupSize(dispatchInfo);
+    getCache().clear();
+
+    DebugManager.flags.EnableLocalWorkSizeCache.set(false);
+    auto lws = computeWorkgroupSize(dispatchInfo);
+
+    EXPECT_EQ(cachedLws, lws);
+    EXPECT_EQ(0u, getCache().getEntriesCount());
+}
+
+TEST(LocalWorkSizeAutotuneTest, givenHeuristicSizeWhenCandidatesAreGeneratedThenAllOfThemAreValidForDispatch) {
+    uint64_t gws[3] = {1024, 64, 1};
+    Vec3<size_t> lws = {32, 4, 1};
+
+    auto candidates = LocalWorkSizeCache::generateAutotuneCandidates(lws, gws, 2, 256);
+    ASSERT_LT(1u, candidates.size());
+    EXPECT_GE(LocalWorkSizeCache::maxAutotuneCandidates, candidates.size());
+    EXPECT_EQ(lws, candidates[0]);
+    for (auto &candidate : candidates) {
+        EXPECT_EQ(0u, gws[0] % candidate.x);
+        EXPECT_EQ(0u, gws[1] % candidate.y);
+        EXPECT_EQ(1u, candidate.z);
+        EXPECT_GE(256u, candidate.x * candidate.y * candidate.z);
+    }
+}
+
+TEST(LocalWorkSizeAutotuneTest, givenMaxSizedGroupWhenCandidatesAreGeneratedThenLargerGroupsAreSkipped) {
+    uint64_t gws[3] = {256, 1, 1};
+    Vec3<size_t> lws = {256, 1, 1};
+
+    auto candidates = LocalWorkSizeCache::generateAutotuneCandidates(lws, gws, 1, 256);
+    ASSERT_EQ(2u, candidates.size());
+    EXPECT_EQ(Vec3<size_t>(128, 1, 1), candidates[1]);
+}
+
+TEST(LocalWorkSizeAutotuneTest, givenAllCandidatesMeasuredWhenSizeIsSelectedThenFastestCandidateIsReturned) {
+    LocalWorkSizeCache cache;
+    LocalWorkSizeCacheKey key;
+    key.gws[0] = 1024;
+    key.gws[1] = 1;
+    key.gws[2] = 1;
+    key.dim = 1;
+    Vec3<size_t> lws = {64, 1, 1};
+    auto candidates = LocalWorkSizeCache::generateAutotuneCandidates(lws, key.gws, key.dim, 256);
+    ASSERT_EQ(3u, candidates.size());
+
+    LocalWorkSizeSample samples[3];
+    for (auto &sample : samples) {
+        sample.key = key;
+        sample.lws = cache.selectAutotuneCandidate(key, lws, 256);
+    }
+    EXPECT_EQ(candidates[0], samples[0].lws);
+    EXPECT_EQ(candidates[1], samples[1].lws);
+    EXPECT_EQ(candidates[2], samples[2].lws);
+
+    EXPECT_FALSE(cache.reportExecutionTime(samples[0], 300));
+    EXPECT_FALSE(cache.reportExecutionTime(samples[1], 100));
+    EXPECT_FALSE(cache.isAutotuned(key));
+    EXPECT_TRUE(cache.reportExecutionTime(samples[2], 200));
+    EXPECT_TRUE(cache.isAutotuned(key));
+
+    EXPECT_EQ(samples[1].lws, cache.selectAutotuneCandidate(key, lws, 256));
+    EXPECT_FALSE(cache.reportExecutionTime(samples[2], 1));
+}
+
+TEST(LocalWorkSizeAutotuneTest, givenUnmeasuredCandidatesWhenSizeIsSelectedAgainThenCandidatesWithoutSamplesArePreferred) {
+    LocalWorkSizeCache cache;
+    LocalWorkSizeCacheKey key;
+    key.gws[0] = 1024;
+    key.gws[1] = 1;
+    key.gws[2] = 1;
+    key.dim = 1;
+    Vec3<size_t> lws = {64, 1, 1};
+
+    LocalWorkSizeSample sample;
+    sample.key = key;
+    sample.lws = cache.selectAutotuneCandidate(key, lws, 256);
+    cache.reportExecutionTime(sample, 100);
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_NE(sample.lws, cache.selectAutotuneCandidate(key, lws, 256));
+    }
+}
+
+TEST(LocalWorkSizeAutotuneTest, givenTunedSizesWhenSavedAndLoadedThenSameSizesAreSelected) {
+    const std::string fileName = "lws_autotune_test.lws_cache";
+    LocalWorkSizeCacheKey key;
+    key.gws[0] = 512;
+    key.gws[1] = 1;
+    key.gws[2] = 1;
+    key.dim = 1;
+    key.simdSize = 16;
+    Vec3<size_t> lws = {256, 1, 1};
+
+    LocalWorkSizeCache cache;
+    LocalWorkSizeSample samples[2];
+    for (auto &sample : samples) {
+        sample.key = key;
+        sample.lws = cache.selectAutotuneCandidate(key, lws, 256);
+    }
+    cache.reportExecutionTime(samples[0], 200);
+    EXPECT_TRUE(cache.reportExecutionTime(samples[1], 100));
+    EXPECT_TRUE(cache.saveAutotuneResults(fileName));
+
+    LocalWorkSizeCache loadedCache;
+    EXPECT_TRUE(loadedCache.loadAutotuneResults(fileName));
+    std::remove(fileName.c_str());
+
+    EXPECT_TRUE(loadedCache.isAutotuned(key));
+    EXPECT_EQ(samples[1].lws, loadedCache.selectAutotuneCandidate(key, lws, 256));
+
+    LocalWorkSizeCache emptyCache;
+    EXPECT_FALSE(emptyCache.loadAutotuneResults(fileName));
+}
+
+TEST_F(LocalWorkSizeCacheTest, givenAutotuneEnabledWhenWorkgroupSizeIsGeneratedThenCandidatesAreCycled) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.EnableLocalWorkSizeAutotune.set(true);
+    auto dispatchInfo = createDispatchInfo(1024, 1, 1, 1);
+
+    auto heuristicLws = computeWorkgroupSize(dispatchInfo);
+    auto firstLws = generateWorkgroupSize(dispatchInfo);
+    auto secondLws = generateWorkgroupSize(dispatchInfo);
+
+    EXPECT_EQ(heuristicLws, firstLws);
+    EXPECT_NE(firstLws, secondLws);
+    EXPECT_EQ(0u, dispatchInfo.getGWS().x % secondLws.x);
+}
+
+TEST_F(LocalWorkSizeCacheTest, givenAutotuneCacheDirNotSetWhenFileNameIsQueriedThenResultsAreNotPersisted) {
+    EXPECT_TRUE(LocalWorkSizeCache::getAutotuneFileName(*kernel->mockKernel).empty());
+    EXPECT_FALSE(getCache().persistAutotuneResults());
+}
+
+TEST_F(LocalWorkSizeCacheTest, givenAutotuneCacheDirSetWhenFileNameIsQueriedThenItIsPlacedInDirectoryAndDependsOnKernel) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.LocalWorkSizeAutotuneCacheDir.set("lws_dir");
+
+    auto fileName = LocalWorkSizeCache::getAutotuneFileName(*kernel->mockKernel);
+    EXPECT_EQ(0u, fileName.find("lws_dir"));
+    EXPECT_NE(std::string::npos, fileName.find(".lws_cache"));
+
+    kernel->kernelInfo.name = "otherKernel";
+    EXPECT_NE(fileName, LocalWorkSizeCache::getAutotuneFileName(*kernel->mockKernel));
+}
@@ -11,6 +11,8 @@
 #include "test.h"
 #include "unit_tests/fixtures/ult_command_stream_receiver_fixture.h"
 #include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/helpers/memory_management.h"
+#include "unit_tests/mocks/mock_allocation_properties.h"
 #include "unit_tests/mocks/mock_command_queue.h"
 #include "unit_tests/mocks/mock_context.h"
 #include "unit_tests/mocks/mock_csr.h"
@@ -1331,3 +1333,87 @@ HWTEST_F(CommandStreamReceiverFlushTaskTests, givenDispatchFlagsWithThrottleSetT
 
     EXPECT_EQ(cmdBuffer->batchBuffer.throttle, QueueThrottle::HIGH);
 }
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWhenTasksAreFlushedInSteadyStateThenCommandBufferRecordsAreRecycledWithoutHeapAllocations) {
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.overrideDispatchPolicy(DispatchMode::BatchedDispatch);
+    configureCSRtoNonDirtyState<FamilyType>();
+
+    constexpr size_t tasksPerBatch = 4;
+    auto flushTasks = [&]() {
+        commandStream.replaceBuffer(cmdBuffer, commandStream.getMaxAvailableSpace());
+        for (size_t task = 0; task < tasksPerBatch; task++) {
+            auto startOffset = commandStream.getUsed();
+            commandStream.getSpace(sizeof(uint32_t));
+            flushTask(commandStreamReceiver, false, startOffset);
+        }
+    };
+
+    // warm up, residency containers reach their final capacity
+    for (int round = 0; round < 2; round++) {
+        flushTasks();
+        commandStreamReceiver.flushBatchedSubmissions();
+    }
+    auto submissionAggregator = commandStreamReceiver.submissionAggregator.get();
+    EXPECT_TRUE(submissionAggregator->peekCmdBufferList().peekIsEmpty());
+    auto recycledCmdBuffer = submissionAggregator->peekFreeCmdBufferList().peekHead();
+    ASSERT_NE(nullptr, recycledCmdBuffer);
+
+    MemoryManagement::detailedAllocationLoggingActive = true;
+    auto allocationsBefore = MemoryManagement::indexAllocation.load();
+    flushTasks();
+    auto allocationsAfter = MemoryManagement::indexAllocation.load();
+    MemoryManagement::detailedAllocationLoggingActive = false;
+
+    EXPECT_EQ(0u, allocationsAfter - allocationsBefore);
+    EXPECT_EQ(recycledCmdBuffer, submissionAggregator->peekCmdBufferList().peekHead());
+    EXPECT_TRUE(submissionAggregator->peekFreeCmdBufferList().peekIsEmpty());
+
+    commandStreamReceiver.flushBatchedSubmissions();
+    EXPECT_TRUE(submissionAggregator->peekCmdBufferList().peekIsEmpty());
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenHeapsExhaustedBetweenTasksWhenHeapBaseAddressReuseIsEnabledThenStateBaseAddressIsNotReprogrammed) {
+    typedef typename FamilyType::STATE_BASE_ADDRESS STATE_BASE_ADDRESS;
+    DebugManagerStateRestore restore;
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    configureCSRtoNonDirtyState<FamilyType>();
+    flushTaskFlags.preemptionMode = PreemptionHelper::getDefaultPreemptionMode(pDevice->getHardwareInfo());
+
+    commandStreamReceiver.getIndirectHeap(IndirectHeap::DYNAMIC_STATE, 0u);
+    commandStreamReceiver.getIndirectHeap(IndirectHeap::SURFACE_STATE, 0u);
+
+    // completed allocation waiting for reuse, picked up by heaps replaced on exhaustion
+    auto reusableAllocation = pDevice->getMemoryManager()->allocateGraphicsMemoryWithProperties(MockAllocationProperties{commandStreamReceiver.defaultSshSize});
+    commandStreamReceiver.getInternalAllocationStorage()->storeAllocation(std::unique_ptr<GraphicsAllocation>(reusableAllocation), REUSABLE_ALLOCATION);
+
+    constexpr uint32_t tasksCount = 8;
+    auto countStateBaseAddressCommands = [&]() {
+        auto startOffset = commandStreamReceiver.commandStream.getUsed();
+        for (uint32_t task = 0; task < tasksCount; task++) {
+            auto &taskDsh = commandStreamReceiver.getIndirectHeap(IndirectHeap::DYNAMIC_STATE, MemoryConstants::pageSize);
+            auto &taskIoh = commandStreamReceiver.getIndirectHeap(IndirectHeap::INDIRECT_OBJECT, MemoryConstants::pageSize);
+            auto &taskSsh = commandStreamReceiver.getIndirectHeap(IndirectHeap::SURFACE_STATE, MemoryConstants::pageSize);
+
+            commandStreamReceiver.flushTask(commandStream, 0, taskDsh, taskIoh, taskSsh, taskLevel, flushTaskFlags, *pDevice);
+
+            taskDsh.getSpace(taskDsh.getAvailableSpace());
+            taskIoh.getSpace(taskIoh.getAvailableSpace());
+            taskSsh.getSpace(taskSsh.getAvailableSpace());
+        }
+
+        HardwareParse hwParser;
+        hwParser.parseCommands<FamilyType>(commandStreamReceiver.commandStream, startOffset);
+        uint32_t stateBaseAddressCount = 0;
+        for (auto &cmd : hwParser.cmdList) {
+            stateBaseAddressCount += genCmdCast<STATE_BASE_ADDRESS *>(cmd) ? 1 : 0;
+        }
+        return stateBaseAddressCount;
+    };
+
+    DebugManager.flags.EnableHeapBaseAddressReuse.set(false);
+    EXPECT_LT(1u, countStateBaseAddressCommands());
+
+    DebugManager.flags.EnableHeapBaseAddressReuse.set(true);
+    EXPECT_EQ(0u, countStateBaseAddressCommands());
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/command_stream/command_stream_ring.h"
+#include "runtime/command_stream/linear_stream.h"
+#include "runtime/memory_manager/allocations_list.h"
+#include "unit_tests/fixtures/device_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/helpers/memory_management.h"
+#include "unit_tests/libult/ult_command_stream_receiver.h"
+#include "unit_tests/mocks/mock_command_queue.h"
+#include "test.h"
+
+using namespace OCLRT;
+
+typedef Test<DeviceFixture> CommandStreamRingTest;
+
+HWTEST_F(CommandStreamRingTest, givenGpuLaggingBehindWhenCsrCommandStreamIsExhaustedRepeatedlyThenChunksAreReusedWithoutAllocations) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.EnableCommandStreamRing.set(true);
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    auto initialTag = *commandStreamReceiver.getTagAddress();
+
+    constexpr uint32_t gpuLag = 3u;
+    constexpr size_t commandsSize = 1024u;
+    auto submit = [&]() {
+        auto &commandStream = commandStreamReceiver.getCS(commandsSize);
+        commandStream.getSpace(commandsSize);
+        commandStreamReceiver.taskCount++;
+        *commandStreamReceiver.getTagAddress() = commandStreamReceiver.taskCount > gpuLag ? commandStreamReceiver.taskCount - gpuLag : 0u;
+    };
+
+    for (int i = 0; i < 1000; i++) {
+        submit();
+    }
+    auto chunksCount = commandStreamReceiver.commandStreamRing->getChunksCount();
+    EXPECT_LT(1u, chunksCount);
+
+    MemoryManagement::detailedAllocationLoggingActive = true;
+    auto allocationsBefore = MemoryManagement::indexAllocation.load();
+    for (int i = 0; i < 1000000; i++) {
+        submit();
+    }
+    auto allocationsAfter = MemoryManagement::indexAllocation.load();
+    MemoryManagement::detailedAllocationLoggingActive = false;
+
+    EXPECT_EQ(0u, allocationsAfter - allocationsBefore);
+    EXPECT_EQ(chunksCount, commandStreamReceiver.commandStreamRing->getChunksCount());
+    EXPECT_TRUE(commandStreamReceiver.getAllocationsForReuse().peekIsEmpty());
+
+    *commandStreamReceiver.getTagAddress() = initialTag;
+}
+
+HWTEST_F(CommandStreamRingTest, givenChunkStillUsedByGpuWhenQueueCommandStreamIsExhaustedThenRingIsExtendedAndCompletedChunkIsReusedLater) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.EnableCommandStreamRing.set(true);
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    auto initialTag = *commandStreamReceiver.getTagAddress();
+    GraphicsAllocation *firstChunk = nullptr;
+    GraphicsAllocation *secondChunk = nullptr;
+    {
+        MockCommandQueue commandQueue(nullptr, pDevice, nullptr);
+        auto &commandStream = commandQueue.getCS(1024u);
+        firstChunk = commandStream.getGraphicsAllocation();
+
+        commandStreamReceiver.taskCount = 5u;
+        *commandStreamReceiver.getTagAddress() = 4u;
+        commandStream.getSpace(commandStream.getAvailableSpace());
+        commandQueue.getCS(1024u);
+        secondChunk = commandStream.getGraphicsAllocation();
+        EXPECT_NE(firstChunk, secondChunk);
+        EXPECT_EQ(2u, commandQueue.commandStreamRing->getChunksCount());
+
+        *commandStreamReceiver.getTagAddress() = 5u;
+        commandStream.getSpace(commandStream.getAvailableSpace());
+        commandQueue.getCS(1024u);
+        EXPECT_EQ(firstChunk, commandStream.getGraphicsAllocation());
+        EXPECT_EQ(2u, commandQueue.commandStreamRing->getChunksCount());
+        EXPECT_TRUE(commandStreamReceiver.getAllocationsForReuse().peekIsEmpty());
+    }
+    EXPECT_TRUE(commandStreamReceiver.getAllocationsForReuse().peekContains(*firstChunk));
+    EXPECT_TRUE(commandStreamReceiver.getAllocationsForReuse().peekContains(*secondChunk));
+
+    *commandStreamReceiver.getTagAddress() = initialTag;
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/command_stream/scratch_space_controller_base.h"
+#include "runtime/command_stream/scratch_space_pool.h"
+#include "runtime/execution_environment/execution_environment.h"
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "runtime/memory_manager/memory_constants.h"
+#include "runtime/memory_manager/memory_manager.h"
+#include "unit_tests/fixtures/device_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/libult/ult_command_stream_receiver.h"
+#include "test.h"
+
+#include <vector>
+
+using namespace OCLRT;
+
+struct ScratchSpaceControllerTest : public Test<DeviceFixture> {
+    struct ScratchStateChanges {
+        uint32_t vfeStateReprogrammings = 0;
+        uint32_t stateBaseAddressReprogrammings = 0;
+    };
+
+    template <typename FamilyType>
+    ScratchSpaceController *getScratchSpaceController(uint32_t engineId) {
+        auto commandStreamReceiver = static_cast<UltCommandStreamReceiver<FamilyType> *>(pDevice->getEngine(engineId).commandStreamReceiver);
+        return commandStreamReceiver->scratchSpaceController.get();
+    }
+
+    ScratchStateChanges requireScratchSpace(ScratchSpaceController &controller, const std::vector<uint32_t> &perThreadScratchSizes, uint32_t taskCount = 0) {
+        ScratchStateChanges changes;
+        for (auto perThreadScratchSize : perThreadScratchSizes) {
+            bool stateBaseAddressDirty = false;
+            bool vfeStateDirty = false;
+            controller.setRequiredScratchSpace(nullptr, perThreadScratchSize, taskCount, 0u, stateBaseAddressDirty, vfeStateDirty);
+            changes.vfeStateReprogrammings += vfeStateDirty ? 1 : 0;
+            changes.stateBaseAddressReprogrammings += stateBaseAddressDirty ? 1 : 0;
+
+            EXPECT_GE(controller.getPerThreadScratchSize(), perThreadScratchSize);
+            if (perThreadScratchSize) {
+                EXPECT_NE(nullptr, controller.getScratchSpaceAllocation());
+            }
+            if (perThreadScratchSize && controller.getScratchSpaceAllocation()) {
+                EXPECT_GE(controller.getScratchSpaceAllocation()->getUnderlyingBufferSize(), perThreadScratchSize * getComputeUnitsUsedForScratch());
+            }
+        }
+        return changes;
+    }
+
+    size_t getComputeUnitsUsedForScratch() {
+        return pDevice->getDeviceInfo().computeUnitsUsedForScratch;
+    }
+
+    DebugManagerStateRestore restore;
+};
+
+HWTEST_F(ScratchSpaceControllerTest, givenKernelsWithVaryingScratchSizesWhenScratchSpaceIsPooledThenFewerAllocationsAndStateReprogrammingsAreNeeded) {
+    std::vector<uint32_t> kernelScratchSizes = {1024, 1536, 2048, 1024, 3072, 4096, 2048, 4096, 1024};
+
+    DebugManager.flags.EnableScratchSpacePooling.set(false);
+    auto exactController = getScratchSpaceController<FamilyType>(0);
+    auto exactChanges = requireScratchSpace(*exactController, kernelScratchSizes);
+
+    DebugManager.flags.EnableScratchSpacePooling.set(true);
+    auto pooledController = getScratchSpaceController<FamilyType>(1);
+    auto pooledChanges = requireScratchSpace(*pooledController, kernelScratchSizes);
+
+    EXPECT_EQ(5u, exactController->getScratchAllocationsCount());
+    EXPECT_EQ(5u, exactChanges.vfeStateReprogrammings);
+    EXPECT_GE(3u, pooledController->getScratchAllocationsCount());
+    EXPECT_EQ(5u, pooledChanges.vfeStateReprogrammings);
+    if (is64bit && !pDevice->getMemoryManager()->peekForce32BitAllocations()) {
+        EXPECT_EQ(5u, exactChanges.stateBaseAddressReprogrammings);
+        EXPECT_EQ(pooledController->getScratchAllocationsCount(), pooledChanges.stateBaseAddressReprogrammings);
+    }
+    EXPECT_EQ(4096u, pooledController->getPerThreadScratchSize());
+}
+
+HWTEST_F(ScratchSpaceControllerTest, givenScratchOutgrownByOneEngineWhenOtherEngineRequiresSmallerScratchThenReleasedAllocationIsReused) {
+    DebugManager.flags.EnableScratchSpacePooling.set(true);
+    auto firstController = getScratchSpaceController<FamilyType>(0);
+    auto secondController = getScratchSpaceController<FamilyType>(1);
+
+    requireScratchSpace(*firstController, {1024});
+    auto outgrownAllocation = firstController->getScratchSpaceAllocation();
+    requireScratchSpace(*firstController, {4096});
+    EXPECT_NE(outgrownAllocation, firstController->getScratchSpaceAllocation());
+    EXPECT_EQ(1u, pDevice->getExecutionEnvironment()->getScratchSpacePool()->getIdleAllocationsCount());
+
+    requireScratchSpace(*secondController, {1024});
+    EXPECT_EQ(outgrownAllocation, secondController->getScratchSpaceAllocation());
+    EXPECT_EQ(0u, secondController->getScratchAllocationsCount());
+    EXPECT_EQ(0u, pDevice->getExecutionEnvironment()->getScratchSpacePool()->getIdleAllocationsCount());
+}
+
+HWTEST_F(ScratchSpaceControllerTest, givenOutgrownScratchStillUsedByGpuWhenOtherEngineRequiresScratchThenNewAllocationIsCreated) {
+    DebugManager.flags.EnableScratchSpacePooling.set(true);
+    auto &firstCsr = *pDevice->getEngine(0).commandStreamReceiver;
+    auto firstController = getScratchSpaceController<FamilyType>(0);
+    auto secondController = getScratchSpaceController<FamilyType>(1);
+
+    auto initialTag = *firstCsr.getTagAddress();
+    *firstCsr.getTagAddress() = 1;
+
+    requireScratchSpace(*firstController, {1024}, 5);
+    auto outgrownAllocation = firstController->getScratchSpaceAllocation();
+    requireScratchSpace(*firstController, {4096}, 5);
+
+    requireScratchSpace(*secondController, {1024});
+    EXPECT_NE(outgrownAllocation, secondController->getScratchSpaceAllocation());
+    EXPECT_EQ(1u, secondController->getScratchAllocationsCount());
+    EXPECT_EQ(1u, pDevice->getExecutionEnvironment()->getScratchSpacePool()->getIdleAllocationsCount());
+
+    *firstCsr.getTagAddress() = initialTag;
+}
+
+HWTEST_F(ScratchSpaceControllerTest, givenLowScratchDemandForManySubmissionsWhenScratchSpaceIsRequiredThenOversizedScratchIsReleased) {
+    DebugManager.flags.EnableScratchSpacePooling.set(true);
+    auto controller = getScratchSpaceController<FamilyType>(0);
+
+    requireScratchSpace(*controller, {8192});
+    auto oversizedAllocation = controller->getScratchSpaceAllocation();
+    auto oversizedScratchSize = oversizedAllocation->getUnderlyingBufferSize();
+
+    std::vector<uint32_t> lowDemand(ScratchSpaceControllerBase::lowDemandSubmissionsToShrink - 1, 1024);
+    auto changes = requireScratchSpace(*controller, lowDemand);
+    EXPECT_EQ(0u, changes.vfeStateReprogrammings);
+    EXPECT_EQ(0u, changes.stateBaseAddressReprogrammings);
+    EXPECT_EQ(oversizedAllocation, controller->getScratchSpaceAllocation());
+    EXPECT_EQ(8192u, controller->getPerThreadScratchSize());
+
+    changes = requireScratchSpace(*controller, {1024});
+    EXPECT_EQ(1u, changes.vfeStateReprogrammings);
+    EXPECT_NE(oversizedAllocation, controller->getScratchSpaceAllocation());
+    EXPECT_LT(controller->getScratchSpaceAllocation()->getUnderlyingBufferSize(), oversizedScratchSize);
+    EXPECT_EQ(1024u, controller->getPerThreadScratchSize());
+
+    std::vector<uint32_t> noDemand(ScratchSpaceControllerBase::lowDemandSubmissionsToShrink, 0);
+    requireScratchSpace(*controller, noDemand);
+    EXPECT_EQ(nullptr, controller->getScratchSpaceAllocation());
+    EXPECT_EQ(0u, controller->getPerThreadScratchSize());
+}
+
+TEST_F(ScratchSpaceControllerTest, givenMoreCompletedIdleAllocationsThanLimitWhenAllocationIsReleasedThenOldestAreFreed) {
+    ScratchSpacePool pool(*pDevice->getExecutionEnvironment());
+    auto memoryManager = pDevice->getMemoryManager();
+    std::vector<GraphicsAllocation *> allocations;
+    for (size_t i = 0; i < ScratchSpacePool::maxIdleAllocations + 2; i++) {
+        allocations.push_back(memoryManager->allocateGraphicsMemoryWithProperties({MemoryConstants::pageSize * (i + 1), GraphicsAllocation::AllocationType::SCRATCH_SURFACE}));
+        pool.release(allocations.back(), 0u, nullptr, 0u);
+    }
+    EXPECT_EQ(ScratchSpacePool::maxIdleAllocations, pool.getIdleAllocationsCount());
+
+    EXPECT_EQ(nullptr, pool.obtain(MemoryConstants::pageSize, MemoryConstants::pageSize * 2, 0u));
+    EXPECT_EQ(nullptr, pool.obtain(MemoryConstants::pageSize * 3, MemoryConstants::pageSize * 4, 1u));
+    auto allocation = pool.obtain(MemoryConstants::pageSize * 3, MemoryConstants::pageSize * 4, 0u);
+    EXPECT_EQ(allocations[2], allocation);
+    memoryManager->freeGraphicsMemory(allocation);
+}
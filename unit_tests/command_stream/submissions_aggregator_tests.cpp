@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -667,3 +667,39 @@ HWTEST_F(SubmissionsAggregatorTests, givenMultipleCmdBuffersWhenNotAggregatedDur
     castToObject<Event>(event1)->release();
     castToObject<Event>(event2)->release();
 }
+
+TEST(SubmissionsAggregator, givenRecycledCommandBufferWhenCommandBufferIsObtainedForSameDeviceThenResetRecordIsReused) {
+    MockSubmissionAggregator submissionsAggregator;
+    std::unique_ptr<Device> device(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+    std::unique_ptr<Device> otherDevice(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+    MockGraphicsAllocation allocation(nullptr, 4096);
+    FlushStampTracker flushStampTracker(true);
+
+    auto cmdBuffer = submissionsAggregator.obtainCommandBuffer(*device);
+    cmdBuffer->surfaces.assign(16, &allocation);
+    cmdBuffer->batchBuffer.commandBufferAllocation = &allocation;
+    cmdBuffer->taskCount = 5u;
+    cmdBuffer->inspectionId = 3u;
+    cmdBuffer->flushStamp->replaceStampObject(flushStampTracker.getStampReference());
+    EXPECT_EQ(2, flushStampTracker.getStampReference()->getRefInternalCount());
+
+    submissionsAggregator.recycleCommandBuffer(std::unique_ptr<CommandBuffer>(cmdBuffer));
+    EXPECT_EQ(1, flushStampTracker.getStampReference()->getRefInternalCount());
+    EXPECT_EQ(cmdBuffer, submissionsAggregator.peekFreeCmdBufferList().peekHead());
+
+    auto reusedCmdBuffer = submissionsAggregator.obtainCommandBuffer(*device);
+    EXPECT_EQ(cmdBuffer, reusedCmdBuffer);
+    EXPECT_TRUE(submissionsAggregator.peekFreeCmdBufferList().peekIsEmpty());
+    EXPECT_TRUE(reusedCmdBuffer->surfaces.empty());
+    EXPECT_LE(16u, reusedCmdBuffer->surfaces.capacity());
+    EXPECT_EQ(nullptr, reusedCmdBuffer->batchBuffer.commandBufferAllocation);
+    EXPECT_EQ(0u, reusedCmdBuffer->taskCount);
+    EXPECT_EQ(0u, reusedCmdBuffer->inspectionId);
+    EXPECT_EQ(nullptr, reusedCmdBuffer->flushStamp->getStampReference());
+
+    submissionsAggregator.recycleCommandBuffer(std::unique_ptr<CommandBuffer>(reusedCmdBuffer));
+    std::unique_ptr<CommandBuffer> otherDeviceCmdBuffer(submissionsAggregator.obtainCommandBuffer(*otherDevice));
+    EXPECT_NE(reusedCmdBuffer, otherDeviceCmdBuffer.get());
+    EXPECT_EQ(otherDevice.get(), &otherDeviceCmdBuffer->device);
+    EXPECT_TRUE(submissionsAggregator.peekFreeCmdBufferList().peekIsEmpty());
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -20,6 +20,7 @@
 #include "runtime/command_queue/gpgpu_walker.h"
 #include "runtime/helpers/kernel_commands.h"
 
+#include <algorithm>
 #include <memory>
 
 using namespace OCLRT;
@@ -288,6 +289,36 @@ HWCMDTEST_F(IGFX_GEN8_CORE, DeviceQueueSlb, slbEndOffset) {
     free(slbCopy);
 }
 
+HWCMDTEST_F(IGFX_GEN8_CORE, DeviceQueueSlb, givenSchedulerEarlyReturnWhenDeviceQueueIsResetThenWholeEventPoolAndSlbEnqueueSpaceAreRewritten) {
+    std::unique_ptr<MockDeviceQueueHw<FamilyType>> mockDeviceQueueHw(new MockDeviceQueueHw<FamilyType>(pContext, device, deviceQueueProperties::minimumProperties[0]));
+
+    auto eventPool = mockDeviceQueueHw->getEventPoolBuffer();
+    auto slb = mockDeviceQueueHw->getSlbBuffer();
+    auto igilCmdQueue = mockDeviceQueueHw->getIgilQueue();
+    auto commandsSize = mockDeviceQueueHw->getMinimumSlbSize() + mockDeviceQueueHw->getWaCommandsSize();
+    auto slbEnqueuesSize = commandsSize * 128;
+    const uint8_t untouched = 0xFE;
+
+    auto countUntouchedBytes = [&](GraphicsAllocation *allocation, size_t size) {
+        auto bytes = static_cast<uint8_t *>(allocation->getUnderlyingBuffer());
+        return static_cast<size_t>(std::count(bytes, bytes + size, untouched));
+    };
+
+    mockDeviceQueueHw->resetDeviceQueue();
+    std::unique_ptr<uint8_t[]> slbCopy(new uint8_t[slbEnqueuesSize]);
+    memcpy(slbCopy.get(), slb->getUnderlyingBuffer(), slbEnqueuesSize);
+
+    // scheduler may allocate events anywhere in the pool and leave SLB without SLBENDoffset set
+    memset(eventPool->getUnderlyingBuffer(), untouched, eventPool->getUnderlyingBufferSize());
+    memset(slb->getUnderlyingBuffer(), untouched, slbEnqueuesSize);
+    igilCmdQueue->m_controls.m_SLBENDoffsetInBytes = -1;
+
+    mockDeviceQueueHw->resetDeviceQueue();
+
+    EXPECT_EQ(0u, countUntouchedBytes(eventPool, eventPool->getUnderlyingBufferSize()));
+    EXPECT_EQ(0, memcmp(slbCopy.get(), slb->getUnderlyingBuffer(), slbEnqueuesSize));
+}
+
 HWCMDTEST_F(IGFX_GEN8_CORE, DeviceQueueSlb, cleanupSection) {
     using MI_BATCH_BUFFER_START = typename FamilyType::MI_BATCH_BUFFER_START;
     using MI_BATCH_BUFFER_END = typename FamilyType::MI_BATCH_BUFFER_END;
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -10,6 +10,8 @@
 #include "unit_tests/fixtures/memory_management_fixture.h"
 #include "gtest/gtest.h"
 
+#include <sstream>
+
 using namespace CLElfLib;
 
 struct ElfTests : public MemoryManagementFixture,
@@ -104,3 +106,106 @@ TEST_F(ElfTests, givenInvalidBinaryStorageThenExceptionIsThrown) {
 
     EXPECT_THROW(CElfReader elfReader(binary), ElfException);
 }
+
+TEST_F(ElfTests, givenBorrowedBinaryWhenReaderIsCreatedThenSectionsAreReadInPlace) {
+    CElfWriter writer(E_EH_TYPE::EH_TYPE_EXECUTABLE, E_EH_MACHINE::EH_MACHINE_NONE, 0);
+    std::string data{"data pattern"};
+    writer.addSection(SSectionNode(E_SH_TYPE::SH_TYPE_OPENCL_SOURCE, E_SH_FLAG::SH_FLAG_WRITE, "Steve", data, static_cast<uint32_t>(data.size())));
+
+    ElfBinaryStorage binary(writer.getTotalBinarySize());
+    writer.resolveBinary(binary);
+
+    const CElfReader elfReader(binary.data(), binary.size());
+
+    ASSERT_EQ(3u, elfReader.getSectionsCount());
+    auto sectionHeader = elfReader.getSectionHeader(1);
+    EXPECT_EQ(E_SH_TYPE::SH_TYPE_OPENCL_SOURCE, sectionHeader.Type);
+    EXPECT_EQ(E_SH_FLAG::SH_FLAG_WRITE, sectionHeader.Flags);
+    EXPECT_EQ(data.size(), sectionHeader.DataSize);
+    EXPECT_EQ(binary.data() + sectionHeader.DataOffset, elfReader.getSectionData(sectionHeader.DataOffset));
+    EXPECT_EQ(0, memcmp(data.c_str(), elfReader.getSectionData(sectionHeader.DataOffset), data.size()));
+    EXPECT_EQ(E_SH_TYPE::SH_TYPE_STR_TBL, elfReader.getSectionHeader(2).Type);
+}
+
+TEST_F(ElfTests, givenReaderWhenSectionHeadersAreRequestedThenTheyMatchLazilyDecodedHeaders) {
+    CElfWriter writer(E_EH_TYPE::EH_TYPE_EXECUTABLE, E_EH_MACHINE::EH_MACHINE_NONE, 0);
+    writer.addSection(SSectionNode(E_SH_TYPE::SH_TYPE_OPENCL_SOURCE, E_SH_FLAG::SH_FLAG_NONE, "first", "abc", 3u));
+    writer.addSection(SSectionNode(E_SH_TYPE::SH_TYPE_OPENCL_OPTIONS, E_SH_FLAG::SH_FLAG_NONE, "second", "-cl-opt", 7u));
+
+    ElfBinaryStorage binary(writer.getTotalBinarySize());
+    writer.resolveBinary(binary);
+
+    CElfReader elfReader(binary);
+    auto &sectionHeaders = elfReader.getSectionHeaders();
+    ASSERT_EQ(elfReader.getSectionsCount(), sectionHeaders.size());
+    for (size_t i = 0; i < sectionHeaders.size(); i++) {
+        auto sectionHeader = elfReader.getSectionHeader(i);
+        EXPECT_EQ(0, memcmp(&sectionHeader, &sectionHeaders[i], sizeof(SElf64SectionHeader)));
+    }
+}
+
+TEST_F(ElfTests, givenTruncatedBorrowedBinaryWhenReaderIsCreatedThenExceptionIsThrown) {
+    CElfWriter writer(E_EH_TYPE::EH_TYPE_EXECUTABLE, E_EH_MACHINE::EH_MACHINE_NONE, 0);
+    writer.addSection(SSectionNode(E_SH_TYPE::SH_TYPE_OPENCL_SOURCE, E_SH_FLAG::SH_FLAG_NONE, "source", "abc", 3u));
+
+    ElfBinaryStorage binary(writer.getTotalBinarySize());
+    writer.resolveBinary(binary);
+
+    EXPECT_THROW(CElfReader elfReader(binary.data(), binary.size() - 1), ElfException);
+    EXPECT_THROW(CElfReader elfReader(nullptr, 0u), ElfException);
+}
+
+TEST_F(ElfTests, givenSameSectionsWhenBinaryIsResolvedToStreamThenOutputIsEqualToResolvedStorage) {
+    std::string source{"kernel void k() {}"};
+    std::string options{"-cl-fast-relaxed-math"};
+    char deviceBinary[64];
+    for (size_t i = 0; i < sizeof(deviceBinary); i++) {
+        deviceBinary[i] = static_cast<char>(i);
+    }
+
+    CElfWriter storageWriter(E_EH_TYPE::EH_TYPE_OPENCL_EXECUTABLE, E_EH_MACHINE::EH_MACHINE_NONE, 0);
+    CElfWriter streamWriter(E_EH_TYPE::EH_TYPE_OPENCL_EXECUTABLE, E_EH_MACHINE::EH_MACHINE_NONE, 0);
+    for (auto writer : {&storageWriter, &streamWriter}) {
+        writer->addSection(SSectionNode(E_SH_TYPE::SH_TYPE_OPENCL_SOURCE, E_SH_FLAG::SH_FLAG_NONE, "source", source, static_cast<uint32_t>(source.size())));
+        writer->addSection(SSectionNode(E_SH_TYPE::SH_TYPE_OPENCL_OPTIONS, E_SH_FLAG::SH_FLAG_NONE, "BuildOptions", options, static_cast<uint32_t>(options.size() + 1u)));
+        writer->addSectionWithDataReference(E_SH_TYPE::SH_TYPE_OPENCL_DEV_BINARY, E_SH_FLAG::SH_FLAG_NONE, "", deviceBinary, sizeof(deviceBinary));
+    }
+
+    ElfBinaryStorage binary(storageWriter.getTotalBinarySize());
+    storageWriter.resolveBinary(binary);
+
+    auto expectedSize = streamWriter.getTotalBinarySize();
+    std::ostringstream stream;
+    streamWriter.resolveBinary(stream);
+    auto streamedBinary = stream.str();
+
+    ASSERT_EQ(expectedSize, streamedBinary.size());
+    ASSERT_EQ(binary.size(), streamedBinary.size());
+    EXPECT_EQ(0, memcmp(binary.data(), streamedBinary.data(), binary.size()));
+
+    CElfReader elfReader(&streamedBinary[0], streamedBinary.size());
+    ASSERT_EQ(5u, elfReader.getSectionsCount());
+    auto deviceBinarySection = elfReader.getSectionHeader(3);
+    EXPECT_EQ(E_SH_TYPE::SH_TYPE_OPENCL_DEV_BINARY, deviceBinarySection.Type);
+    ASSERT_EQ(sizeof(deviceBinary), deviceBinarySection.DataSize);
+    EXPECT_EQ(0, memcmp(deviceBinary, elfReader.getSectionData(deviceBinarySection.DataOffset), sizeof(deviceBinary)));
+}
+
+TEST_F(ElfTests, givenSectionWithDataReferenceWhenSectionIsAddedThenDataIsNotCopied) {
+    class MockElfWriter : public CElfWriter {
+      public:
+        MockElfWriter() : CElfWriter(E_EH_TYPE::EH_TYPE_EXECUTABLE, E_EH_MACHINE::EH_MACHINE_NONE, 0) {}
+        using CElfWriter::nodeQueue;
+    };
+
+    MockElfWriter writer;
+    const char data[] = "data pattern";
+    writer.addSectionWithDataReference(E_SH_TYPE::SH_TYPE_OPENCL_SOURCE, E_SH_FLAG::SH_FLAG_NONE, "Steve", data, sizeof(data));
+
+    ASSERT_EQ(2u, writer.nodeQueue.size());
+    writer.nodeQueue.pop();
+    EXPECT_TRUE(writer.nodeQueue.front().data.empty());
+    EXPECT_EQ(data, writer.nodeQueue.front().getData());
+    EXPECT_EQ(sizeof(data), writer.nodeQueue.front().dataSize);
+    EXPECT_EQ(sizeof(data) + sizeof(SElf64Header) + 3 * sizeof(SElf64SectionHeader) + sizeof("") + sizeof("Steve"), writer.getTotalBinarySize());
+}
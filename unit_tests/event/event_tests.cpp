@@ -718,6 +718,49 @@ TEST_F(InternalsEventTest, GIVENProfilingWHENMapOperationTHENTimesSet) {
     delete pCmdQ;
 }
 
+TEST_F(InternalsEventTest, givenLocalWorkSizeSampleWhenProfilingDataIsCalculatedThenExecutionTimeIsReportedToKernelCache) {
+    const cl_queue_properties props[3] = {CL_QUEUE_PROPERTIES, CL_QUEUE_PROFILING_ENABLE, 0};
+    std::unique_ptr<CommandQueue> pCmdQ(new CommandQueue(mockContext, pDevice, props));
+    MockKernelWithInternals kernel(*pDevice);
+    auto &lwsCache = kernel.mockKernel->getLocalWorkSizeCache();
+
+    DispatchInfo dispatchInfo(kernel.mockKernel, 1, Vec3<size_t>(1024, 1, 1), Vec3<size_t>(0, 0, 0), Vec3<size_t>(0, 0, 0));
+    LocalWorkSizeSample sample;
+    sample.key = LocalWorkSizeCacheKey(dispatchInfo);
+    Vec3<size_t> heuristicLws = {64, 1, 1};
+    auto candidatesCount = LocalWorkSizeCache::generateAutotuneCandidates(heuristicLws, sample.key.gws, 1, sample.key.maxWorkGroupSize).size();
+    ASSERT_LT(1u, candidatesCount);
+    for (size_t i = 0; i < candidatesCount - 1; i++) {
+        sample.lws = lwsCache.selectAutotuneCandidate(sample.key, heuristicLws, sample.key.maxWorkGroupSize);
+        lwsCache.reportExecutionTime(sample, 1000);
+    }
+    dispatchInfo.setLWS(lwsCache.selectAutotuneCandidate(sample.key, heuristicLws, sample.key.maxWorkGroupSize));
+
+    auto refInternalCount = kernel.mockKernel->getRefInternalCount();
+    std::unique_ptr<MockEvent<Event>> event(new MockEvent<Event>(pCmdQ.get(), CL_COMMAND_NDRANGE_KERNEL, 0, 0));
+    event->setLocalWorkSizeSample(dispatchInfo);
+    EXPECT_EQ(kernel.mockKernel, event->localWorkSizeSampleKernel);
+    EXPECT_EQ(refInternalCount + 1, kernel.mockKernel->getRefInternalCount());
+
+    auto &timeStamps = *event->getHwTimeStampNode()->tag;
+    timeStamps.ContextStartTS = 10;
+    timeStamps.ContextEndTS = 20;
+    EXPECT_TRUE(event->calcProfilingData());
+
+    EXPECT_TRUE(lwsCache.isAutotuned(sample.key));
+    EXPECT_EQ(nullptr, event->localWorkSizeSampleKernel);
+    EXPECT_EQ(refInternalCount, kernel.mockKernel->getRefInternalCount());
+}
+
+TEST_F(InternalsEventTest, givenEnqueuedLocalWorkSizeWhenSampleIsSetThenKernelIsNotTracked) {
+    MockKernelWithInternals kernel(*pDevice);
+    DispatchInfo dispatchInfo(kernel.mockKernel, 1, Vec3<size_t>(1024, 1, 1), Vec3<size_t>(64, 1, 1), Vec3<size_t>(0, 0, 0));
+
+    std::unique_ptr<MockEvent<Event>> event(new MockEvent<Event>(nullptr, CL_COMMAND_NDRANGE_KERNEL, 0, 0));
+    event->setLocalWorkSizeSample(dispatchInfo);
+    EXPECT_EQ(nullptr, event->localWorkSizeSampleKernel);
+}
+
 TEST_F(InternalsEventTest, processBlockedCommandsUnMapOperation) {
     MockEvent<Event> event(nullptr, CL_COMMAND_NDRANGE_KERNEL, 0, 0);
     const cl_queue_properties props[3] = {CL_QUEUE_PROPERTIES, 0, 0};
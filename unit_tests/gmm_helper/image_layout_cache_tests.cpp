@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/gmm_helper/gmm.h"
+#include "runtime/gmm_helper/gmm_helper.h"
+#include "runtime/gmm_helper/image_layout_cache.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_gmm.h"
+#include "unit_tests/mocks/mock_gmm_resource_info.h"
+#include "test.h"
+
+using namespace OCLRT;
+
+struct ImageLayoutCacheTests : public ::testing::Test {
+    void SetUp() override {
+        imgDesc.image_type = CL_MEM_OBJECT_IMAGE3D;
+        imgDesc.image_width = 17;
+        imgDesc.image_height = 17;
+        imgDesc.image_depth = 17;
+        layoutCache = GmmHelper::getInstance()->getImageLayoutCache();
+        ASSERT_NE(nullptr, layoutCache);
+        layoutCache->clear();
+    }
+
+    void TearDown() override {
+        layoutCache->clear();
+    }
+
+    cl_image_desc imgDesc = {};
+    ImageLayoutCache *layoutCache = nullptr;
+};
+
+TEST(ImageLayoutCacheTest, givenEmptyCacheWhenLayoutIsRequestedThenMissIsReported) {
+    ImageLayoutCache layoutCache;
+    cl_image_desc imgDesc = {};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    imgDesc.image_width = 64;
+    imgDesc.image_height = 64;
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+
+    EXPECT_FALSE(layoutCache.getLayout(imgInfo));
+    EXPECT_EQ(0u, layoutCache.getHitCount());
+    EXPECT_EQ(1u, layoutCache.getMissCount());
+    EXPECT_EQ(0u, layoutCache.getEntriesCount());
+}
+
+TEST(ImageLayoutCacheTest, givenStoredLayoutWhenLayoutForSameDescriptorIsRequestedThenStoredValuesAreReturned) {
+    ImageLayoutCache layoutCache;
+    cl_image_desc imgDesc = {};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    imgDesc.image_width = 64;
+    imgDesc.image_height = 64;
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    imgInfo.size = 0x4000;
+    imgInfo.rowPitch = 256;
+    imgInfo.slicePitch = 0x4000;
+    imgInfo.qPitch = 64;
+    layoutCache.storeLayout(imgInfo);
+
+    cl_image_desc sameImgDesc = imgDesc;
+    auto sameImgInfo = MockGmm::initImgInfo(sameImgDesc, 0, nullptr);
+    EXPECT_TRUE(layoutCache.getLayout(sameImgInfo));
+    EXPECT_EQ(imgInfo.size, sameImgInfo.size);
+    EXPECT_EQ(imgInfo.rowPitch, sameImgInfo.rowPitch);
+    EXPECT_EQ(imgInfo.slicePitch, sameImgInfo.slicePitch);
+    EXPECT_EQ(imgInfo.qPitch, sameImgInfo.qPitch);
+    EXPECT_EQ(1u, layoutCache.getHitCount());
+    EXPECT_EQ(0u, layoutCache.getMissCount());
+}
+
+TEST(ImageLayoutCacheTest, givenStoredLayoutWhenLayoutForDifferentDescriptorIsRequestedThenMissIsReported) {
+    ImageLayoutCache layoutCache;
+    cl_image_desc imgDesc = {};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    imgDesc.image_width = 64;
+    imgDesc.image_height = 64;
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    layoutCache.storeLayout(imgInfo);
+
+    cl_image_desc otherImgDesc = imgDesc;
+    otherImgDesc.image_height = 32;
+    auto otherImgInfo = MockGmm::initImgInfo(otherImgDesc, 0, nullptr);
+    EXPECT_FALSE(layoutCache.getLayout(otherImgInfo));
+
+    auto mipMappedImgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    mipMappedImgInfo.mipCount = 3;
+    EXPECT_FALSE(layoutCache.getLayout(mipMappedImgInfo));
+
+    EXPECT_EQ(0u, layoutCache.getHitCount());
+    EXPECT_EQ(2u, layoutCache.getMissCount());
+}
+
+TEST(ImageLayoutCacheTest, givenImageTypeWithoutHeightWhenKeyIsCreatedThenUnusedDimensionsAreIgnored) {
+    cl_image_desc imgDesc = {};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE1D;
+    imgDesc.image_width = 64;
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+
+    cl_image_desc otherImgDesc = imgDesc;
+    otherImgDesc.image_height = 32;
+    otherImgDesc.image_depth = 4;
+    otherImgDesc.image_array_size = 2;
+    auto otherImgInfo = MockGmm::initImgInfo(otherImgDesc, 0, nullptr);
+
+    ImageLayoutCacheKey key(imgInfo);
+    ImageLayoutCacheKey otherKey(otherImgInfo);
+    EXPECT_FALSE(key < otherKey);
+    EXPECT_FALSE(otherKey < key);
+}
+
+TEST(ImageLayoutCacheTest, givenFullCacheWhenNewLayoutIsStoredThenCacheIsTrimmed) {
+    ImageLayoutCache layoutCache;
+    cl_image_desc imgDesc = {};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE1D;
+    for (size_t i = 0; i < ImageLayoutCache::maxEntries; i++) {
+        imgDesc.image_width = i + 1;
+        auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+        layoutCache.storeLayout(imgInfo);
+    }
+    EXPECT_EQ(ImageLayoutCache::maxEntries, layoutCache.getEntriesCount());
+
+    imgDesc.image_width = ImageLayoutCache::maxEntries + 1;
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    layoutCache.storeLayout(imgInfo);
+    EXPECT_EQ(1u, layoutCache.getEntriesCount());
+}
+
+TEST_F(ImageLayoutCacheTests, givenImageQueriedTwiceWhenSecondGmmIsCreatedThenLayoutIsTakenFromCache) {
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    auto hitCount = layoutCache->getHitCount();
+    auto missCount = layoutCache->getMissCount();
+
+    auto firstGmm = MockGmm::queryImgParams(imgInfo);
+    EXPECT_EQ(missCount + 1, layoutCache->getMissCount());
+    EXPECT_NE(0u, static_cast<MockGmmResourceInfo *>(firstGmm->gmmResourceInfo.get())->getOffsetCalled);
+
+    cl_image_desc sameImgDesc = imgDesc;
+    auto cachedImgInfo = MockGmm::initImgInfo(sameImgDesc, 0, nullptr);
+    auto secondGmm = MockGmm::queryImgParams(cachedImgInfo);
+    EXPECT_EQ(hitCount + 1, layoutCache->getHitCount());
+    EXPECT_EQ(missCount + 1, layoutCache->getMissCount());
+
+    ASSERT_NE(nullptr, secondGmm->gmmResourceInfo.get());
+    EXPECT_EQ(0u, static_cast<MockGmmResourceInfo *>(secondGmm->gmmResourceInfo.get())->getOffsetCalled);
+    EXPECT_EQ(secondGmm->resourceParams.Type, GMM_RESOURCE_TYPE::RESOURCE_3D);
+
+    EXPECT_EQ(imgInfo.size, cachedImgInfo.size);
+    EXPECT_EQ(imgInfo.rowPitch, cachedImgInfo.rowPitch);
+    EXPECT_EQ(imgInfo.slicePitch, cachedImgInfo.slicePitch);
+    EXPECT_EQ(imgInfo.qPitch, cachedImgInfo.qPitch);
+}
+
+TEST_F(ImageLayoutCacheTests, givenCachedLayoutWhenImageLayoutIsQueriedThenGmmResourceIsNotCreated) {
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    auto gmm = MockGmm::queryImgParams(imgInfo);
+    EXPECT_EQ(1u, layoutCache->getEntriesCount());
+
+    cl_image_desc sameImgDesc = imgDesc;
+    auto queriedImgInfo = MockGmm::initImgInfo(sameImgDesc, 0, nullptr);
+    auto hitCount = layoutCache->getHitCount();
+    Gmm::queryImageLayout(queriedImgInfo);
+    EXPECT_EQ(hitCount + 1, layoutCache->getHitCount());
+    EXPECT_EQ(imgInfo.size, queriedImgInfo.size);
+    EXPECT_EQ(imgInfo.rowPitch, queriedImgInfo.rowPitch);
+    EXPECT_EQ(imgInfo.slicePitch, queriedImgInfo.slicePitch);
+}
+
+TEST_F(ImageLayoutCacheTests, givenEmptyCacheWhenImageLayoutIsQueriedThenLayoutIsStored) {
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    Gmm::queryImageLayout(imgInfo);
+    EXPECT_EQ(1u, layoutCache->getEntriesCount());
+    EXPECT_NE(0u, imgInfo.size);
+
+    cl_image_desc invalidImgDesc = {};
+    invalidImgDesc.image_width = 10;
+    auto invalidImgInfo = MockGmm::initImgInfo(invalidImgDesc, 0, nullptr);
+    Gmm::queryImageLayout(invalidImgInfo);
+    EXPECT_EQ(1u, layoutCache->getEntriesCount());
+    EXPECT_EQ(0u, invalidImgInfo.size);
+}
+
+TEST_F(ImageLayoutCacheTests, givenForceLinearImagesWhenSameDescriptorIsQueriedThenCachedTiledLayoutIsNotUsed) {
+    DebugManagerStateRestore restore;
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    auto tiledGmm = MockGmm::queryImgParams(imgInfo);
+
+    DebugManager.flags.ForceLinearImages.set(true);
+    cl_image_desc sameImgDesc = imgDesc;
+    auto linearImgInfo = MockGmm::initImgInfo(sameImgDesc, 0, nullptr);
+    auto hitCount = layoutCache->getHitCount();
+    auto linearGmm = MockGmm::queryImgParams(linearImgInfo);
+    EXPECT_EQ(hitCount, layoutCache->getHitCount());
+    EXPECT_EQ(2u, layoutCache->getEntriesCount());
+}
+
+TEST_F(ImageLayoutCacheTests, givenImageLayoutCacheDisabledWhenImageIsQueriedTwiceThenGmmIsQueriedEachTime) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.EnableImageLayoutCache.set(false);
+    EXPECT_EQ(nullptr, GmmHelper::getInstance()->getImageLayoutCache());
+
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    auto firstGmm = MockGmm::queryImgParams(imgInfo);
+    cl_image_desc sameImgDesc = imgDesc;
+    auto secondImgInfo = MockGmm::initImgInfo(sameImgDesc, 0, nullptr);
+    auto secondGmm = MockGmm::queryImgParams(secondImgInfo);
+
+    EXPECT_NE(0u, static_cast<MockGmmResourceInfo *>(secondGmm->gmmResourceInfo.get())->getOffsetCalled);
+    EXPECT_EQ(0u, layoutCache->getEntriesCount());
+    EXPECT_EQ(imgInfo.size, secondImgInfo.size);
+}
@@ -33,14 +33,17 @@
 #include "unit_tests/program/program_tests.h"
 #include "test.h"
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
 #include <deque>
+#include <memory>
 #include <vector>
 
 using namespace OCLRT;
 using namespace gtpin;
 
 namespace OCLRT {
-extern std::deque<gtpinkexec_t> kernelExecQueue;
+extern std::vector<std::shared_ptr<GTPinQueueKernelExecs>> queueKernelExecs;
 }
 
 namespace ULT {
@@ -1480,6 +1483,8 @@ TEST_F(GTPinTests, givenMultipleKernelSubmissionsWhenOneOfGtpinSurfacesIsNullThe
     returnNullResource = true;
 
     auto pCmdQueue = castToObject<CommandQueue>(cmdQ);
+    ASSERT_NE(nullptr, pCmdQueue->gtpinKernelExecs);
+    auto &kernelExecQueue = pCmdQueue->gtpinKernelExecs->kernelExecs;
 
     gtpinNotifyKernelSubmit(pKernel1, pCmdQueue);
     EXPECT_EQ(nullptr, kernelExecQueue[0].gtpinResource);
@@ -1550,7 +1555,7 @@ TEST_F(GTPinTests, givenInitializedGTPinInterfaceWhenKernelIsCreatedThenAllKerne
     retFromGtPin = GTPin_Init(&gtpinCallbacks, &driverServices, nullptr);
     EXPECT_EQ(GTPIN_DI_SUCCESS, retFromGtPin);
 
-    kernelExecQueue.clear();
+    queueKernelExecs.clear();
 
     cl_kernel kernel = nullptr;
     cl_program pProgram = nullptr;
@@ -1604,6 +1609,8 @@ TEST_F(GTPinTests, givenInitializedGTPinInterfaceWhenKernelIsCreatedThenAllKerne
     // Simulate that created kernel was sent for execution
     auto pKernel = castToObject<Kernel>(kernel);
     auto pCmdQueue = castToObject<CommandQueue>(cmdQ);
+    ASSERT_NE(nullptr, pCmdQueue->gtpinKernelExecs);
+    auto &kernelExecQueue = pCmdQueue->gtpinKernelExecs->kernelExecs;
     ASSERT_NE(nullptr, pKernel);
     EXPECT_EQ(0u, kernelExecQueue.size());
     EXPECT_EQ(0u, kernelResources.size());
@@ -1733,6 +1740,241 @@ TEST_F(GTPinTests, givenInitializedGTPinInterfaceWhenKernelIsCreatedThenAllKerne
     EXPECT_EQ(CL_SUCCESS, retVal);
 }
 
+TEST_F(GTPinTests, givenThousandsOfKernelsInFlightWhenTheyAreFlushedAndCompletedThenCommandBuffersAreCompletedInSubmissionOrder) {
+    gtpinCallbacks.onContextCreate = OnContextCreate;
+    gtpinCallbacks.onContextDestroy = OnContextDestroy;
+    gtpinCallbacks.onKernelCreate = OnKernelCreate;
+    gtpinCallbacks.onKernelSubmit = OnKernelSubmit;
+    gtpinCallbacks.onCommandBufferCreate = OnCommandBufferCreate;
+    gtpinCallbacks.onCommandBufferComplete = OnCommandBufferComplete;
+    retFromGtPin = GTPin_Init(&gtpinCallbacks, &driverServices, nullptr);
+    EXPECT_EQ(GTPIN_DI_SUCCESS, retFromGtPin);
+
+    queueKernelExecs.clear();
+
+    cl_kernel kernel = nullptr;
+    cl_program pProgram = nullptr;
+    cl_device_id device = (cl_device_id)pDevice;
+    void *pSource = nullptr;
+    size_t sourceSize = 0;
+    std::string testFile;
+    cl_command_queue cmdQ = nullptr;
+    cl_queue_properties properties = 0;
+    cl_context context = nullptr;
+
+    KernelBinaryHelper kbHelper("CopyBuffer_simd8", false);
+    testFile.append(clFiles);
+    testFile.append("CopyBuffer_simd8.cl");
+    sourceSize = loadDataFromFile(testFile.c_str(), pSource);
+    EXPECT_NE(0u, sourceSize);
+    EXPECT_NE(nullptr, pSource);
+
+    context = clCreateContext(nullptr, 1, &device, nullptr, nullptr, &retVal);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_NE(nullptr, context);
+
+    cmdQ = clCreateCommandQueue(context, device, properties, &retVal);
+    ASSERT_NE(nullptr, cmdQ);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    pProgram = clCreateProgramWithSource(
+        context,
+        1,
+        (const char **)&pSource,
+        &sourceSize,
+        &retVal);
+    ASSERT_NE(nullptr, pProgram);
+
+    retVal = clBuildProgram(
+        pProgram,
+        1,
+        &device,
+        nullptr,
+        nullptr,
+        nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    kernel = clCreateKernel(pProgram, "CopyBuffer", &retVal);
+    ASSERT_NE(nullptr, kernel);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    auto pKernel = castToObject<Kernel>(kernel);
+    auto pCmdQueue = castToObject<CommandQueue>(cmdQ);
+    ASSERT_NE(nullptr, pCmdQueue->gtpinKernelExecs);
+    auto &kernelExecQueue = pCmdQueue->gtpinKernelExecs->kernelExecs;
+    EXPECT_EQ(0u, kernelExecQueue.size());
+    EXPECT_EQ(0u, kernelResources.size());
+
+    constexpr uint32_t kernelsInFlight = 4096;
+    constexpr uint32_t completionStep = 64;
+    int prevCreateCount = CommandBufferCreateCallbackCount;
+    int prevSubmitCount = KernelSubmitCallbackCount;
+    int prevCompleteCount = CommandBufferCompleteCallbackCount;
+    std::vector<Surface *> residencyVector;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < kernelsInFlight; i++) {
+        gtpinNotifyKernelSubmit(kernel, pCmdQueue);
+    }
+    for (uint32_t i = 0; i < kernelsInFlight; i++) {
+        gtpinNotifyUpdateResidencyList(pKernel, &residencyVector);
+        gtpinNotifyPreFlushTask(pCmdQueue);
+        gtpinNotifyFlushTask(i + 1);
+    }
+    EXPECT_EQ(kernelsInFlight, kernelExecQueue.size());
+    EXPECT_EQ(kernelsInFlight, residencyVector.size());
+    EXPECT_TRUE(kernelExecQueue.back().isResourceResident);
+    EXPECT_EQ(kernelsInFlight, kernelExecQueue.back().taskCount);
+
+    for (uint32_t completed = completionStep; completed <= kernelsInFlight; completed += completionStep) {
+        gtpinNotifyTaskCompletion(completed);
+        EXPECT_EQ(kernelsInFlight - completed, kernelExecQueue.size());
+        EXPECT_EQ(kernelsInFlight - completed, kernelResources.size());
+    }
+    auto trackingTime = std::chrono::high_resolution_clock::now() - start;
+    RecordProperty("kernelsInFlight", static_cast<int>(kernelsInFlight));
+    RecordProperty("trackingTimeUs", static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(trackingTime).count()));
+
+    EXPECT_EQ(prevCreateCount + static_cast<int>(kernelsInFlight), CommandBufferCreateCallbackCount);
+    EXPECT_EQ(prevSubmitCount + static_cast<int>(kernelsInFlight), KernelSubmitCallbackCount);
+    EXPECT_EQ(prevCompleteCount + static_cast<int>(kernelsInFlight), CommandBufferCompleteCallbackCount);
+
+    // Cleanup
+    for (auto pSurface : residencyVector) {
+        delete pSurface;
+    }
+    retVal = clReleaseKernel(kernel);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    retVal = clReleaseProgram(pProgram);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    deleteDataReadFromFile(pSource);
+
+    retVal = clReleaseCommandQueue(cmdQ);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    retVal = clReleaseContext(context);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+}
+
+TEST_F(GTPinTests, givenReleasedCommandQueueWithFlushedKernelsWhenTheyCompleteThenItsRecordsAreDropped) {
+    gtpinCallbacks.onContextCreate = OnContextCreate;
+    gtpinCallbacks.onContextDestroy = OnContextDestroy;
+    gtpinCallbacks.onKernelCreate = OnKernelCreate;
+    gtpinCallbacks.onKernelSubmit = OnKernelSubmit;
+    gtpinCallbacks.onCommandBufferCreate = OnCommandBufferCreate;
+    gtpinCallbacks.onCommandBufferComplete = OnCommandBufferComplete;
+    retFromGtPin = GTPin_Init(&gtpinCallbacks, &driverServices, nullptr);
+    EXPECT_EQ(GTPIN_DI_SUCCESS, retFromGtPin);
+
+    queueKernelExecs.clear();
+
+    cl_kernel kernel = nullptr;
+    cl_program pProgram = nullptr;
+    cl_device_id device = (cl_device_id)pDevice;
+    void *pSource = nullptr;
+    size_t sourceSize = 0;
+    std::string testFile;
+    cl_command_queue cmdQ = nullptr;
+    cl_queue_properties properties = 0;
+    cl_context context = nullptr;
+
+    KernelBinaryHelper kbHelper("CopyBuffer_simd8", false);
+    testFile.append(clFiles);
+    testFile.append("CopyBuffer_simd8.cl");
+    sourceSize = loadDataFromFile(testFile.c_str(), pSource);
+    EXPECT_NE(0u, sourceSize);
+    EXPECT_NE(nullptr, pSource);
+
+    context = clCreateContext(nullptr, 1, &device, nullptr, nullptr, &retVal);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_NE(nullptr, context);
+
+    cmdQ = clCreateCommandQueue(context, device, properties, &retVal);
+    ASSERT_NE(nullptr, cmdQ);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    pProgram = clCreateProgramWithSource(
+        context,
+        1,
+        (const char **)&pSource,
+        &sourceSize,
+        &retVal);
+    ASSERT_NE(nullptr, pProgram);
+
+    retVal = clBuildProgram(
+        pProgram,
+        1,
+        &device,
+        nullptr,
+        nullptr,
+        nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    kernel = clCreateKernel(pProgram, "CopyBuffer", &retVal);
+    ASSERT_NE(nullptr, kernel);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    auto pCmdQueue = castToObject<CommandQueue>(cmdQ);
+    ASSERT_NE(nullptr, pCmdQueue->gtpinKernelExecs);
+    // Special queue of the context has its records too
+    auto recordsCount = queueKernelExecs.size();
+    int prevCompleteCount = CommandBufferCompleteCallbackCount;
+
+    gtpinNotifyKernelSubmit(kernel, pCmdQueue);
+    gtpinNotifyKernelSubmit(kernel, pCmdQueue);
+    gtpinNotifyPreFlushTask(pCmdQueue);
+    gtpinNotifyFlushTask(1);
+    EXPECT_EQ(2u, pCmdQueue->gtpinKernelExecs->kernelExecs.size());
+    EXPECT_EQ(2u, kernelResources.size());
+
+    // Second kernel is never flushed, so its command buffer is not completed
+    cl_mem unflushedBuffer = pCmdQueue->gtpinKernelExecs->kernelExecs[1].gtpinResource;
+    gtpinUnmapBuffer(reinterpret_cast<context_handle_t>(context), reinterpret_cast<resource_handle_t>(unflushedBuffer));
+    gtpinFreeBuffer(reinterpret_cast<context_handle_t>(context), reinterpret_cast<resource_handle_t>(unflushedBuffer));
+    kernelResources.pop_back();
+
+    auto releasedRecords = pCmdQueue->gtpinKernelExecs;
+    retVal = clReleaseCommandQueue(cmdQ);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(recordsCount, queueKernelExecs.size());
+    EXPECT_NE(queueKernelExecs.end(), std::find(queueKernelExecs.begin(), queueKernelExecs.end(), releasedRecords));
+    EXPECT_TRUE(releasedRecords->queueReleased);
+    EXPECT_EQ(1u, releasedRecords->kernelExecs.size());
+
+    cmdQ = clCreateCommandQueue(context, device, properties, &retVal);
+    ASSERT_NE(nullptr, cmdQ);
+    pCmdQueue = castToObject<CommandQueue>(cmdQ);
+    ASSERT_NE(nullptr, pCmdQueue->gtpinKernelExecs);
+    EXPECT_NE(releasedRecords, pCmdQueue->gtpinKernelExecs);
+    EXPECT_EQ(0u, pCmdQueue->gtpinKernelExecs->kernelExecs.size());
+    EXPECT_EQ(recordsCount + 1, queueKernelExecs.size());
+
+    gtpinNotifyTaskCompletion(1);
+    EXPECT_EQ(prevCompleteCount + 1, CommandBufferCompleteCallbackCount);
+    EXPECT_EQ(0u, kernelResources.size());
+    EXPECT_EQ(recordsCount, queueKernelExecs.size());
+    EXPECT_EQ(queueKernelExecs.end(), std::find(queueKernelExecs.begin(), queueKernelExecs.end(), releasedRecords));
+    releasedRecords.reset();
+
+    // Cleanup
+    retVal = clReleaseKernel(kernel);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    retVal = clReleaseProgram(pProgram);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    deleteDataReadFromFile(pSource);
+
+    retVal = clReleaseCommandQueue(cmdQ);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(recordsCount - 1, queueKernelExecs.size());
+
+    retVal = clReleaseContext(context);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+}
+
 TEST_F(GTPinTests, givenInitializedGTPinInterfaceWhenOneKernelIsSubmittedSeveralTimesThenCorrectBuffersAreMadeResident) {
     gtpinCallbacks.onContextCreate = OnContextCreate;
     gtpinCallbacks.onContextDestroy = OnContextDestroy;
@@ -1743,7 +1985,7 @@ TEST_F(GTPinTests, givenInitializedGTPinInterfaceWhenOneKernelIsSubmittedSeveral
     retFromGtPin = GTPin_Init(&gtpinCallbacks, &driverServices, nullptr);
     EXPECT_EQ(GTPIN_DI_SUCCESS, retFromGtPin);
 
-    kernelExecQueue.clear();
+    queueKernelExecs.clear();
 
     cl_kernel kernel = nullptr;
     cl_program pProgram = nullptr;
@@ -1797,6 +2039,8 @@ TEST_F(GTPinTests, givenInitializedGTPinInterfaceWhenOneKernelIsSubmittedSeveral
     // Simulate that created kernel was sent for execution two times in a row
     auto pKernel = castToObject<Kernel>(kernel);
     auto pCmdQueue = castToObject<CommandQueue>(cmdQ);
+    ASSERT_NE(nullptr, pCmdQueue->gtpinKernelExecs);
+    auto &kernelExecQueue = pCmdQueue->gtpinKernelExecs->kernelExecs;
     ASSERT_NE(nullptr, pKernel);
     EXPECT_EQ(0u, kernelExecQueue.size());
     EXPECT_EQ(0u, kernelResources.size());
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/helpers/cpu_copy.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace {
+std::vector<uint8_t> createPattern(size_t size) {
+    std::vector<uint8_t> pattern(size);
+    for (size_t i = 0; i < size; i++) {
+        pattern[i] = static_cast<uint8_t>(i * 7 + i / 251);
+    }
+    return pattern;
+}
+} // namespace
+
+TEST(CpuCopyTest, givenDefaultSettingsWhenThresholdsAreQueriedThenDefaultValuesAreReturned) {
+    EXPECT_EQ(CpuCopy::defaultNonTemporalThreshold, CpuCopy::getNonTemporalThreshold());
+    EXPECT_EQ(CpuCopy::defaultMultithreadThreshold, CpuCopy::getMultithreadThreshold());
+    EXPECT_LE(1u, CpuCopy::getMaxThreads());
+    EXPECT_GE(CpuCopy::defaultMaxThreads, CpuCopy::getMaxThreads());
+}
+
+TEST(CpuCopyTest, givenDebugVariablesSetWhenThresholdsAreQueriedThenOverriddenValuesAreReturned) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.CpuCopyNonTemporalThresholdKB.set(0);
+    DebugManager.flags.CpuCopyMultithreadThresholdKB.set(64);
+    DebugManager.flags.CpuCopyMaxThreads.set(3);
+
+    EXPECT_EQ(0u, CpuCopy::getNonTemporalThreshold());
+    EXPECT_EQ(64u * 1024, CpuCopy::getMultithreadThreshold());
+    EXPECT_EQ(3u, CpuCopy::getMaxThreads());
+}
+
+TEST(CpuCopyTest, givenCopySizeWhenThreadsCountIsQueriedThenItDependsOnThresholdAndMaxThreads) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.CpuCopyMultithreadThresholdKB.set(1024);
+    DebugManager.flags.CpuCopyMaxThreads.set(4);
+
+    EXPECT_EQ(1u, CpuCopy::getThreadsCount(1024 * 1024 - 1));
+    EXPECT_EQ(1u, CpuCopy::getThreadsCount(1024 * 1024));
+    EXPECT_EQ(3u, CpuCopy::getThreadsCount(3 * CpuCopy::minBytesPerThread));
+    EXPECT_EQ(4u, CpuCopy::getThreadsCount(64 * CpuCopy::minBytesPerThread));
+
+    DebugManager.flags.CpuCopyMultithreadThresholdKB.set(0);
+    EXPECT_EQ(1u, CpuCopy::getThreadsCount(64 * CpuCopy::minBytesPerThread));
+}
+
+TEST(CpuCopyTest, givenUnalignedPointersAndSizesWhenNonTemporalCopyIsMadeThenAllBytesAreCopied) {
+    auto src = createPattern(1024);
+    for (size_t dstOffset = 0; dstOffset < 16; dstOffset += 3) {
+        for (size_t srcOffset = 0; srcOffset < 16; srcOffset += 5) {
+            for (size_t size : {0u, 1u, 15u, 16u, 63u, 64u, 65u, 200u, 777u}) {
+                std::vector<uint8_t> dst(1024, 0xcd);
+                CpuCopy::copyNonTemporal(dst.data() + dstOffset, src.data() + srcOffset, size);
+
+                EXPECT_EQ(0, memcmp(dst.data() + dstOffset, src.data() + srcOffset, size));
+                for (size_t i = 0; i < dstOffset; i++) {
+                    EXPECT_EQ(0xcd, dst[i]);
+                }
+                for (size_t i = dstOffset + size; i < dst.size(); i++) {
+                    EXPECT_EQ(0xcd, dst[i]);
+                }
+            }
+        }
+    }
+}
+
+TEST(CpuCopyTest, givenCopyAboveMultithreadThresholdWhenCopyIsMadeThenAllBytesAreCopiedExactlyOnce) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.CpuCopyMultithreadThresholdKB.set(1);
+    DebugManager.flags.CpuCopyNonTemporalThresholdKB.set(1);
+    DebugManager.flags.CpuCopyMaxThreads.set(3);
+
+    size_t size = 3 * CpuCopy::minBytesPerThread + 13;
+    auto src = createPattern(size + 1);
+    std::vector<uint8_t> dst(size + 2, 0xcd);
+
+    CpuCopy::copy(dst.data() + 1, src.data() + 1, size);
+
+    EXPECT_EQ(0xcd, dst[0]);
+    EXPECT_EQ(0, memcmp(dst.data() + 1, src.data() + 1, size));
+    EXPECT_EQ(0xcd, dst[size + 1]);
+}
+
+TEST(CpuCopyTest, givenNullPointersWhenCopyIsMadeThenNothingIsCopied) {
+    uint8_t data[4] = {1, 2, 3, 4};
+    CpuCopy::copy(nullptr, data, sizeof(data));
+    CpuCopy::copy(data, nullptr, sizeof(data));
+    CpuCopy::copyRegion(nullptr, 4, 4, data, 4, 4, 4, 1, 1);
+    EXPECT_EQ(1u, data[0]);
+}
+
+TEST(CpuCopyTest, givenPitchedRegionWhenRegionIsCopiedThenOnlyRowsWithinRegionAreWritten) {
+    const size_t srcRowPitch = 48, srcSlicePitch = srcRowPitch * 5;
+    const size_t dstRowPitch = 40, dstSlicePitch = dstRowPitch * 6;
+    const size_t rowSize = 33, rowsCount = 4, slicesCount = 3;
+
+    auto src = createPattern(srcSlicePitch * slicesCount);
+    std::vector<uint8_t> dst(dstSlicePitch * slicesCount, 0xcd);
+
+    CpuCopy::copyRegion(dst.data(), dstRowPitch, dstSlicePitch, src.data(), srcRowPitch, srcSlicePitch, rowSize, rowsCount, slicesCount);
+
+    for (size_t slice = 0; slice < slicesCount; slice++) {
+        for (size_t row = 0; row < dstSlicePitch / dstRowPitch; row++) {
+            auto dstRow = dst.data() + slice * dstSlicePitch + row * dstRowPitch;
+            for (size_t x = 0; x < dstRowPitch; x++) {
+                if (row < rowsCount && x < rowSize) {
+                    EXPECT_EQ(src[slice * srcSlicePitch + row * srcRowPitch + x], dstRow[x]);
+                } else {
+                    EXPECT_EQ(0xcd, dstRow[x]);
+                }
+            }
+        }
+    }
+}
+
+TEST(CpuCopyTest, givenDenseRegionAboveMultithreadThresholdWhenRegionIsCopiedThenWholeRegionIsCopied) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.CpuCopyMultithreadThresholdKB.set(1);
+    DebugManager.flags.CpuCopyMaxThreads.set(4);
+
+    const size_t rowSize = 4096, rowsCount = 512, slicesCount = 2;
+    auto src = createPattern(rowSize * rowsCount * slicesCount);
+    std::vector<uint8_t> dst(src.size(), 0);
+
+    CpuCopy::copyRegion(dst.data(), rowSize, rowSize * rowsCount, src.data(), rowSize, rowSize * rowsCount, rowSize, rowsCount, slicesCount);
+    EXPECT_EQ(src, dst);
+}
+
+TEST(CpuCopyTest, givenPitchedRegionAboveMultithreadThresholdWhenRegionIsCopiedThenRowsAreSplitAcrossThreads) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.CpuCopyMultithreadThresholdKB.set(1);
+    DebugManager.flags.CpuCopyMaxThreads.set(4);
+
+    const size_t rowSize = 4000, rowPitch = 4096, rowsCount = 300, slicesCount = 3;
+    auto src = createPattern(rowPitch * rowsCount * slicesCount);
+    std::vector<uint8_t> dst(src.size(), 0xcd);
+
+    CpuCopy::copyRegion(dst.data(), rowPitch, rowPitch * rowsCount, src.data(), rowPitch, rowPitch * rowsCount, rowSize, rowsCount, slicesCount);
+
+    for (size_t row = 0; row < rowsCount * slicesCount; row++) {
+        EXPECT_EQ(0, memcmp(dst.data() + row * rowPitch, src.data() + row * rowPitch, rowSize));
+        EXPECT_EQ(0xcd, dst[row * rowPitch + rowSize]);
+    }
+}
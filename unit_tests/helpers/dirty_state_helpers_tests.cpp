@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -10,6 +10,7 @@
 #include "runtime/indirect_heap/indirect_heap.h"
 #include "runtime/memory_manager/graphics_allocation.h"
 #include "gtest/gtest.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/mocks/mock_graphics_allocation.h"
 #include <memory>
 
@@ -93,6 +94,22 @@ TEST_F(HeapDirtyStateTests, givenNonDirtyObjectWhenSizeChangedThenReturnDirty) {
     EXPECT_EQ(castToUint64(buffer), mockHeapDirtyState.gpuBaseAddress);
 }
 
+TEST_F(HeapDirtyStateTests, givenHeapBaseAddressReuseWhenHeapShrinksAtTheSameBaseThenReturnNotDirtyAndKeepProgrammedSize) {
+    DebugManagerStateRestore restore;
+    auto largeBufferSize = bufferSize + MemoryConstants::pageSize;
+    stream->replaceBuffer(stream->getCpuBase(), largeBufferSize);
+    EXPECT_TRUE(mockHeapDirtyState.updateAndCheck(stream.get()));
+
+    DebugManager.flags.EnableHeapBaseAddressReuse.set(true);
+    stream->replaceBuffer(stream->getCpuBase(), bufferSize);
+    EXPECT_FALSE(mockHeapDirtyState.updateAndCheck(stream.get()));
+    EXPECT_EQ(getSizeInPages(largeBufferSize), mockHeapDirtyState.sizeInPages);
+
+    DebugManager.flags.EnableHeapBaseAddressReuse.set(false);
+    EXPECT_TRUE(mockHeapDirtyState.updateAndCheck(stream.get()));
+    EXPECT_EQ(getSizeInPages(bufferSize), mockHeapDirtyState.sizeInPages);
+}
+
 TEST_F(HeapDirtyStateTests, givenNonDirtyObjectWhenSizeAndBufferChangedThenReturnDirty) {
     EXPECT_TRUE(mockHeapDirtyState.updateAndCheck(stream.get()));
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -127,6 +127,24 @@ HWTEST_F(KmdNotifyTests, givenNotReadyTaskCountWhenWaitUntilCompletionCalledThen
     EXPECT_THROW(cmdQ->waitUntilComplete(taskCountToWait, flushStampToWait, false), std::exception);
 }
 
+HWTEST_F(KmdNotifyTests, givenTimedOutKmdWaitWhenWaitUntilCompletionCalledThenTagIsPolledBeforeNextKmdWait) {
+    auto csr = createMockCsr<FamilyType>();
+    *csr->getTagAddress() = taskCountToWait - 1;
+
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(false, ::testing::_, ::testing::_)).Times(0);
+    ::testing::InSequence is;
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, 2, taskCountToWait)).Times(1).WillOnce(::testing::Return(false));
+    EXPECT_CALL(*csr, waitForFlushStamp(flushStampToWait)).Times(1).WillOnce(::testing::Return(false));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, 2, taskCountToWait)).Times(1).WillOnce(::testing::Return(false));
+    EXPECT_CALL(*csr, waitForFlushStamp(flushStampToWait)).Times(1).WillOnce(::testing::Return(false));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, 2, taskCountToWait)).Times(1).WillOnce(::testing::Invoke([&](bool, int64_t, uint32_t) {
+        *csr->getTagAddress() = taskCountToWait;
+        return true;
+    }));
+
+    cmdQ->waitUntilComplete(taskCountToWait, flushStampToWait, false);
+}
+
 HWTEST_F(KmdNotifyTests, givenReadyTaskCountWhenWaitUntilCompletionCalledThenTryCpuPollingAndDontCallKmdWait) {
     auto csr = createMockCsr<FamilyType>();
 
@@ -158,6 +158,21 @@ TEST_F(TimestampPacketSimpleTests, givenImplicitDependencyWhenEndTagIsWrittenThe
     EXPECT_TRUE(timestampPacket.canBeReleased());
 }
 
+TEST_F(TimestampPacketSimpleTests, givenCompletedOrAlreadyWaitedPacketWhenAskedForSemaphoreThenItIsNotRequired) {
+    MockTimestampPacket timestampPacket;
+    MockTimestampPacket completedTimestampPacket;
+    completedTimestampPacket.data[static_cast<uint32_t>(TimestampPacket::DataIndex::ContextEnd)] = 0;
+    TimestampPacketHelper::WaitedPackets waitedPackets;
+
+    EXPECT_FALSE(timestampPacket.isCompleted());
+    EXPECT_TRUE(completedTimestampPacket.isCompleted());
+
+    EXPECT_FALSE(TimestampPacketHelper::isSemaphoreRequired(completedTimestampPacket, waitedPackets));
+    EXPECT_TRUE(TimestampPacketHelper::isSemaphoreRequired(timestampPacket, waitedPackets));
+    EXPECT_FALSE(TimestampPacketHelper::isSemaphoreRequired(timestampPacket, waitedPackets));
+    EXPECT_EQ(1u, waitedPackets.size());
+}
+
 TEST_F(TimestampPacketSimpleTests, whenNewTagIsTakenThenReinitialize) {
     MockMemoryManager memoryManager;
     MockTagAllocator<MockTimestampPacket> allocator(&memoryManager, 1);
@@ -606,6 +621,62 @@ HWTEST_F(TimestampPacketTests, givenTimestampPacketWriteEnabledWhenDispatchingTh
     EXPECT_EQ(3u, semaphoresFound); // total number of semaphores found in cmdList
 }
 
+HWTEST_F(TimestampPacketTests, givenCompletedAndDuplicatedDependenciesWhenDispatchingThenSemaphoresAreProgrammedOnlyForPendingPackets) {
+    using MI_SEMAPHORE_WAIT = typename FamilyType::MI_SEMAPHORE_WAIT;
+    using MI_ATOMIC = typename FamilyType::MI_ATOMIC;
+    device->getUltCommandStreamReceiver<FamilyType>().timestampPacketWriteEnabled = true;
+
+    MockMultiDispatchInfo multiDispatchInfo(std::vector<Kernel *>({kernel->mockKernel}));
+    auto &cmdStream = mockCmdQ->getCS(0);
+
+    MockTimestampPacketContainer timestamp1(*device->getCommandStreamReceiver().getTimestampPacketAllocator(), 2);
+    MockTimestampPacketContainer timestamp2(*device->getCommandStreamReceiver().getTimestampPacketAllocator(), 1);
+    setTagToReadyState(timestamp1.getNode(1)->tag);
+
+    Event event1(mockCmdQ.get(), 0, 0, 0);
+    event1.addTimestampPacketNodes(timestamp1);
+    Event event2(mockCmdQ.get(), 0, 0, 0);
+    event2.addTimestampPacketNodes(timestamp2);
+    Event event3(mockCmdQ.get(), 0, 0, 0);
+    event3.addTimestampPacketNodes(timestamp2);
+    TimestampPacketContainer previousNodes;
+    previousNodes.assignAndIncrementNodesRefCounts(timestamp2);
+
+    cl_event waitlist[] = {&event1, &event2, &event3};
+
+    HardwareInterface<FamilyType>::dispatchWalker(
+        *mockCmdQ,
+        multiDispatchInfo,
+        3,
+        waitlist,
+        nullptr,
+        nullptr,
+        nullptr,
+        &previousNodes,
+        nullptr,
+        device->getPreemptionMode(),
+        false);
+
+    HardwareParse hwParser;
+    hwParser.parseCommands<FamilyType>(cmdStream, 0);
+
+    std::vector<MI_SEMAPHORE_WAIT *> semaphores;
+    uint32_t atomicsFound = 0;
+    for (auto it = hwParser.cmdList.begin(); it != hwParser.cmdList.end(); it++) {
+        if (auto semaphoreCmd = genCmdCast<MI_SEMAPHORE_WAIT *>(*it)) {
+            semaphores.push_back(semaphoreCmd);
+        }
+        if (genCmdCast<MI_ATOMIC *>(*it)) {
+            atomicsFound++;
+        }
+    }
+    ASSERT_EQ(2u, semaphores.size());
+    EXPECT_EQ(2u, atomicsFound);
+    verifySemaphore(semaphores[0], timestamp1.getNode(0)->tag);
+    verifySemaphore(semaphores[1], timestamp2.getNode(0)->tag);
+    verifyDependencyCounterValues(&timestamp2, 1);
+}
+
 HWTEST_F(TimestampPacketTests, givenAlreadyAssignedNodeWhenEnqueueingNonBlockedThenMakeItResident) {
     auto mockTagAllocator = new MockTagAllocator<>(executionEnvironment.memoryManager.get(), 1);
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -1948,6 +1948,36 @@ TEST_F(ReflectionSurfaceTestForPrintfHandler, PatchReflectionSurfaceDoesNotPatch
     delete parentKernel;
 }
 
+TEST_F(ReflectionSurfaceTestForPrintfHandler, givenBlocksCurbePatchedWhenReflectionSurfaceIsPatchedWithSameSurfacesThenBlocksCurbeIsNotRepatched) {
+    DebugManagerStateRestore dbgRestorer;
+    MockContext context(device);
+    cl_queue_properties properties[3] = {0};
+    std::unique_ptr<MockParentKernel> parentKernel(MockParentKernel::create(context));
+
+    DeviceQueue devQueue(&context, device, properties[0]);
+    parentKernel->createReflectionSurface();
+    context.setDefaultDeviceQueue(&devQueue);
+
+    parentKernel->patchReflectionSurface<true>(&devQueue, nullptr);
+    EXPECT_EQ(devQueue.getEventPoolBuffer()->getGpuAddress(), MockKernel::ReflectionSurfaceHelperPublic::eventPool.address);
+
+    MockKernel::ReflectionSurfaceHelperPublic::eventPool.address = 0;
+    parentKernel->patchReflectionSurface<true>(&devQueue, nullptr);
+    EXPECT_EQ(0u, MockKernel::ReflectionSurfaceHelperPublic::eventPool.address);
+
+    MockMultiDispatchInfo multiDispatchInfo(parentKernel.get());
+    std::unique_ptr<PrintfHandler> printfHandler(PrintfHandler::create(multiDispatchInfo, *device));
+    printfHandler->prepareDispatch(multiDispatchInfo);
+    parentKernel->patchReflectionSurface<true>(&devQueue, printfHandler.get());
+    EXPECT_EQ(devQueue.getEventPoolBuffer()->getGpuAddress(), MockKernel::ReflectionSurfaceHelperPublic::eventPool.address);
+    EXPECT_EQ(printfHandler->getSurface()->getGpuAddress(), MockKernel::ReflectionSurfaceHelperPublic::printfBuffer.address);
+
+    DebugManager.flags.EnableBlockCurbePatchReuse.set(false);
+    MockKernel::ReflectionSurfaceHelperPublic::eventPool.address = 0;
+    parentKernel->patchReflectionSurface<true>(&devQueue, printfHandler.get());
+    EXPECT_EQ(devQueue.getEventPoolBuffer()->getGpuAddress(), MockKernel::ReflectionSurfaceHelperPublic::eventPool.address);
+}
+
 class ReflectionSurfaceConstantValuesPatchingTest : public DeviceFixture,
                                                     public ::testing::Test {
   public:
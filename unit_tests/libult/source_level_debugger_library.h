@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -54,6 +54,10 @@ class DebuggerLibrary : public OCLRT::OsLibrary {
         return true;
     }
 
+    std::string getFullPath() override {
+        return std::string();
+    }
+
     static void setDebuggerActive(bool active) {
         debuggerActive = active;
     }
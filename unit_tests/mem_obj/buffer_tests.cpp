@@ -62,6 +62,29 @@ TEST(Buffer, givenBufferWhenAskedForPtrLengthThenReturnCorrectValue) {
     EXPECT_EQ(size[0], retOffset);
 }
 
+TEST(Buffer, givenSvmSmallAllocationCarvedOutOfSlabWhenBufferIsCreatedWithUseHostPtrThenSlabIsNotUsedAsBufferStorage) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.SVMSmallAllocationThreshold.set(256);
+    MockContext ctx;
+    auto svmManager = ctx.getSVMAllocsManager();
+    auto firstPtr = svmManager->createSVMAlloc(64, false, false);
+    auto secondPtr = svmManager->createSVMAlloc(64, false, false);
+    ASSERT_NE(nullptr, firstPtr);
+    ASSERT_NE(nullptr, secondPtr);
+    auto slab = svmManager->getSVMAlloc(secondPtr);
+    ASSERT_NE(secondPtr, slab->getUnderlyingBuffer());
+
+    cl_int retVal;
+    std::unique_ptr<Buffer> buffer(Buffer::create(&ctx, CL_MEM_READ_WRITE | CL_MEM_USE_HOST_PTR, 64, secondPtr, retVal));
+    ASSERT_NE(nullptr, buffer);
+    EXPECT_FALSE(buffer->isMemObjWithHostPtrSVM());
+    EXPECT_NE(slab, buffer->getGraphicsAllocation());
+    buffer.reset();
+
+    svmManager->freeSVMAlloc(secondPtr);
+    svmManager->freeSVMAlloc(firstPtr);
+}
+
 TEST(Buffer, givenReadOnlySetOfInputFlagsWhenPassedToisReadOnlyMemoryPermittedByFlagsThenTrueIsReturned) {
     class MockBuffer : public Buffer {
       public:
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/mem_obj/image.h"
+#include "runtime/mem_obj/image_allocation_pool.h"
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "runtime/os_interface/os_context.h"
+#include "unit_tests/fixtures/image_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_context.h"
+#include "unit_tests/mocks/mock_device.h"
+#include "test.h"
+
+using namespace OCLRT;
+
+struct ImageAllocationPoolTest : public ::testing::Test {
+    void SetUp() override {
+        pool = new ImageAllocationPool(*context.getMemoryManager(), 2u);
+        context.imageAllocationPool = pool;
+        auto &engine = context.getDevice(0)->getDefaultEngine();
+        csr = engine.commandStreamReceiver;
+        osContextId = engine.osContext->getContextId();
+    }
+
+    MockContext context;
+    ImageAllocationPool *pool = nullptr;
+    CommandStreamReceiver *csr = nullptr;
+    uint32_t osContextId = 0;
+};
+
+TEST(ImageAllocationPoolDefaultsTest, givenDefaultSettingsWhenContextIsCreatedThenImageAllocationPoolIsDisabled) {
+    EXPECT_EQ(0, DebugManager.flags.EnableImageAllocationPool.get());
+
+    auto device = std::unique_ptr<Device>(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+    cl_device_id clDevice = device.get();
+    cl_int retVal = CL_SUCCESS;
+    std::unique_ptr<Context> context(Context::create<Context>(nullptr, DeviceVector(&clDevice, 1), nullptr, nullptr, retVal));
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(nullptr, context->getImageAllocationPool());
+}
+
+TEST(ImageAllocationPoolDefaultsTest, givenImageAllocationPoolEnabledWhenContextIsCreatedThenPoolWithRequestedLimitIsCreated) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.EnableImageAllocationPool.set(4);
+
+    auto device = std::unique_ptr<Device>(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+    cl_device_id clDevice = device.get();
+    cl_int retVal = CL_SUCCESS;
+    std::unique_ptr<Context> context(Context::create<Context>(nullptr, DeviceVector(&clDevice, 1), nullptr, nullptr, retVal));
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    ASSERT_NE(nullptr, context->getImageAllocationPool());
+    EXPECT_EQ(4u, context->getImageAllocationPool()->getMaxPooledAllocations());
+}
+
+TEST_F(ImageAllocationPoolTest, givenReleasedIdleImageWhenImageWithSameDescriptorIsCreatedThenAllocationIsReused) {
+    std::unique_ptr<Image> image(ImageHelper<Image2dDefaults>::create(&context));
+    ASSERT_NE(nullptr, image);
+    auto allocation = image->getGraphicsAllocation();
+    auto rowPitch = image->getImageDesc().image_row_pitch;
+    auto size = image->getSize();
+
+    image.reset();
+    EXPECT_EQ(1u, pool->getPooledAllocationsCount());
+
+    image.reset(ImageHelper<Image2dDefaults>::create(&context));
+    ASSERT_NE(nullptr, image);
+    EXPECT_EQ(allocation, image->getGraphicsAllocation());
+    EXPECT_EQ(rowPitch, image->getImageDesc().image_row_pitch);
+    EXPECT_EQ(size, image->getSize());
+    EXPECT_EQ(0u, pool->getPooledAllocationsCount());
+}
+
+TEST_F(ImageAllocationPoolTest, givenReleasedImageStillUsedByGpuWhenImageWithSameDescriptorIsCreatedThenNewAllocationIsUsed) {
+    std::unique_ptr<Image> image(ImageHelper<Image2dDefaults>::create(&context));
+    ASSERT_NE(nullptr, image);
+    auto allocation = image->getGraphicsAllocation();
+    allocation->updateTaskCount(*csr->getTagAddress() + 1, osContextId);
+
+    image.reset();
+    EXPECT_EQ(1u, pool->getPooledAllocationsCount());
+
+    image.reset(ImageHelper<Image2dDefaults>::create(&context));
+    ASSERT_NE(nullptr, image);
+    EXPECT_NE(allocation, image->getGraphicsAllocation());
+    EXPECT_EQ(1u, pool->getPooledAllocationsCount());
+
+    allocation->updateTaskCount(*csr->getTagAddress(), osContextId);
+    std::unique_ptr<Image> secondImage(ImageHelper<Image2dDefaults>::create(&context));
+    ASSERT_NE(nullptr, secondImage);
+    EXPECT_EQ(allocation, secondImage->getGraphicsAllocation());
+}
+
+TEST_F(ImageAllocationPoolTest, givenReleasedImageWhenImageWithDifferentDescriptorOrFlagsIsCreatedThenPooledAllocationIsNotUsed) {
+    std::unique_ptr<Image> image(ImageHelper<Image2dDefaults>::create(&context));
+    ASSERT_NE(nullptr, image);
+    auto allocation = image->getGraphicsAllocation();
+    image.reset();
+
+    std::unique_ptr<Image> image3d(ImageHelper<Image3dDefaults>::create(&context));
+    ASSERT_NE(nullptr, image3d);
+    EXPECT_NE(allocation, image3d->getGraphicsAllocation());
+
+    std::unique_ptr<Image> readOnlyImage(ImageHelper<ImageReadOnly<Image2dDefaults>>::create(&context));
+    ASSERT_NE(nullptr, readOnlyImage);
+    EXPECT_NE(allocation, readOnlyImage->getGraphicsAllocation());
+    EXPECT_EQ(1u, pool->getPooledAllocationsCount());
+}
+
+TEST_F(ImageAllocationPoolTest, givenFullPoolWhenImageIsReleasedThenOldestPooledAllocationIsFreed) {
+    std::unique_ptr<Image> images[3];
+    for (auto &image : images) {
+        image.reset(ImageHelper<Image2dDefaults>::create(&context));
+        ASSERT_NE(nullptr, image);
+    }
+    for (auto &image : images) {
+        image.reset();
+    }
+    EXPECT_EQ(pool->getMaxPooledAllocations(), pool->getPooledAllocationsCount());
+}
+
+TEST_F(ImageAllocationPoolTest, givenImageWithHostPtrWhenItIsReleasedThenAllocationIsNotPooled) {
+    std::unique_ptr<Image> image(ImageHelper<ImageUseHostPtr<Image2dDefaults>>::create(&context));
+    ASSERT_NE(nullptr, image);
+    image.reset();
+    EXPECT_EQ(0u, pool->getPooledAllocationsCount());
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -16,6 +16,9 @@
 #include "unit_tests/mocks/mock_memory_manager.h"
 #include "test.h"
 
+#include <atomic>
+#include <thread>
+
 using namespace OCLRT;
 
 TEST(HostPtrManager, AlignedPointerAndAlignedSizeAskedForAllocationCountReturnsOne) {
@@ -1009,3 +1012,59 @@ TEST_F(HostPtrAllocationTest, checkAllocationsForOverlappingWithBiggerOverlapUnt
         EXPECT_EQ(nullptr, checkedFragments.fragments[i]);
     }
 }
+
+TEST(HostPtrManager, givenReservedRangeWhenDisjointRangeIsReservedThenItDoesNotWait) {
+    MockHostPtrManager hostPtrManager;
+    hostPtrManager.reserveRange(0x1000, 0x3000);
+    hostPtrManager.reserveRange(0x3000, 0x4000);
+    hostPtrManager.reserveRange(0x0, 0x1000);
+    hostPtrManager.releaseRange(0x1000, 0x3000);
+    hostPtrManager.releaseRange(0x3000, 0x4000);
+    hostPtrManager.releaseRange(0x0, 0x1000);
+}
+
+TEST(HostPtrManager, givenReservedRangeWhenOverlappingRangeIsReservedThenItWaitsUntilRangeIsReleased) {
+    MockHostPtrManager hostPtrManager;
+    std::atomic<bool> reserved{false};
+    hostPtrManager.reserveRange(0x1000, 0x3000);
+
+    std::thread overlappingPreparation([&]() {
+        hostPtrManager.reserveRange(0x2000, 0x4000);
+        reserved = true;
+        hostPtrManager.releaseRange(0x2000, 0x4000);
+    });
+
+    for (int i = 0; i < 1000; i++) {
+        std::this_thread::yield();
+    }
+    EXPECT_FALSE(reserved.load());
+
+    hostPtrManager.releaseRange(0x1000, 0x3000);
+    overlappingPreparation.join();
+    EXPECT_TRUE(reserved.load());
+}
+
+TEST_F(HostPtrAllocationTest, givenStoredFragmentWhenSameHostPtrIsPreparedThenFragmentIsReferencedAndRecreatedAfterRelease) {
+    auto hostPtrManager = static_cast<MockHostPtrManager *>(memoryManager->getHostPtrManager());
+    void *cpuPtr = reinterpret_cast<void *>(0x100000);
+    auto size = MemoryConstants::pageSize;
+
+    auto firstStorage = hostPtrManager->prepareOsStorageForAllocation(*memoryManager, size, cpuPtr);
+    EXPECT_EQ(1u, firstStorage.fragmentCount);
+    EXPECT_EQ(1, hostPtrManager->getFragment(cpuPtr)->refCount);
+
+    auto secondStorage = hostPtrManager->prepareOsStorageForAllocation(*memoryManager, size, cpuPtr);
+    EXPECT_EQ(firstStorage.fragmentStorageData[0].osHandleStorage, secondStorage.fragmentStorageData[0].osHandleStorage);
+    EXPECT_EQ(2, hostPtrManager->getFragment(cpuPtr)->refCount);
+
+    hostPtrManager->releaseHandleStorage(firstStorage);
+    hostPtrManager->releaseHandleStorage(secondStorage);
+    memoryManager->cleanOsHandles(secondStorage);
+    EXPECT_EQ(0u, hostPtrManager->getFragmentCount());
+
+    auto thirdStorage = hostPtrManager->prepareOsStorageForAllocation(*memoryManager, size, cpuPtr);
+    EXPECT_EQ(1u, thirdStorage.fragmentCount);
+    EXPECT_EQ(1, hostPtrManager->getFragment(cpuPtr)->refCount);
+    hostPtrManager->releaseHandleStorage(thirdStorage);
+    memoryManager->cleanOsHandles(thirdStorage);
+}
@@ -1,10 +1,12 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
  */
 
+#include "runtime/helpers/ptr_math.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/mocks/mock_memory_manager.h"
 #include "unit_tests/mocks/mock_svm_manager.h"
 #include "gtest/gtest.h"
@@ -128,3 +130,130 @@ TEST_F(SVMMemoryAllocatorTest, whenReadOnlySvmAllocationCreatedThenGraphicsAlloc
 
     svmManager.freeSVMAlloc(svm);
 }
+
+struct SVMSmallAllocationTest : ::testing::Test {
+    void SetUp() override {
+        DebugManager.flags.SVMSmallAllocationThreshold.set(256);
+        memoryManager.reset(new MockMemoryManager(false, false, executionEnvironment));
+        svmManager.reset(new MockSVMAllocsManager(memoryManager.get()));
+    }
+
+    void TearDown() override {
+        svmManager.reset();
+    }
+
+    DebugManagerStateRestore restore;
+    ExecutionEnvironment executionEnvironment;
+    std::unique_ptr<MockMemoryManager> memoryManager;
+    std::unique_ptr<MockSVMAllocsManager> svmManager;
+};
+
+TEST_F(SVMSmallAllocationTest, givenThresholdLargerThanMaxSmallAllocationSizeWhenManagerIsCreatedThenThresholdIsClamped) {
+    DebugManager.flags.SVMSmallAllocationThreshold.set(1024 * 1024);
+    MockSVMAllocsManager manager(memoryManager.get());
+    EXPECT_EQ(SVMAllocsManager::maxSmallAllocationSize, manager.smallAllocationThreshold);
+}
+
+TEST_F(SVMSmallAllocationTest, givenSmallAllocationsWhenCreatedThenTheyAreCarvedOutOfSingleSlab) {
+    auto first = svmManager->createSVMAlloc(64, false, false);
+    auto second = svmManager->createSVMAlloc(100, false, false);
+    ASSERT_NE(nullptr, first);
+    ASSERT_NE(nullptr, second);
+    EXPECT_NE(first, second);
+
+    EXPECT_EQ(1u, svmManager->getSmallAllocationSlabsCount());
+    EXPECT_EQ(1u, svmManager->getNumAllocs());
+
+    auto slab = svmManager->getSVMAlloc(first);
+    ASSERT_NE(nullptr, slab);
+    EXPECT_EQ(slab, svmManager->getSVMAlloc(second));
+    EXPECT_EQ(SVMAllocsManager::smallAllocationSlabSize, slab->getUnderlyingBufferSize());
+    EXPECT_EQ(0u, ptrDiff(first, slab->getUnderlyingBuffer()) % SVMAllocsManager::minSmallAllocationChunkSize);
+    EXPECT_EQ(0u, ptrDiff(second, slab->getUnderlyingBuffer()) % SVMAllocsManager::minSmallAllocationChunkSize);
+
+    svmManager->freeSVMAlloc(first);
+    svmManager->freeSVMAlloc(second);
+}
+
+TEST_F(SVMSmallAllocationTest, givenAllocationLargerThanThresholdWhenCreatedThenItHasOwnAllocation) {
+    auto small = svmManager->createSVMAlloc(256, false, false);
+    auto large = svmManager->createSVMAlloc(257, false, false);
+
+    EXPECT_EQ(1u, svmManager->getSmallAllocationSlabsCount());
+    EXPECT_EQ(2u, svmManager->getNumAllocs());
+    auto largeAllocation = svmManager->getSVMAlloc(large);
+    ASSERT_NE(nullptr, largeAllocation);
+    EXPECT_EQ(large, largeAllocation->getUnderlyingBuffer());
+    EXPECT_NE(svmManager->getSVMAlloc(small), largeAllocation);
+
+    svmManager->freeSVMAlloc(large);
+    EXPECT_EQ(1u, svmManager->getNumAllocs());
+    svmManager->freeSVMAlloc(small);
+}
+
+TEST_F(SVMSmallAllocationTest, givenDifferentFlagsOrSizeClassesWhenSmallAllocationsAreCreatedThenSeparateSlabsAreUsed) {
+    auto plain = svmManager->createSVMAlloc(64, false, false);
+    auto coherent = svmManager->createSVMAlloc(64, true, false);
+    auto readOnly = svmManager->createSVMAlloc(64, false, true);
+    auto larger = svmManager->createSVMAlloc(200, false, false);
+
+    EXPECT_EQ(4u, svmManager->getSmallAllocationSlabsCount());
+    EXPECT_FALSE(svmManager->getSVMAlloc(plain)->isCoherent());
+    EXPECT_TRUE(svmManager->getSVMAlloc(coherent)->isCoherent());
+    EXPECT_FALSE(svmManager->getSVMAlloc(readOnly)->isMemObjectsAllocationWithWritableFlags());
+    EXPECT_NE(svmManager->getSVMAlloc(plain), svmManager->getSVMAlloc(larger));
+
+    svmManager->freeSVMAlloc(plain);
+    svmManager->freeSVMAlloc(coherent);
+    svmManager->freeSVMAlloc(readOnly);
+    svmManager->freeSVMAlloc(larger);
+}
+
+TEST_F(SVMSmallAllocationTest, givenFreedSmallAllocationWhenNewOneIsCreatedThenChunkIsReused) {
+    auto first = svmManager->createSVMAlloc(64, false, false);
+    svmManager->freeSVMAlloc(first);
+    EXPECT_EQ(1u, svmManager->getSmallAllocationSlabsCount());
+
+    auto second = svmManager->createSVMAlloc(64, false, false);
+    EXPECT_EQ(first, second);
+    svmManager->freeSVMAlloc(second);
+}
+
+TEST_F(SVMSmallAllocationTest, givenFullSlabWhenItsChunksAreFreedThenOnlyLastEmptySlabOfItsKindIsKept) {
+    constexpr size_t chunksPerSlab = SVMAllocsManager::smallAllocationSlabSize / SVMAllocsManager::minSmallAllocationChunkSize;
+    std::vector<void *> ptrs;
+    for (size_t i = 0; i < chunksPerSlab + 1; i++) {
+        ptrs.push_back(svmManager->createSVMAlloc(64, false, false));
+    }
+    EXPECT_EQ(2u, svmManager->getSmallAllocationSlabsCount());
+    EXPECT_EQ(2u, svmManager->getNumAllocs());
+    EXPECT_NE(svmManager->getSVMAlloc(ptrs[0]), svmManager->getSVMAlloc(ptrs[chunksPerSlab]));
+
+    for (auto ptr : ptrs) {
+        svmManager->freeSVMAlloc(ptr);
+    }
+    EXPECT_EQ(1u, svmManager->getSmallAllocationSlabsCount());
+    EXPECT_EQ(1u, svmManager->getNumAllocs());
+}
+
+TEST_F(SVMSmallAllocationTest, givenPointerInsideOfSlabWhichIsNotLiveAllocationWhenFreedThenSlabIsNotReleased) {
+    auto ptr = svmManager->createSVMAlloc(64, false, false);
+    auto slab = svmManager->getSVMAlloc(ptr);
+
+    svmManager->freeSVMAlloc(ptrOffset(ptr, 4));
+    svmManager->freeSVMAlloc(ptrOffset(ptr, SVMAllocsManager::minSmallAllocationChunkSize));
+    EXPECT_EQ(slab, svmManager->getSVMAlloc(ptr));
+    EXPECT_EQ(1u, svmManager->getNumAllocs());
+
+    svmManager->freeSVMAlloc(ptr);
+    svmManager->freeSVMAlloc(ptr);
+    EXPECT_EQ(1u, svmManager->getSmallAllocationSlabsCount());
+}
+
+TEST_F(SVMSmallAllocationTest, givenSlabAllocationFailureWhenSmallAllocationIsCreatedThenNullptrIsReturned) {
+    FailMemoryManager failMemoryManager(executionEnvironment);
+    svmManager->memoryManager = &failMemoryManager;
+    EXPECT_EQ(nullptr, svmManager->createSVMAlloc(64, false, false));
+    EXPECT_EQ(0u, svmManager->getSmallAllocationSlabsCount());
+    EXPECT_EQ(0u, svmManager->getNumAllocs());
+}
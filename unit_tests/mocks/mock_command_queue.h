@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -15,6 +15,7 @@
 namespace OCLRT {
 class MockCommandQueue : public CommandQueue {
   public:
+    using CommandQueue::commandStreamRing;
     using CommandQueue::device;
     using CommandQueue::obtainNewTimestampPacketNodes;
     using CommandQueue::throttle;
@@ -13,6 +13,7 @@
 namespace OCLRT {
 class MockContext : public Context {
   public:
+    using Context::imageAllocationPool;
     using Context::sharingFunctions;
 
     MockContext(Device *device, bool noSpecialQueue = false);
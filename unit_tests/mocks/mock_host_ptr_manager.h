@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -15,6 +15,8 @@ class MockHostPtrManager : public HostPtrManager {
     using HostPtrManager::getAllocationRequirements;
     using HostPtrManager::getFragmentAndCheckForOverlaps;
     using HostPtrManager::populateAlreadyAllocatedFragments;
+    using HostPtrManager::releaseRange;
+    using HostPtrManager::reserveRange;
     size_t getFragmentCount() { return partialAllocations.size(); }
 };
 } // namespace OCLRT
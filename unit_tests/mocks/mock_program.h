@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -24,12 +24,14 @@ class GraphicsAllocation;
 class MockProgram : public Program {
   public:
     using Program::createProgramFromBinary;
+    using Program::getKernelParsingThreadsCount;
     using Program::getProgramCompilerVersion;
     using Program::isKernelDebugEnabled;
     using Program::rebuildProgramFromIr;
     using Program::resolveProgramBinary;
     using Program::updateNonUniformFlag;
 
+    using Program::deferKernelAllocations;
     using Program::elfBinary;
     using Program::elfBinarySize;
     using Program::genBinary;
@@ -38,6 +40,8 @@ class MockProgram : public Program {
     using Program::irBinarySize;
     using Program::isProgramBinaryResolved;
     using Program::isSpirV;
+    using Program::kernelInfoArray;
+    using Program::minKernelsPerParsingThread;
     using Program::programBinaryType;
 
     using Program::sourceCode;
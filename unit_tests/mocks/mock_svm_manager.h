@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -11,6 +11,7 @@ namespace OCLRT {
 struct MockSVMAllocsManager : SVMAllocsManager {
 
     using SVMAllocsManager::memoryManager;
+    using SVMAllocsManager::smallAllocationThreshold;
     using SVMAllocsManager::SVMAllocs;
     using SVMAllocsManager::SVMAllocsManager;
 };
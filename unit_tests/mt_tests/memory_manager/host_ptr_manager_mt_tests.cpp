@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/memory_manager/memory_constants.h"
+#include "unit_tests/mocks/mock_allocation_properties.h"
+#include "unit_tests/mocks/mock_host_ptr_manager.h"
+#include "unit_tests/mocks/mock_memory_manager.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+struct HostPtrManagerMtTest : public ::testing::Test {
+    static constexpr size_t pagesPerThread = 4;
+    static constexpr uint32_t maxThreadsCount = 16;
+
+    void SetUp() override {
+        memoryManager.reset(new MockMemoryManager(executionEnvironment));
+        hostPtrManager = static_cast<MockHostPtrManager *>(memoryManager->getHostPtrManager());
+        // one region per thread and one page shared by all threads
+        hostMemory = alignedMalloc((maxThreadsCount * pagesPerThread + 1) * MemoryConstants::pageSize, MemoryConstants::pageSize);
+    }
+
+    void TearDown() override {
+        EXPECT_EQ(0u, hostPtrManager->getFragmentCount());
+        memoryManager.reset();
+        alignedFree(hostMemory);
+    }
+
+    // each thread repeatedly wraps unaligned pointer from its own region (leading, middle and trailing fragment)
+    // and a pointer to page shared by all threads (single fragment referenced concurrently)
+    uint32_t runThreads(uint32_t threadsCount, uint32_t iterations) {
+        std::atomic<bool> start{false};
+        std::atomic<uint32_t> failures{0};
+        std::vector<std::thread> threads;
+        auto sharedPtr = ptrOffset(hostMemory, maxThreadsCount * pagesPerThread * MemoryConstants::pageSize + 0x10);
+
+        for (uint32_t t = 0; t < threadsCount; t++) {
+            auto ownPtr = ptrOffset(hostMemory, t * pagesPerThread * MemoryConstants::pageSize + MemoryConstants::pageSize / 2);
+            threads.emplace_back([&, ownPtr]() {
+                while (!start.load())
+                    ;
+                for (uint32_t i = 0; i < iterations; i++) {
+                    auto ownAllocation = memoryManager->allocateGraphicsMemory(MockAllocationProperties{false, (pagesPerThread - 1) * MemoryConstants::pageSize}, ownPtr);
+                    auto sharedAllocation = memoryManager->allocateGraphicsMemory(MockAllocationProperties{false, 0x100}, sharedPtr);
+                    if (ownAllocation == nullptr || ownAllocation->fragmentsStorage.fragmentCount != 3u ||
+                        sharedAllocation == nullptr || sharedAllocation->fragmentsStorage.fragmentCount != 1u) {
+                        failures++;
+                    }
+                    if (hostPtrManager->getFragment(ownPtr) == nullptr || hostPtrManager->getFragment(sharedPtr) == nullptr) {
+                        failures++;
+                    }
+                    memoryManager->freeGraphicsMemory(ownAllocation);
+                    memoryManager->freeGraphicsMemory(sharedAllocation);
+                }
+            });
+        }
+        start = true;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        return failures.load();
+    }
+
+    ExecutionEnvironment executionEnvironment;
+    std::unique_ptr<MockMemoryManager> memoryManager;
+    MockHostPtrManager *hostPtrManager = nullptr;
+    void *hostMemory = nullptr;
+};
+
+TEST_F(HostPtrManagerMtTest, givenMultipleThreadsWhenHostPtrAllocationsAreCreatedAndFreedThenFragmentsAreSharedAndReleased) {
+    EXPECT_EQ(0u, runThreads(8u, 200u));
+}
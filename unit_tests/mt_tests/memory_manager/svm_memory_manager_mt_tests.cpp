@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_memory_manager.h"
+#include "unit_tests/mocks/mock_svm_manager.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+struct SVMAllocsManagerMtTest : public ::testing::TestWithParam<int32_t /*small allocation threshold*/> {
+    void SetUp() override {
+        DebugManager.flags.SVMSmallAllocationThreshold.set(GetParam());
+        memoryManager.reset(new MockMemoryManager(false, false, executionEnvironment));
+        svmManager.reset(new MockSVMAllocsManager(memoryManager.get()));
+    }
+
+    void TearDown() override {
+        svmManager.reset();
+    }
+
+    // each thread keeps its own allocations alive while looking up pointers, then frees them
+    void runThreads(uint32_t threadsCount, uint32_t allocationsPerThread, size_t allocationSize, uint32_t lookupsPerAllocation) {
+        std::atomic<bool> start{false};
+        std::atomic<uint32_t> failures{0};
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < threadsCount; t++) {
+            threads.emplace_back([&]() {
+                std::vector<void *> ptrs;
+                ptrs.reserve(allocationsPerThread);
+                while (!start.load())
+                    ;
+                for (uint32_t i = 0; i < allocationsPerThread; i++) {
+                    auto ptr = svmManager->createSVMAlloc(allocationSize, false, false);
+                    if (ptr == nullptr) {
+                        failures++;
+                        continue;
+                    }
+                    ptrs.push_back(ptr);
+                }
+                for (uint32_t lookup = 0; lookup < lookupsPerAllocation; lookup++) {
+                    for (auto ptr : ptrs) {
+                        auto allocation = svmManager->getSVMAlloc(ptr);
+                        if (allocation == nullptr || ptr < allocation->getUnderlyingBuffer() ||
+                            ptr >= ptrOffset(allocation->getUnderlyingBuffer(), allocation->getUnderlyingBufferSize())) {
+                            failures++;
+                        }
+                    }
+                }
+                for (auto ptr : ptrs) {
+                    svmManager->freeSVMAlloc(ptr);
+                }
+            });
+        }
+        start = true;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        EXPECT_EQ(0u, failures.load());
+    }
+
+    DebugManagerStateRestore restore;
+    ExecutionEnvironment executionEnvironment;
+    std::unique_ptr<MockMemoryManager> memoryManager;
+    std::unique_ptr<MockSVMAllocsManager> svmManager;
+};
+
+TEST_P(SVMAllocsManagerMtTest, givenMultipleThreadsWhenSmallAllocationsAreCreatedLookedUpAndFreedThenAllLookupsSucceed) {
+    runThreads(4u, 1000u, 64u, 4u);
+
+    EXPECT_LE(svmManager->getNumAllocs(), 1u);
+    EXPECT_LE(svmManager->getSmallAllocationSlabsCount(), 1u);
+}
+
+INSTANTIATE_TEST_CASE_P(SVMAllocsManagerMt,
+                        SVMAllocsManagerMtTest,
+                        ::testing::Values(0, 256));
@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+#include "offline_compiler/multi_command.h"
+
+namespace OCLRT {
+
+class MockMultiCommand : public MultiCommand {
+  public:
+    using MultiCommand::commands;
+    using MultiCommand::jobs;
+    using MultiCommand::manifestFile;
+    using MultiCommand::quiet;
+
+    MockMultiCommand() : MultiCommand() {
+    }
+
+    int parseCommandLine(size_t numArgs, const char *const *argv) {
+        return MultiCommand::parseCommandLine(numArgs, argv);
+    }
+
+    int parseManifest(const std::string &manifest) {
+        return MultiCommand::parseManifest(manifest);
+    }
+};
+} // namespace OCLRT
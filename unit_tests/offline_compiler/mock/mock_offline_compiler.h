@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -11,10 +11,18 @@
 
 namespace OCLRT {
 
+class MockOfflineCompilerSharedState : public OfflineCompilerSharedState {
+  public:
+    using OfflineCompilerSharedState::compilersIdentity;
+};
+
 class MockOfflineCompiler : public OfflineCompiler {
   public:
+    using OfflineCompiler::builtFromCache;
+    using OfflineCompiler::cacheDirectory;
     using OfflineCompiler::generateFilePathForIr;
     using OfflineCompiler::generateOptsSuffix;
+    using OfflineCompiler::getCacheFileName;
     using OfflineCompiler::igcDeviceCtx;
     using OfflineCompiler::inputFileLlvm;
     using OfflineCompiler::inputFileSpirV;
@@ -22,6 +30,7 @@ class MockOfflineCompiler : public OfflineCompiler {
     using OfflineCompiler::options;
     using OfflineCompiler::outputDirectory;
     using OfflineCompiler::outputFile;
+    using OfflineCompiler::sharedState;
     using OfflineCompiler::sourceCode;
     using OfflineCompiler::useLlvmText;
     using OfflineCompiler::useOptionsSuffix;
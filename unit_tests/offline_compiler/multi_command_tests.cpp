@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "environment.h"
+#include "mock/mock_multi_command.h"
+#include "runtime/helpers/file_io.h"
+#include "runtime/helpers/hw_info.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+
+extern Environment *gEnvironment;
+
+namespace OCLRT {
+
+TEST(MultiCommandTest, givenLineWithQuotedArgumentWhenSplitThenQuotedArgumentIsKeptWhole) {
+    auto args = MultiCommand::splitLine("-file a.cl  -device skl\t-options \"-g -cl-std=CL2.0\" -internal_options \"\"\r");
+    ASSERT_EQ(8u, args.size());
+    EXPECT_EQ("-file", args[0]);
+    EXPECT_EQ("a.cl", args[1]);
+    EXPECT_EQ("-device", args[2]);
+    EXPECT_EQ("skl", args[3]);
+    EXPECT_EQ("-options", args[4]);
+    EXPECT_EQ("-g -cl-std=CL2.0", args[5]);
+    EXPECT_EQ("-internal_options", args[6]);
+    EXPECT_EQ("", args[7]);
+}
+
+TEST(MultiCommandTest, givenManifestWithDeviceListWhenParsedThenCommandIsCreatedForEachDevice) {
+    MockMultiCommand multiCommand;
+    std::string manifest = "-file a.cl -device skl,kbl -options \"-g\"\n"
+                           "# comment\n"
+                           "\n"
+                           "-file b.cl -device glk\n";
+
+    EXPECT_EQ(CL_SUCCESS, multiCommand.parseManifest(manifest));
+    ASSERT_EQ(3u, multiCommand.commands.size());
+
+    EXPECT_EQ("skl", multiCommand.commands[0].device);
+    EXPECT_EQ("kbl", multiCommand.commands[1].device);
+    EXPECT_EQ("glk", multiCommand.commands[2].device);
+    EXPECT_EQ(1u, multiCommand.commands[0].lineNumber);
+    EXPECT_EQ(1u, multiCommand.commands[1].lineNumber);
+    EXPECT_EQ(4u, multiCommand.commands[2].lineNumber);
+
+    std::vector<std::string> expectedArgs = {"ocloc", "-file", "a.cl", "-device", "kbl", "-options", "-g"};
+    EXPECT_EQ(expectedArgs, multiCommand.commands[1].args);
+}
+
+TEST(MultiCommandTest, givenQuietModeWhenManifestIsParsedThenQuietFlagIsPassedToEachCommand) {
+    MockMultiCommand multiCommand;
+    multiCommand.quiet = true;
+
+    EXPECT_EQ(CL_SUCCESS, multiCommand.parseManifest("-file a.cl -device skl\n"));
+    ASSERT_EQ(1u, multiCommand.commands.size());
+    EXPECT_EQ("-q", multiCommand.commands[0].args.back());
+}
+
+TEST(MultiCommandTest, givenManifestLineWithoutDeviceWhenParsedThenErrorIsReturned) {
+    MockMultiCommand multiCommand;
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(INVALID_COMMAND_LINE, multiCommand.parseManifest("-file a.cl\n"));
+    EXPECT_EQ(INVALID_COMMAND_LINE, multiCommand.parseManifest("-file a.cl -device\n"));
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_NE(std::string::npos, output.find("Device name missing in line 1"));
+}
+
+TEST(MultiCommandTest, givenEmptyManifestWhenParsedThenErrorIsReturned) {
+    MockMultiCommand multiCommand;
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(INVALID_FILE, multiCommand.parseManifest("# nothing to build\n\n"));
+    testing::internal::GetCapturedStdout();
+}
+
+TEST(MultiCommandTest, givenJobsOptionWhenCommandLineIsParsedThenJobsCountIsSet) {
+    MockMultiCommand multiCommand;
+    auto argv = {"ocloc", "batch", "-file", "test_files/copybuffer.cl", "-jobs", "3", "-q"};
+
+    EXPECT_EQ(CL_SUCCESS, multiCommand.parseCommandLine(argv.size(), argv.begin()));
+    EXPECT_EQ("test_files/copybuffer.cl", multiCommand.manifestFile);
+    EXPECT_EQ(3u, multiCommand.jobs);
+    EXPECT_TRUE(multiCommand.quiet);
+}
+
+TEST(MultiCommandTest, givenMissingManifestWhenCommandLineIsParsedThenErrorIsReturned) {
+    MockMultiCommand multiCommand;
+    auto argv = {"ocloc", "batch", "-file", "test_files/no_such_manifest.txt"};
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(INVALID_FILE, multiCommand.parseCommandLine(argv.size(), argv.begin()));
+    testing::internal::GetCapturedStdout();
+}
+
+TEST(MultiCommandTest, givenManifestWithTwoBuildsWhenExecutedThenAllOutputsAreWritten) {
+    std::string manifest = "-file test_files/copybuffer.cl -device " + gEnvironment->devicePrefix + " -output batch_first\n" +
+                           "-file test_files/copybuffer.cl -device " + gEnvironment->devicePrefix + " -output batch_second\n";
+    writeDataToFile("batch_manifest.txt", manifest.c_str(), manifest.size());
+
+    auto argv = {"ocloc", "batch", "-file", "batch_manifest.txt", "-jobs", "2", "-q"};
+    int retVal = CL_SUCCESS;
+    std::unique_ptr<MultiCommand> multiCommand(MultiCommand::create(argv.size(), argv.begin(), retVal));
+    ASSERT_NE(nullptr, multiCommand);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    testing::internal::CaptureStdout();
+    retVal = multiCommand->execute();
+    testing::internal::GetCapturedStdout();
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    for (auto output : {"batch_first", "batch_second"}) {
+        std::string binFile = std::string(output) + "_" + gEnvironment->familyNameWithType + ".bin";
+        std::string genFile = std::string(output) + "_" + gEnvironment->familyNameWithType + ".gen";
+        EXPECT_TRUE(fileExists(binFile));
+        EXPECT_TRUE(fileExists(genFile));
+        std::remove(binFile.c_str());
+        std::remove(genFile.c_str());
+    }
+    std::remove("batch_manifest.txt");
+}
+
+TEST(MultiCommandTest, givenManifestLineWithDevicesOfSameFamilyWhenExecutedThenOutputsAreWrittenForEachDevice) {
+    std::vector<std::string> devices;
+    for (unsigned int productId = 0; productId < IGFX_MAX_PRODUCT && devices.size() < 2; ++productId) {
+        auto hwInfo = hardwareInfoTable[productId];
+        if (hardwarePrefix[productId] == nullptr || hwInfo == nullptr) {
+            continue;
+        }
+        std::string productFamilyNameWithType = std::string(familyName[hwInfo->pPlatform->eRenderCoreFamily]) + getPlatformType(*hwInfo);
+        if (productFamilyNameWithType == gEnvironment->familyNameWithType) {
+            devices.push_back(hardwarePrefix[productId]);
+        }
+    }
+    if (devices.size() < 2) {
+        return;
+    }
+
+    std::string manifest = "-file test_files/copybuffer.cl -device " + devices[0] + "," + devices[1] + " -output batch_devices\n";
+    writeDataToFile("batch_manifest.txt", manifest.c_str(), manifest.size());
+
+    auto argv = {"ocloc", "batch", "-file", "batch_manifest.txt", "-q"};
+    int retVal = CL_SUCCESS;
+    std::unique_ptr<MultiCommand> multiCommand(MultiCommand::create(argv.size(), argv.begin(), retVal));
+    ASSERT_NE(nullptr, multiCommand);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    testing::internal::CaptureStdout();
+    retVal = multiCommand->execute();
+    testing::internal::GetCapturedStdout();
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    for (auto &device : devices) {
+        std::string fileBase = "batch_devices_" + gEnvironment->familyNameWithType + "_" + device;
+        EXPECT_TRUE(fileExists(fileBase + ".bin"));
+        EXPECT_TRUE(fileExists(fileBase + ".gen"));
+        for (auto extension : {".bin", ".gen", ".bc", ".spv"}) {
+            std::remove((fileBase + extension).c_str());
+        }
+    }
+    std::remove("batch_manifest.txt");
+}
+
+TEST(MultiCommandTest, givenTwoBuildsWritingSameOutputsWhenExecutedThenSecondBuildFails) {
+    std::string line = "-file test_files/copybuffer.cl -device " + gEnvironment->devicePrefix + " -output batch_collision\n";
+    std::string manifest = line + line;
+    writeDataToFile("batch_manifest.txt", manifest.c_str(), manifest.size());
+
+    auto argv = {"ocloc", "batch", "-file", "batch_manifest.txt", "-q"};
+    int retVal = CL_SUCCESS;
+    std::unique_ptr<MultiCommand> multiCommand(MultiCommand::create(argv.size(), argv.begin(), retVal));
+    ASSERT_NE(nullptr, multiCommand);
+
+    testing::internal::CaptureStdout();
+    retVal = multiCommand->execute();
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_EQ(INVALID_COMMAND_LINE, retVal);
+    EXPECT_NE(std::string::npos, output.find("collide with the command from line 1"));
+
+    std::string fileBase = "batch_collision_" + gEnvironment->familyNameWithType;
+    for (auto extension : {".bin", ".gen", ".bc", ".spv"}) {
+        std::remove((fileBase + extension).c_str());
+    }
+    std::remove("batch_manifest.txt");
+}
+} // namespace OCLRT
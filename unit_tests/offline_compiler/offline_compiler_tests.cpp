@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -8,6 +8,7 @@
 #include "environment.h"
 #include "mock/mock_offline_compiler.h"
 #include "offline_compiler_tests.h"
+#include "offline_compiler/source_dependencies.h"
 #include "runtime/helpers/hw_info.h"
 #include "runtime/helpers/file_io.h"
 #include "runtime/helpers/options.h"
@@ -17,6 +18,8 @@
 #include "gmock/gmock.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <set>
 
 extern Environment *gEnvironment;
 
@@ -625,6 +628,40 @@ TEST(OfflineCompilerTest, givenBinaryInputThenDontTruncateSourceAtFirstZero) {
     EXPECT_LT(0U, mockOfflineCompiler->sourceCode.size());
 }
 
+TEST(OfflineCompilerTest, givenSourceIsCompiledWhenElfIsWrittenToFileThenFileContentIsEqualToGeneratedElfBinary) {
+    auto argv = {
+        "ocloc",
+        "-file",
+        "test_files/copybuffer.cl",
+        "-output",
+        "myStreamedElf",
+        "-device",
+        gEnvironment->devicePrefix.c_str()};
+
+    auto mockOfflineCompiler = std::unique_ptr<MockOfflineCompiler>(new MockOfflineCompiler());
+    ASSERT_NE(nullptr, mockOfflineCompiler);
+
+    int retVal = mockOfflineCompiler->initialize(argv.size(), argv.begin());
+    ASSERT_EQ(CL_SUCCESS, retVal);
+
+    retVal = mockOfflineCompiler->build();
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    ASSERT_TRUE(compilerOutputExists("myStreamedElf", "bin"));
+
+    EXPECT_TRUE(mockOfflineCompiler->generateElfBinary());
+
+    void *fileData = nullptr;
+    size_t fileSize = loadDataFromFile(getCompilerOutputFileName("myStreamedElf", "bin").c_str(), fileData);
+    ASSERT_EQ(mockOfflineCompiler->getElfBinarySize(), fileSize);
+    EXPECT_EQ(0, memcmp(mockOfflineCompiler->getElfBinary(), fileData, fileSize));
+    deleteDataReadFromFile(fileData);
+
+    compilerOutputRemove("myStreamedElf", "bc");
+    compilerOutputRemove("myStreamedElf", "spv");
+    compilerOutputRemove("myStreamedElf", "bin");
+    compilerOutputRemove("myStreamedElf", "gen");
+}
+
 TEST(OfflineCompilerTest, givenOutputFileOptionWhenSourceIsCompiledThenOutputFileHasCorrectName) {
     auto argv = {
         "ocloc",
@@ -821,4 +858,148 @@ TEST(OfflineCompilerTest, givenEnabledOptsSuffixWhenGenerateOptsSuffixIsCalledTh
     EXPECT_STREQ("A_B_C", suffix.c_str());
 }
 
+TEST(OfflineCompilerTest, givenOptionsWithIncludeDirectoriesWhenParsedThenAllDirectoriesAreReturned) {
+    auto includeDirectories = getIncludeDirectories("-cl-std=CL2.0 -I dir_a -Idir_b -g");
+    ASSERT_EQ(2u, includeDirectories.size());
+    EXPECT_EQ("dir_a", includeDirectories[0]);
+    EXPECT_EQ("dir_b", includeDirectories[1]);
+}
+
+TEST(OfflineCompilerTest, givenSourceWithNestedIncludesWhenIncludedFilesAreCollectedThenAllResolvedHeadersAreReturned) {
+    std::string nestedHeader = "#define VALUE 1\n";
+    std::string header = "  #  include \"ocloc_test_nested.h\"\n#include <opencl-c.h>\n";
+    writeDataToFile("ocloc_test_header.h", header.c_str(), header.size());
+    writeDataToFile("ocloc_test_nested.h", nestedHeader.c_str(), nestedHeader.size());
+
+    std::set<std::string> includedFiles;
+    std::set<std::string> unresolvedIncludes;
+    collectIncludedFiles("#include \"ocloc_test_header.h\"\n__kernel void k() {}\n", "", {}, includedFiles, unresolvedIncludes);
+
+    EXPECT_EQ(2u, includedFiles.size());
+    EXPECT_EQ(1u, includedFiles.count("ocloc_test_header.h"));
+    EXPECT_EQ(1u, includedFiles.count("ocloc_test_nested.h"));
+    EXPECT_EQ(1u, unresolvedIncludes.size());
+    EXPECT_EQ(1u, unresolvedIncludes.count("opencl-c.h"));
+
+    std::remove("ocloc_test_header.h");
+    std::remove("ocloc_test_nested.h");
+}
+
+TEST(OfflineCompilerTest, givenCacheDirectoryWhenSameSourceIsBuiltTwiceThenSecondBuildIsTakenFromCache) {
+    auto argv = {
+        "ocloc",
+        "-file",
+        "test_files/copybuffer.cl",
+        "-output",
+        "myCachedOutput",
+        "-cache_dir",
+        ".",
+        "-device",
+        gEnvironment->devicePrefix.c_str()};
+
+    auto firstCompiler = std::unique_ptr<MockOfflineCompiler>(new MockOfflineCompiler());
+    ASSERT_EQ(CL_SUCCESS, firstCompiler->initialize(argv.size(), argv.begin()));
+    EXPECT_EQ(".", firstCompiler->cacheDirectory);
+    EXPECT_EQ(CL_SUCCESS, firstCompiler->build());
+    EXPECT_FALSE(firstCompiler->builtFromCache);
+
+    std::string cacheFile = generateFilePath(".", firstCompiler->getCacheFileName(), ".ocloc_cache");
+    EXPECT_TRUE(fileExists(cacheFile));
+    compilerOutputRemove("myCachedOutput", "bin");
+    compilerOutputRemove("myCachedOutput", "gen");
+
+    auto secondCompiler = std::unique_ptr<MockOfflineCompiler>(new MockOfflineCompiler());
+    ASSERT_EQ(CL_SUCCESS, secondCompiler->initialize(argv.size(), argv.begin()));
+    EXPECT_EQ(CL_SUCCESS, secondCompiler->build());
+    EXPECT_TRUE(secondCompiler->builtFromCache);
+    EXPECT_TRUE(compilerOutputExists("myCachedOutput", "bin"));
+    EXPECT_TRUE(compilerOutputExists("myCachedOutput", "gen"));
+    EXPECT_EQ(firstCompiler->getGenBinarySize(), secondCompiler->getGenBinarySize());
+
+    compilerOutputRemove("myCachedOutput", "bc");
+    compilerOutputRemove("myCachedOutput", "spv");
+    compilerOutputRemove("myCachedOutput", "bin");
+    compilerOutputRemove("myCachedOutput", "gen");
+    std::remove(cacheFile.c_str());
+}
+
+TEST(OfflineCompilerTest, givenIncludedHeaderWhenItChangesThenCacheFileNameChanges) {
+    std::string header = "#define VALUE 1\n";
+    writeDataToFile("ocloc_test_header.h", header.c_str(), header.size());
+
+    MockOfflineCompiler compiler;
+    ASSERT_EQ(CL_SUCCESS, compiler.getHardwareInfo(gEnvironment->devicePrefix.c_str()));
+    compiler.sourceCode = "#include \"ocloc_test_header.h\"\n__kernel void k() {}\n";
+    auto cacheFileName = compiler.getCacheFileName();
+    EXPECT_EQ(cacheFileName, compiler.getCacheFileName());
+
+    header = "#define VALUE 2\n";
+    writeDataToFile("ocloc_test_header.h", header.c_str(), header.size());
+    EXPECT_NE(cacheFileName, compiler.getCacheFileName());
+
+    compiler.options = "-g";
+    auto cacheFileNameWithOptions = compiler.getCacheFileName();
+    EXPECT_NE(cacheFileName, cacheFileNameWithOptions);
+
+    std::remove("ocloc_test_header.h");
+}
+
+TEST(OfflineCompilerTest, givenCompilersWithSameInterfaceVersionButDifferentIdentityWhenCacheFileNameIsQueriedThenKeysDiffer) {
+    auto argv = {
+        "ocloc",
+        "-file",
+        "test_files/copybuffer.cl",
+        "-device",
+        gEnvironment->devicePrefix.c_str()};
+
+    auto sharedState = std::make_shared<MockOfflineCompilerSharedState>();
+    auto otherSharedState = std::make_shared<MockOfflineCompilerSharedState>();
+    MockOfflineCompiler compiler;
+    MockOfflineCompiler otherCompiler;
+    compiler.sharedState = sharedState;
+    otherCompiler.sharedState = otherSharedState;
+    ASSERT_EQ(CL_SUCCESS, compiler.initialize(argv.size(), argv.begin()));
+    ASSERT_EQ(CL_SUCCESS, otherCompiler.initialize(argv.size(), argv.begin()));
+
+    EXPECT_NE(std::string::npos, sharedState->getCompilersIdentity().find("-fcl_identity"));
+    EXPECT_NE(std::string::npos, sharedState->getCompilersIdentity().find("-igc_identity"));
+    EXPECT_EQ(sharedState->getCompilersIdentity(), otherSharedState->getCompilersIdentity());
+    EXPECT_EQ(compiler.getCacheFileName(), otherCompiler.getCacheFileName());
+
+    // updated compiler libraries keeping the same interface version
+    EXPECT_EQ(sharedState->fclMain->GetBinaryVersion(), otherSharedState->fclMain->GetBinaryVersion());
+    EXPECT_EQ(sharedState->igcMain->GetBinaryVersion(), otherSharedState->igcMain->GetBinaryVersion());
+    otherSharedState->compilersIdentity = " -fcl_identity 1 -igc_identity 2";
+    EXPECT_NE(compiler.getCacheFileName(), otherCompiler.getCacheFileName());
+}
+
+TEST(OfflineCompilerTest, givenUnknownCompilersIdentityWhenBuildingWithCacheDirectoryThenCacheIsNotUsed) {
+    auto argv = {
+        "ocloc",
+        "-file",
+        "test_files/copybuffer.cl",
+        "-output",
+        "myUncachedOutput",
+        "-cache_dir",
+        ".",
+        "-device",
+        gEnvironment->devicePrefix.c_str()};
+
+    auto sharedState = std::make_shared<MockOfflineCompilerSharedState>();
+    MockOfflineCompiler compiler;
+    compiler.sharedState = sharedState;
+    ASSERT_EQ(CL_SUCCESS, compiler.initialize(argv.size(), argv.begin()));
+    sharedState->getCompilersIdentity();
+    sharedState->compilersIdentity.clear();
+
+    EXPECT_EQ(CL_SUCCESS, compiler.build());
+    EXPECT_FALSE(compiler.builtFromCache);
+    EXPECT_FALSE(fileExists(generateFilePath(".", compiler.getCacheFileName(), ".ocloc_cache")));
+
+    compilerOutputRemove("myUncachedOutput", "bc");
+    compilerOutputRemove("myUncachedOutput", "spv");
+    compilerOutputRemove("myUncachedOutput", "bin");
+    compilerOutputRemove("myUncachedOutput", "gen");
+}
+
 } // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -12,6 +12,7 @@
 #include "runtime/helpers/string_helpers.h"
 #include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/utilities/async_log_writer.h"
 #include "runtime/utilities/directory.h"
 #include "unit_tests/mocks/mock_kernel.h"
 #include "unit_tests/mocks/mock_program.h"
@@ -22,6 +23,8 @@
 #include "unit_tests/fixtures/image_fixture.h"
 #include "unit_tests/helpers/memory_management.h"
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <sstream>
@@ -73,9 +76,39 @@ class TestDebugFlagsChecker {
 template <DebugFunctionalityLevel DebugLevel>
 class TestDebugSettingsManager : public DebugSettingsManager<DebugLevel> {
   public:
+    struct MockAsyncLogWriter : public AsyncLogWriter {
+        MockAsyncLogWriter(TestDebugSettingsManager &debugManager) : AsyncLogWriter(debugManager.getLogFileName()), debugManager(debugManager) {}
+        ~MockAsyncLogWriter() override {
+            closeThread();
+        }
+
+        void writeToSink(const char *str, size_t length) override {
+            while (sinkBlocked) {
+                std::this_thread::yield();
+            }
+            sinkWritesCount++;
+            debugManager.writeToFile(debugManager.getLogFileName(), str, length, std::ios::app);
+        }
+
+        TestDebugSettingsManager &debugManager;
+        std::atomic<bool> sinkBlocked{false};
+        std::atomic<uint32_t> sinkWritesCount{0};
+    };
+
+    TestDebugSettingsManager() {
+        if (this->logWriter) {
+            this->logWriter.reset(new MockAsyncLogWriter(*this));
+        }
+    }
+
     ~TestDebugSettingsManager() {
+        this->logWriter.reset();
         remove(DebugSettingsManager<DebugLevel>::logFileName.c_str());
     }
+
+    MockAsyncLogWriter *getLogWriter() {
+        return static_cast<MockAsyncLogWriter *>(this->logWriter.get());
+    }
     SettingsReader *getSettingsReader() {
         return DebugSettingsManager<DebugLevel>::readerImpl.get();
     }
@@ -89,6 +122,7 @@ class TestDebugSettingsManager : public DebugSettingsManager<DebugLevel> {
                      size_t length,
                      std::ios_base::openmode mode) override {
 
+        std::lock_guard<std::mutex> lock(savedFilesMtx);
         savedFiles[filename] << std::string(str, str + length);
         if (mockFileSystem == false) {
             DebugSettingsManager<DebugLevel>::writeToFile(filename, str, length, mode);
@@ -96,19 +130,26 @@ class TestDebugSettingsManager : public DebugSettingsManager<DebugLevel> {
     };
 
     int32_t createdFilesCount() {
+        this->flushLogs();
+        std::lock_guard<std::mutex> lock(savedFilesMtx);
         return static_cast<int32_t>(savedFiles.size());
     }
 
     bool wasFileCreated(std::string filename) {
+        this->flushLogs();
+        std::lock_guard<std::mutex> lock(savedFilesMtx);
         return savedFiles.find(filename) != savedFiles.end();
     }
 
     std::string getFileString(std::string filename) {
+        this->flushLogs();
+        std::lock_guard<std::mutex> lock(savedFilesMtx);
         return savedFiles[filename].str();
     }
 
   protected:
     bool mockFileSystem = true;
+    std::mutex savedFilesMtx;
     std::map<std::string, std::stringstream> savedFiles;
 };
 
@@ -175,6 +216,29 @@ TEST(DebugSettingsManager, WithDebugFunctionalityCreatesAndDumpsToLogFile) {
     }
 }
 
+TEST(DebugSettingsManager, givenApiLoggingEnabledWhenManyCallsAreLoggedThenCallsDoNotWaitForFileWritesAndLinesAreWrittenInBatches) {
+    FullyEnabledTestDebugManager debugManager;
+    debugManager.flags.LogApiCalls.set(true);
+    debugManager.getLogWriter()->sinkBlocked = true;
+
+    constexpr uint32_t callsCount = 10000;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < callsCount; i++) {
+        debugManager.logApiCall("clEnqueueNDRangeKernel", true, 0);
+    }
+    auto loggingTime = std::chrono::steady_clock::now() - start;
+    debugManager.getLogWriter()->sinkBlocked = false;
+    RecordProperty("perCallOverheadNs", static_cast<int>(std::chrono::duration_cast<std::chrono::nanoseconds>(loggingTime).count() / callsCount));
+
+    auto str = debugManager.getFileString(debugManager.getLogFileName());
+    size_t loggedCallsCount = 0;
+    for (auto pos = str.find("clEnqueueNDRangeKernel"); pos != std::string::npos; pos = str.find("clEnqueueNDRangeKernel", pos + 1)) {
+        loggedCallsCount++;
+    }
+    EXPECT_EQ(callsCount, loggedCallsCount);
+    EXPECT_GE(2u, debugManager.getLogWriter()->sinkWritesCount.load());
+}
+
 TEST(DebugSettingsManager, WithoutDebugFunctionalityDoesNotCreateLogFile) {
     string settings = "LogApiCalls = 1";
     SettingsFileCreator settingsFile(settings);
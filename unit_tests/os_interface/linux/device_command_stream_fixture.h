@@ -161,6 +161,9 @@ class DrmMockCustom : public Drm {
     drm_i915_gem_context_param recordedGetContextParam = {0};
     __u64 getContextParamRetValue = 0;
 
+    //DRM_IOCTL_I915_GEM_WAIT
+    __s64 gemWaitTimeout = 0;
+
     int errnoValue = 0;
 
     int ioctl(unsigned long request, void *arg) override {
@@ -219,9 +222,11 @@ class DrmMockCustom : public Drm {
             ioctl_cnt.gemSetDomain++;
         } break;
 
-        case DRM_IOCTL_I915_GEM_WAIT:
+        case DRM_IOCTL_I915_GEM_WAIT: {
+            auto waitParams = (drm_i915_gem_wait *)arg;
+            gemWaitTimeout = waitParams->timeout_ns;
             ioctl_cnt.gemWait++;
-            break;
+        } break;
 
         case DRM_IOCTL_GEM_CLOSE:
             ioctl_cnt.gemClose++;
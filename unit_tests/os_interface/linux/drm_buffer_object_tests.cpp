@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -126,6 +126,29 @@ TEST_F(DrmBufferObjectTest, onPinIoctlFailed) {
     EXPECT_EQ(EINVAL, ret);
 }
 
+TEST_F(DrmBufferObjectTest, givenTimeoutWhenWaitIsCalledThenTimeoutIsPassedToIoctl) {
+    mock->ioctl_expected.total = 2;
+
+    EXPECT_EQ(0, bo->wait(1000));
+    EXPECT_EQ(1000, mock->gemWaitTimeout);
+
+    EXPECT_EQ(0, bo->wait(-1));
+    EXPECT_EQ(-1, mock->gemWaitTimeout);
+}
+
+TEST_F(DrmBufferObjectTest, givenBusyBoWhenBoundedWaitExpiresThenEtimeIsReturned) {
+    mock->ioctl_expected.total = 2;
+    mock->ioctl_res = -1;
+    mock->errnoValue = ETIME;
+
+    EXPECT_EQ(ETIME, bo->wait(0));
+    EXPECT_EQ(0, mock->gemWaitTimeout);
+
+    EXPECT_EQ(ETIME, bo->wait(500));
+    EXPECT_EQ(500, mock->gemWaitTimeout);
+    mock->ioctl_res = 0;
+}
+
 TEST(DrmBufferObjectSimpleTest, givenInvalidBoWhenPinIsCalledThenErrorIsReturned) {
     std::unique_ptr<uint32_t[]> buff(new uint32_t[256]);
     std::unique_ptr<DrmMockCustom> mock(new DrmMockCustom);
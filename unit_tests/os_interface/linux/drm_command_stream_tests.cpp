@@ -87,12 +87,12 @@ ACTION_P(copyIoctlParam, dstValue) {
     *dstValue = *static_cast<decltype(dstValue)>(arg1);
     return 0;
 };
-TEST_F(DrmCommandStreamTest, givenFlushStampWhenWaitCalledThenWaitForSpecifiedBoHandle) {
+TEST_F(DrmCommandStreamTest, givenFlushStampWhenWaitCalledThenBoundedWaitForSpecifiedBoHandleIsIssued) {
     FlushStamp handleToWait = 123;
     drm_i915_gem_wait expectedWait = {};
     drm_i915_gem_wait calledWait = {};
     expectedWait.bo_handle = static_cast<uint32_t>(handleToWait);
-    expectedWait.timeout_ns = -1;
+    expectedWait.timeout_ns = 1000 * 1000;
 
     EXPECT_CALL(*mock, ioctl(DRM_IOCTL_I915_GEM_WAIT, ::testing::_))
         .Times(1)
@@ -102,6 +102,25 @@ TEST_F(DrmCommandStreamTest, givenFlushStampWhenWaitCalledThenWaitForSpecifiedBo
     EXPECT_TRUE(memcmp(&expectedWait, &calledWait, sizeof(drm_i915_gem_wait)) == 0);
 }
 
+TEST_F(DrmCommandStreamTest, givenFlushStampWaitTimeoutOverrideWhenWaitCalledThenBoundedWaitIsIssuedAndExpiredWaitIsReported) {
+    DebugManager.flags.OverrideDrmFlushStampWaitTimeoutMicroseconds.set(5);
+    auto boundedCsr = std::make_unique<DrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME>>(*platformDevices[0], executionEnvironment,
+                                                                                             gemCloseWorkerMode::gemCloseWorkerInactive);
+    FlushStamp handleToWait = 123;
+    drm_i915_gem_wait calledWait = {};
+
+    EXPECT_CALL(*mock, ioctl(DRM_IOCTL_I915_GEM_WAIT, ::testing::_))
+        .Times(2)
+        .WillOnce(::testing::DoAll(copyIoctlParam(&calledWait), ::testing::Return(-1)))
+        .WillOnce(::testing::Return(0));
+
+    EXPECT_FALSE(boundedCsr->waitForFlushStamp(handleToWait));
+    EXPECT_EQ(static_cast<uint32_t>(handleToWait), calledWait.bo_handle);
+    EXPECT_EQ(5000, calledWait.timeout_ns);
+
+    EXPECT_TRUE(boundedCsr->waitForFlushStamp(handleToWait));
+}
+
 TEST_F(DrmCommandStreamTest, makeResident) {
     EXPECT_CALL(*mock, ioctl(DRM_IOCTL_I915_GEM_USERPTR, ::testing::_))
         .Times(0);
@@ -1320,6 +1339,8 @@ TEST_F(DrmCommandStreamLeaksTest, ClearResidencyWhenFlushNotCalled) {
 }
 
 TEST_F(DrmCommandStreamLeaksTest, FlushMultipleTimes) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.EnableCommandStreamRing.set(false);
     auto &cs = csr->getCS();
     auto commandBuffer = static_cast<DrmAllocation *>(cs.getGraphicsAllocation());
 
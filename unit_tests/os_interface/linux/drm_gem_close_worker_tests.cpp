@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -23,6 +23,7 @@
 #include "runtime/os_interface/linux/drm_gem_close_worker.h"
 #include "runtime/os_interface/linux/drm_memory_manager.h"
 #include "test.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/os_interface/linux/device_command_stream_fixture.h"
 
 using namespace OCLRT;
@@ -94,6 +95,16 @@ class DrmGemCloseWorkerFixture {
 
 typedef Test<DrmGemCloseWorkerFixture> DrmGemCloseWorkerTests;
 
+struct MockDrmGemCloseWorker : DrmGemCloseWorker {
+    using DrmGemCloseWorker::DrmGemCloseWorker;
+    using DrmGemCloseWorker::maxQueueDepth;
+
+    size_t getQueueSize() {
+        std::lock_guard<std::mutex> lock(closeWorkerMutex);
+        return queue.size();
+    }
+};
+
 TEST_F(DrmGemCloseWorkerTests, gemClose) {
     this->drmMock->gem_close_expected = 1;
 
@@ -183,3 +194,71 @@ TEST_F(DrmGemCloseWorkerTests, givenDrmGemCloseWorkerWhenCloseIsCalledMultipleTi
     worker->close(true);
     EXPECT_EQ(nullptr, worker->thread);
 }
+
+TEST_F(DrmGemCloseWorkerTests, givenMaxQueueDepthWhenQueueIsFullThenPushWaitsUntilWorkerTakesQueuedObjects) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.GemCloseWorkerMaxQueueDepth.set(2);
+    this->drmMock->gem_close_expected = 4;
+
+    auto worker = std::make_unique<MockDrmGemCloseWorker>(*mm);
+    EXPECT_EQ(2u, worker->maxQueueDepth);
+
+    //block worker on first object
+    std::unique_lock<std::mutex> ioctlLock(drmMock->mutex);
+    worker->push(new BufferObjectWrapper(this->drmMock, 1));
+    while (worker->getQueueSize() != 0 && (deadCnt-- > 0))
+        pthread_yield();
+
+    std::atomic<int> pushedCount{0};
+    std::thread producer([&]() {
+        for (int handle = 2; handle <= 4; handle++) {
+            worker->push(new BufferObjectWrapper(this->drmMock, handle));
+            pushedCount++;
+        }
+    });
+
+    while (pushedCount.load() != 2 && (deadCnt-- > 0))
+        pthread_yield();
+    for (int i = 0; i < 1000; i++)
+        pthread_yield();
+
+    EXPECT_EQ(2, pushedCount.load());
+    EXPECT_EQ(2u, worker->getQueueSize());
+
+    ioctlLock.unlock();
+    producer.join();
+    EXPECT_EQ(3, pushedCount.load());
+
+    worker.reset();
+    EXPECT_EQ(4, this->drmMock->gem_close_cnt.load());
+}
+
+TEST_F(DrmGemCloseWorkerTests, givenQueuedObjectsWhenWorkerIsClosedThenAllObjectsAreClosedBeforeThreadExits) {
+    constexpr int objectsCount = 100;
+    this->drmMock->gem_close_expected = objectsCount;
+
+    auto worker = std::make_unique<MockDrmGemCloseWorker>(*mm);
+    std::unique_lock<std::mutex> ioctlLock(drmMock->mutex);
+    for (int handle = 0; handle < objectsCount; handle++) {
+        worker->push(new BufferObjectWrapper(this->drmMock, handle));
+    }
+    worker->close(false);
+    ioctlLock.unlock();
+
+    worker->close(true);
+    EXPECT_TRUE(worker->isEmpty());
+    EXPECT_EQ(0u, worker->getQueueSize());
+    EXPECT_EQ(objectsCount, this->drmMock->gem_close_cnt.load());
+}
+
+TEST_F(DrmGemCloseWorkerTests, givenClosedWorkerWhenObjectIsPushedThenItIsClosedFromCallingThread) {
+    this->drmMock->gem_close_expected = 1;
+
+    auto worker = std::make_unique<MockDrmGemCloseWorker>(*mm);
+    worker->close(true);
+
+    worker->push(new BufferObjectWrapper(this->drmMock, 1));
+    EXPECT_TRUE(worker->isEmpty());
+    EXPECT_EQ(1, this->drmMock->gem_close_cnt.load());
+    EXPECT_EQ(drmMock->ioctl_caller_thread_id, std::this_thread::get_id());
+}
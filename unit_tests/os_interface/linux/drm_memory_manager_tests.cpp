@@ -46,6 +46,7 @@
 
 #include <iostream>
 #include <memory>
+#include <thread>
 
 using namespace OCLRT;
 
@@ -3066,3 +3067,218 @@ TEST_F(DrmMemoryManagerTest, givenDisabledHostPtrTrackingWhenAllocateGraphicsMem
 
     memoryManager->freeGraphicsMemory(allocation);
 }
+
+TEST_F(DrmMemoryManagerTest, givenUserptrBufferObjectCacheDisabledWhenAllocationIsFreedThenBufferObjectIsClosed) {
+    mock->ioctl_expected.gemUserptr = 2;
+    mock->ioctl_expected.gemWait = 2;
+    mock->ioctl_expected.gemClose = 2;
+
+    EXPECT_EQ(0u, memoryManager->getUserptrBufferObjectCacheLimit());
+
+    for (int i = 0; i < 2; i++) {
+        auto allocation = memoryManager->allocateGraphicsMemoryWithProperties(createAllocationProperties(MemoryConstants::pageSize, false));
+        ASSERT_NE(nullptr, allocation);
+        memoryManager->freeGraphicsMemory(allocation);
+        EXPECT_EQ(0u, memoryManager->getUserptrBufferObjectCacheSize());
+    }
+}
+
+TEST_F(DrmMemoryManagerTest, givenUserptrBufferObjectCacheEnabledWhenAllocationsOfSameSizeAreCreatedAndFreedThenUserptrIoctlIsIssuedOnce) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.UserptrBufferObjectCacheSizeMB.set(1);
+
+    constexpr int cycles = 10;
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = cycles;
+    mock->ioctl_expected.gemClose = 1;
+
+    auto memoryManager = std::make_unique<TestedDrmMemoryManager>(this->mock, *executionEnvironment);
+    EXPECT_EQ(MemoryConstants::megaByte, memoryManager->getUserptrBufferObjectCacheLimit());
+
+    BufferObject *firstBo = nullptr;
+    void *firstCpuPtr = nullptr;
+    for (int i = 0; i < cycles; i++) {
+        auto allocation = static_cast<DrmAllocation *>(memoryManager->allocateGraphicsMemoryWithProperties(createAllocationProperties(MemoryConstants::pageSize, false)));
+        ASSERT_NE(nullptr, allocation);
+        if (i == 0) {
+            firstBo = allocation->getBO();
+            firstCpuPtr = allocation->getUnderlyingBuffer();
+        }
+        EXPECT_EQ(firstBo, allocation->getBO());
+        EXPECT_EQ(firstCpuPtr, allocation->getUnderlyingBuffer());
+        EXPECT_EQ(firstCpuPtr, allocation->getBO()->peekAddress());
+        EXPECT_EQ(0u, memoryManager->getUserptrBufferObjectCacheSize());
+
+        memoryManager->freeGraphicsMemory(allocation);
+        EXPECT_EQ(MemoryConstants::pageSize, memoryManager->getUserptrBufferObjectCacheSize());
+    }
+}
+
+TEST_F(DrmMemoryManagerTest, givenUserptrBufferObjectCacheEnabledWhenAllocationOfDifferentSizeIsCreatedThenCachedBufferObjectIsNotUsed) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.UserptrBufferObjectCacheSizeMB.set(1);
+
+    mock->ioctl_expected.gemUserptr = 2;
+    mock->ioctl_expected.gemWait = 2;
+    mock->ioctl_expected.gemClose = 2;
+
+    auto memoryManager = std::make_unique<TestedDrmMemoryManager>(this->mock, *executionEnvironment);
+
+    auto allocation = static_cast<DrmAllocation *>(memoryManager->allocateGraphicsMemoryWithProperties(createAllocationProperties(MemoryConstants::pageSize, false)));
+    ASSERT_NE(nullptr, allocation);
+    auto cachedBo = allocation->getBO();
+    memoryManager->freeGraphicsMemory(allocation);
+
+    auto biggerAllocation = static_cast<DrmAllocation *>(memoryManager->allocateGraphicsMemoryWithProperties(createAllocationProperties(2 * MemoryConstants::pageSize, false)));
+    ASSERT_NE(nullptr, biggerAllocation);
+    EXPECT_NE(cachedBo, biggerAllocation->getBO());
+    EXPECT_EQ(MemoryConstants::pageSize, memoryManager->getUserptrBufferObjectCacheSize());
+
+    memoryManager->freeGraphicsMemory(biggerAllocation);
+    EXPECT_EQ(3 * MemoryConstants::pageSize, memoryManager->getUserptrBufferObjectCacheSize());
+}
+
+TEST_F(DrmMemoryManagerTest, givenFullUserptrBufferObjectCacheWhenAllocationIsFreedThenCacheIsTrimmedToItsLimit) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.UserptrBufferObjectCacheSizeMB.set(1);
+
+    mock->ioctl_expected.gemUserptr = 3;
+    mock->ioctl_expected.gemWait = 3;
+    mock->ioctl_expected.gemClose = 3;
+
+    auto memoryManager = std::make_unique<TestedDrmMemoryManager>(this->mock, *executionEnvironment);
+    size_t size = 768 * MemoryConstants::kiloByte;
+
+    auto allocation1 = memoryManager->allocateGraphicsMemoryWithProperties(createAllocationProperties(size, false));
+    auto allocation2 = memoryManager->allocateGraphicsMemoryWithProperties(createAllocationProperties(size, false));
+    auto tooBigAllocation = memoryManager->allocateGraphicsMemoryWithProperties(createAllocationProperties(2 * MemoryConstants::megaByte, false));
+    ASSERT_NE(nullptr, allocation1);
+    ASSERT_NE(nullptr, allocation2);
+    ASSERT_NE(nullptr, tooBigAllocation);
+
+    memoryManager->freeGraphicsMemory(allocation1);
+    EXPECT_EQ(size, memoryManager->getUserptrBufferObjectCacheSize());
+    memoryManager->freeGraphicsMemory(allocation2);
+    EXPECT_EQ(size, memoryManager->getUserptrBufferObjectCacheSize());
+    EXPECT_EQ(1, mock->ioctl_cnt.gemClose);
+
+    memoryManager->freeGraphicsMemory(tooBigAllocation);
+    EXPECT_EQ(size, memoryManager->getUserptrBufferObjectCacheSize());
+    EXPECT_EQ(2, mock->ioctl_cnt.gemClose);
+
+    memoryManager->trimUserptrBufferObjectCache(0u);
+    EXPECT_EQ(0u, memoryManager->getUserptrBufferObjectCacheSize());
+    EXPECT_EQ(3, mock->ioctl_cnt.gemClose);
+}
+
+TEST_F(DrmMemoryManagerTest, givenCachedUserptrBufferObjectsWhenSystemMemoryAllocationFailsThenCacheIsReleasedAndAllocationIsRetried) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.UserptrBufferObjectCacheSizeMB.set(1);
+
+    class MemoryManagerWithFailingMalloc : public TestedDrmMemoryManager {
+      public:
+        using TestedDrmMemoryManager::TestedDrmMemoryManager;
+        void *alignedMallocWrapper(size_t bytes, size_t alignment) override {
+            if (failedMallocs > 0) {
+                failedMallocs--;
+                return nullptr;
+            }
+            return TestedDrmMemoryManager::alignedMallocWrapper(bytes, alignment);
+        }
+        int failedMallocs = 0;
+    };
+
+    mock->ioctl_expected.gemUserptr = 2;
+    mock->ioctl_expected.gemWait = 2;
+    mock->ioctl_expected.gemClose = 2;
+
+    auto memoryManager = std::make_unique<MemoryManagerWithFailingMalloc>(this->mock, *executionEnvironment);
+
+    auto allocation = memoryManager->allocateGraphicsMemoryWithProperties(createAllocationProperties(MemoryConstants::pageSize, false));
+    ASSERT_NE(nullptr, allocation);
+    memoryManager->freeGraphicsMemory(allocation);
+    EXPECT_EQ(MemoryConstants::pageSize, memoryManager->getUserptrBufferObjectCacheSize());
+
+    memoryManager->failedMallocs = 1;
+    allocation = memoryManager->allocateGraphicsMemoryWithProperties(createAllocationProperties(2 * MemoryConstants::pageSize, false));
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(0, memoryManager->failedMallocs);
+    EXPECT_EQ(0u, memoryManager->getUserptrBufferObjectCacheSize());
+    EXPECT_EQ(1, mock->ioctl_cnt.gemClose);
+
+    memoryManager->freeGraphicsMemory(allocation);
+    memoryManager->trimUserptrBufferObjectCache(0u);
+}
+
+class DrmMockWithBlockingWait : public DrmMockCustom {
+  public:
+    int ioctl(unsigned long request, void *arg) override {
+        if (request == DRM_IOCTL_I915_GEM_WAIT) {
+            waitCallerThreadId = std::this_thread::get_id();
+            while (blockWait) {
+                std::this_thread::yield();
+            }
+        }
+        return DrmMockCustom::ioctl(request, arg);
+    }
+
+    std::atomic<bool> blockWait{false};
+    std::atomic<std::thread::id> waitCallerThreadId;
+};
+
+TEST_F(DrmMemoryManagerTest, givenActiveGemCloseWorkerWhenAllocationStillUsedByGpuIsFreedThenCallIsNotBlockedAndBufferObjectIsReleasedByWorker) {
+    DrmMockWithBlockingWait blockingDrm;
+    DrmMemoryManager drmMemoryManager(&blockingDrm, gemCloseWorkerMode::gemCloseWorkerActive, false, false, *executionEnvironment);
+    ASSERT_NE(nullptr, drmMemoryManager.peekGemCloseWorker());
+
+    auto csr = device->getDefaultEngine().commandStreamReceiver;
+    auto allocation = drmMemoryManager.allocateGraphicsMemoryWithProperties(createAllocationProperties(MemoryConstants::pageSize, false));
+    ASSERT_NE(nullptr, allocation);
+    allocation->updateTaskCount(*csr->getTagAddress() + 1, csr->getOsContext().getContextId());
+
+    blockingDrm.blockWait = true;
+    drmMemoryManager.freeGraphicsMemory(allocation);
+    EXPECT_FALSE(drmMemoryManager.peekGemCloseWorker()->isEmpty());
+    EXPECT_EQ(0, blockingDrm.ioctl_cnt.gemClose);
+
+    blockingDrm.blockWait = false;
+    uint32_t deadCount = 10 * 1000 * 1000;
+    while (!drmMemoryManager.peekGemCloseWorker()->isEmpty() && deadCount-- > 0) {
+        std::this_thread::yield();
+    }
+    EXPECT_TRUE(drmMemoryManager.peekGemCloseWorker()->isEmpty());
+    EXPECT_EQ(1, blockingDrm.ioctl_cnt.gemWait);
+    EXPECT_EQ(1, blockingDrm.ioctl_cnt.gemClose);
+    EXPECT_NE(std::this_thread::get_id(), blockingDrm.waitCallerThreadId.load());
+}
+
+TEST_F(DrmMemoryManagerTest, givenActiveGemCloseWorkerWhenAllocationCompletedByGpuIsFreedThenBufferObjectIsReleasedByCallingThread) {
+    DrmMockWithBlockingWait blockingDrm;
+    DrmMemoryManager drmMemoryManager(&blockingDrm, gemCloseWorkerMode::gemCloseWorkerActive, false, false, *executionEnvironment);
+
+    auto csr = device->getDefaultEngine().commandStreamReceiver;
+    auto allocation = drmMemoryManager.allocateGraphicsMemoryWithProperties(createAllocationProperties(MemoryConstants::pageSize, false));
+    ASSERT_NE(nullptr, allocation);
+    allocation->updateTaskCount(*csr->getTagAddress(), csr->getOsContext().getContextId());
+
+    drmMemoryManager.freeGraphicsMemory(allocation);
+    EXPECT_TRUE(drmMemoryManager.peekGemCloseWorker()->isEmpty());
+    EXPECT_EQ(1, blockingDrm.ioctl_cnt.gemClose);
+    EXPECT_EQ(std::this_thread::get_id(), blockingDrm.waitCallerThreadId.load());
+}
+
+TEST_F(DrmMemoryManagerTest, givenClosedGemCloseWorkerWhenAllocationStillUsedByGpuIsFreedThenBufferObjectIsReleasedByCallingThread) {
+    DrmMockWithBlockingWait blockingDrm;
+    DrmMemoryManager drmMemoryManager(&blockingDrm, gemCloseWorkerMode::gemCloseWorkerActive, false, false, *executionEnvironment);
+    drmMemoryManager.peekGemCloseWorker()->close(true);
+    EXPECT_FALSE(drmMemoryManager.peekGemCloseWorker()->isActive());
+
+    auto csr = device->getDefaultEngine().commandStreamReceiver;
+    auto allocation = drmMemoryManager.allocateGraphicsMemoryWithProperties(createAllocationProperties(MemoryConstants::pageSize, false));
+    ASSERT_NE(nullptr, allocation);
+    allocation->updateTaskCount(*csr->getTagAddress() + 1, csr->getOsContext().getContextId());
+
+    drmMemoryManager.freeGraphicsMemory(allocation);
+    EXPECT_EQ(1, blockingDrm.ioctl_cnt.gemClose);
+    EXPECT_EQ(std::this_thread::get_id(), blockingDrm.waitCallerThreadId.load());
+}
@@ -5,6 +5,7 @@
  *
  */
 
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/os_interface/linux/device_command_stream_fixture.h"
 #include "unit_tests/os_interface/linux/mock_os_time_linux.h"
 #include "runtime/os_interface/linux/drm_neo.h"
@@ -13,6 +14,8 @@
 #include "runtime/os_interface/linux/os_interface.h"
 #include "runtime/os_interface/linux/os_time_linux.h"
 
+#include <algorithm>
+#include <cmath>
 #include <dlfcn.h>
 
 static int actualTime = 0;
@@ -35,6 +38,32 @@ int resolutionFuncTrue(clockid_t clkId, struct timespec *res) throw() {
     return 0;
 }
 
+static uint64_t syntheticCpuTime = 0;
+
+int getTimeFuncSynthetic(clockid_t clkId, struct timespec *tp) throw() {
+    tp->tv_sec = static_cast<time_t>(syntheticCpuTime / 1000000000ull);
+    tp->tv_nsec = static_cast<long>(syntheticCpuTime % 1000000000ull);
+    return 0;
+}
+
+// GPU clock running 1.2 ticks per CPU ns with slowly increasing drift
+class DrmMockDriftingTime : public DrmMockSuccess {
+  public:
+    int ioctl(unsigned long request, void *arg) override {
+        drm_i915_reg_read *reg = reinterpret_cast<drm_i915_reg_read *>(arg);
+        reg->val = getGpuTime(syntheticCpuTime);
+        regReadsCount++;
+        return 0;
+    };
+
+    static uint64_t getGpuTime(uint64_t cpuTime) {
+        auto cpuTimeUs = cpuTime / 1000;
+        return cpuTime * 6 / 5 + cpuTimeUs * cpuTimeUs / 50000;
+    }
+
+    uint32_t regReadsCount = 0;
+};
+
 using namespace OCLRT;
 struct DrmTimeTest : public ::testing::Test {
   public:
@@ -221,3 +250,71 @@ TEST_F(DrmTimeTest, givenAlwaysPassingResolutionFuncWhenGetCpuRawTimestampIsCall
     auto retVal = osTime->getCpuRawTimestamp();
     EXPECT_EQ(1ull, retVal);
 }
+
+struct DrmCalibratedTimeTest : public DrmTimeTest {
+    void SetUp() override {
+        DrmTimeTest::SetUp();
+        syntheticCpuTime = 1000000000ull;
+        osTime->setGetTimeFunc(getTimeFuncSynthetic);
+        drm = new DrmMockDriftingTime();
+        osTime->updateDrm(drm);
+        drm->regReadsCount = 0;
+    }
+
+    void TearDown() override {
+        DrmTimeTest::TearDown();
+        delete drm;
+    }
+
+    DrmMockDriftingTime *drm = nullptr;
+};
+
+TEST_F(DrmCalibratedTimeTest, givenCalibratedClockModelWhenTimestampsAreQueriedWithinCalibrationIntervalThenGpuClockIsNotRead) {
+    TimeStampData timestamp = {};
+    EXPECT_TRUE(osTime->getCalibratedCpuGpuTime(&timestamp));
+    syntheticCpuTime += 2 * OSTime::minClockCalibrationIntervalNs;
+    EXPECT_TRUE(osTime->getCalibratedCpuGpuTime(&timestamp));
+    EXPECT_TRUE(osTime->peekClockModel().hasSlope);
+    auto regReadsCount = drm->regReadsCount;
+    auto calibrationsCount = osTime->getClockCalibrationsCount();
+
+    auto previousGpuTime = timestamp.GPUTimeStamp;
+    for (int i = 0; i < 10; i++) {
+        syntheticCpuTime += 10000;
+        EXPECT_TRUE(osTime->getCalibratedCpuGpuTime(&timestamp));
+        EXPECT_EQ(syntheticCpuTime, timestamp.CPUTimeinNS);
+        EXPECT_GT(timestamp.GPUTimeStamp, previousGpuTime);
+        previousGpuTime = timestamp.GPUTimeStamp;
+    }
+    EXPECT_EQ(regReadsCount, drm->regReadsCount);
+    EXPECT_EQ(calibrationsCount, osTime->getClockCalibrationsCount());
+}
+
+TEST_F(DrmCalibratedTimeTest, givenDriftingGpuClockWhenCalibratedTimestampsAreQueriedThenErrorStaysBoundedWithRareCalibrations) {
+    constexpr uint32_t queriesCount = 100000;
+    double maxErrorNs = 0;
+    TimeStampData timestamp = {};
+    for (uint32_t i = 0; i < queriesCount; i++) {
+        syntheticCpuTime += 50000;
+        EXPECT_TRUE(osTime->getCalibratedCpuGpuTime(&timestamp));
+        auto expectedGpuTime = static_cast<double>(DrmMockDriftingTime::getGpuTime(syntheticCpuTime));
+        auto errorNs = std::abs(static_cast<double>(timestamp.GPUTimeStamp) - expectedGpuTime) / 1.2;
+        maxErrorNs = std::max(maxErrorNs, errorNs);
+    }
+    EXPECT_LE(maxErrorNs, 2.0 * OSTime::maxClockModelErrorNs);
+    EXPECT_LT(osTime->getClockCalibrationsCount(), queriesCount / 100);
+    EXPECT_LE(osTime->peekClockModel().calibrationIntervalNs, OSTime::defaultClockCalibrationIntervalNs);
+}
+
+TEST_F(DrmCalibratedTimeTest, givenClockCalibrationDisabledWhenCalibratedTimestampIsQueriedThenGpuClockIsReadEveryTime) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.ProfilingClockCalibrationIntervalMs.set(0);
+    TimeStampData timestamp = {};
+    for (uint32_t i = 0; i < 4; i++) {
+        syntheticCpuTime += 10000;
+        EXPECT_TRUE(osTime->getCalibratedCpuGpuTime(&timestamp));
+        EXPECT_EQ(DrmMockDriftingTime::getGpuTime(syntheticCpuTime), timestamp.GPUTimeStamp);
+    }
+    EXPECT_EQ(4u, drm->regReadsCount);
+    EXPECT_EQ(0u, osTime->getClockCalibrationsCount());
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -10,6 +10,7 @@
 #elif defined(__linux__)
 #include "runtime/os_interface/linux/os_library.h"
 #endif
+#include "runtime/helpers/file_io.h"
 #include "runtime/os_interface/os_library.h"
 #include "test.h"
 #include "unit_tests/helpers/memory_management.h"
@@ -66,6 +67,14 @@ TEST_F(OSLibraryTest, whenSymbolNameIsValidThenGetProcAddressReturnsNonNullPoint
     EXPECT_NE(nullptr, ptr);
 }
 
+TEST_F(OSLibraryTest, whenLibraryIsLoadedThenFullPathPointsToLoadedFile) {
+    std::unique_ptr<OsLibrary> library(OsLibrary::load(Os::testDllName));
+    ASSERT_NE(nullptr, library);
+    auto fullPath = library->getFullPath();
+    EXPECT_NE(std::string::npos, fullPath.find(Os::testDllName));
+    EXPECT_TRUE(fileExists(fullPath));
+}
+
 TEST_F(OSLibraryTest, whenSymbolNameIsInvalidThenGetProcAddressReturnsNullPointer) {
     std::unique_ptr<OsLibrary> library(OsLibrary::load(Os::testDllName));
     EXPECT_NE(nullptr, library);
@@ -99,6 +108,7 @@ TEST(OsLibrary, whenCallingIndexOperatorThenObjectConvertibleToFunctionOrVoidPoi
             return ptrToReturn;
         }
         bool isLoaded() override { return true; }
+        std::string getFullPath() override { return std::string(); }
 
         void *ptrToReturn = nullptr;
         std::string lastRequestedProcName;
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "elf/reader.h"
+#include "elf/writer.h"
+#include "runtime/helpers/hash.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace CLElfLib;
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+struct ElfPerfTest : public ::testing::Test {
+    static constexpr size_t sectionsCount = 100;
+    static constexpr size_t sectionSize = 1024 * 1024;
+
+    void SetUp() override {
+        sectionData.assign(sectionSize, 'x');
+        CElfWriter writer(E_EH_TYPE::EH_TYPE_OPENCL_EXECUTABLE, E_EH_MACHINE::EH_MACHINE_NONE, 0);
+        addSections(writer, true);
+        binary.resize(writer.getTotalBinarySize());
+        writer.resolveBinary(binary);
+    }
+
+    void addSections(CElfWriter &writer, bool reference) {
+        for (size_t i = 0; i < sectionsCount; i++) {
+            auto name = "section" + std::to_string(i);
+            if (reference) {
+                writer.addSectionWithDataReference(E_SH_TYPE::SH_TYPE_OPENCL_DEV_BINARY, E_SH_FLAG::SH_FLAG_NONE, name, sectionData.data(), sectionSize);
+            } else {
+                writer.addSection(SSectionNode(E_SH_TYPE::SH_TYPE_OPENCL_DEV_BINARY, E_SH_FLAG::SH_FLAG_NONE, name, std::string(sectionData.data(), sectionSize), sectionSize));
+            }
+        }
+    }
+
+    template <typename OperationT>
+    void measure(const char *testName, OperationT &&operation) {
+        double previousRatio = -1.0;
+        uint64_t hash = Hash::hash(testName, strlen(testName));
+
+        bool success = getTestRatio(hash, previousRatio);
+        long long times[3] = {0, 0, 0};
+
+        for (int i = 0; i < 3; i++) {
+            Timer t;
+            t.start();
+            operation();
+            t.end();
+
+            times[i] = t.get();
+        }
+
+        long long time = majorityVote(times[0], times[1], times[2]);
+        double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+        std::cout << testName << ": " << static_cast<double>(binary.size()) / static_cast<double>(time) << " GB/s" << std::endl;
+
+        if (success && previousRatio > ratioThreshold) {
+            EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+        }
+
+        updateTestRatio(hash, ratio);
+    }
+
+    std::vector<char> sectionData;
+    ElfBinaryStorage binary;
+};
+
+TEST_F(ElfPerfTest, writeCopiedSections) {
+    measure("ElfPerfTest.writeCopiedSections", [&]() {
+        CElfWriter writer(E_EH_TYPE::EH_TYPE_OPENCL_EXECUTABLE, E_EH_MACHINE::EH_MACHINE_NONE, 0);
+        addSections(writer, false);
+        ElfBinaryStorage output(writer.getTotalBinarySize());
+        writer.resolveBinary(output);
+    });
+}
+
+TEST_F(ElfPerfTest, writeReferencedSections) {
+    measure("ElfPerfTest.writeReferencedSections", [&]() {
+        CElfWriter writer(E_EH_TYPE::EH_TYPE_OPENCL_EXECUTABLE, E_EH_MACHINE::EH_MACHINE_NONE, 0);
+        addSections(writer, true);
+        ElfBinaryStorage output(writer.getTotalBinarySize());
+        writer.resolveBinary(output);
+    });
+}
+
+TEST_F(ElfPerfTest, readCopiedBinary) {
+    size_t dataSize = 0;
+    measure("ElfPerfTest.readCopiedBinary", [&]() {
+        ElfBinaryStorage binaryCopy(binary.begin(), binary.end());
+        CElfReader elfReader(binaryCopy);
+        dataSize = 0;
+        for (auto &sectionHeader : elfReader.getSectionHeaders()) {
+            dataSize += static_cast<size_t>(sectionHeader.DataSize);
+        }
+    });
+    EXPECT_LE(sectionsCount * sectionSize, dataSize);
+}
+
+TEST_F(ElfPerfTest, readBinaryInPlace) {
+    size_t dataSize = 0;
+    measure("ElfPerfTest.readBinaryInPlace", [&]() {
+        CElfReader elfReader(binary.data(), binary.size());
+        dataSize = 0;
+        for (size_t i = 0; i < elfReader.getSectionsCount(); i++) {
+            dataSize += static_cast<size_t>(elfReader.getSectionHeader(i).DataSize);
+        }
+    });
+    EXPECT_LE(sectionsCount * sectionSize, dataSize);
+}
+} // namespace ULT
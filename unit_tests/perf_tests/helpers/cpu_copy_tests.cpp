@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/cpu_copy.h"
+#include "runtime/helpers/hash.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <cstring>
+#include <iostream>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+struct CpuCopyPerfTest : public ::testing::Test {
+    static constexpr size_t copySize = 64 * 1024 * 1024;
+    static constexpr size_t rowPitch = 16 * 1024;
+    static constexpr size_t rowSize = rowPitch - 256;
+
+    void SetUp() override {
+        src = alignedMalloc(copySize, MemoryConstants::pageSize);
+        dst = alignedMalloc(copySize, MemoryConstants::pageSize);
+        memset(src, 1, copySize);
+        memset(dst, 0, copySize);
+    }
+
+    void TearDown() override {
+        alignedFree(src);
+        alignedFree(dst);
+    }
+
+    template <typename CopyT>
+    void measure(const char *testName, size_t bytesCopied, CopyT &&copy) {
+        double previousRatio = -1.0;
+        uint64_t hash = Hash::hash(testName, strlen(testName));
+
+        bool success = getTestRatio(hash, previousRatio);
+        long long times[3] = {0, 0, 0};
+
+        for (int i = 0; i < 3; i++) {
+            Timer t;
+            t.start();
+            copy();
+            t.end();
+
+            times[i] = t.get();
+        }
+
+        long long time = majorityVote(times[0], times[1], times[2]);
+        double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+        std::cout << testName << ": " << static_cast<double>(bytesCopied) / static_cast<double>(time) << " GB/s" << std::endl;
+
+        if (success && previousRatio > ratioThreshold) {
+            EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+        }
+
+        updateTestRatio(hash, ratio);
+    }
+
+    void *src = nullptr;
+    void *dst = nullptr;
+};
+
+TEST_F(CpuCopyPerfTest, memcpyReference) {
+    measure("CpuCopyPerfTest.memcpyReference", copySize, [&]() { memcpy(dst, src, copySize); });
+}
+
+TEST_F(CpuCopyPerfTest, copy) {
+    measure("CpuCopyPerfTest.copy", copySize, [&]() { CpuCopy::copy(dst, src, copySize); });
+}
+
+TEST_F(CpuCopyPerfTest, copyNonTemporal) {
+    measure("CpuCopyPerfTest.copyNonTemporal", copySize, [&]() { CpuCopy::copyNonTemporal(dst, src, copySize); });
+}
+
+TEST_F(CpuCopyPerfTest, copyRegion) {
+    const size_t rowsCount = copySize / rowPitch;
+    measure("CpuCopyPerfTest.copyRegion", rowSize * rowsCount, [&]() {
+        CpuCopy::copyRegion(dst, rowPitch, copySize, src, rowPitch, copySize, rowSize, rowsCount, 1);
+    });
+}
+} // namespace ULT
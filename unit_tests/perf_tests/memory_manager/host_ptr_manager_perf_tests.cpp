@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "unit_tests/perf_tests/perf_test_utils.h"
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/hash.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/memory_manager/memory_constants.h"
+#include "unit_tests/mocks/mock_allocation_properties.h"
+#include "unit_tests/mocks/mock_host_ptr_manager.h"
+#include "unit_tests/mocks/mock_memory_manager.h"
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+struct HostPtrManagerPerfTest : public ::testing::TestWithParam<uint32_t /*threads count*/> {
+    static constexpr size_t pagesPerThread = 4;
+    static constexpr uint32_t maxThreadsCount = 16;
+    static constexpr uint32_t iterations = 10000;
+
+    void SetUp() override {
+        threadsCount = GetParam();
+        memoryManager.reset(new MockMemoryManager(executionEnvironment));
+        hostPtrManager = static_cast<MockHostPtrManager *>(memoryManager->getHostPtrManager());
+        // one region per thread and one page shared by all threads
+        hostMemory = alignedMalloc((maxThreadsCount * pagesPerThread + 1) * MemoryConstants::pageSize, MemoryConstants::pageSize);
+    }
+
+    void TearDown() override {
+        EXPECT_EQ(0u, hostPtrManager->getFragmentCount());
+        memoryManager.reset();
+        alignedFree(hostMemory);
+    }
+
+    // each thread repeatedly wraps unaligned pointer from its own region (leading, middle and trailing fragment)
+    // and a pointer to page shared by all threads (single fragment referenced concurrently)
+    uint32_t runThreads() {
+        std::atomic<bool> start{false};
+        std::atomic<uint32_t> failures{0};
+        std::vector<std::thread> threads;
+        auto sharedPtr = ptrOffset(hostMemory, maxThreadsCount * pagesPerThread * MemoryConstants::pageSize + 0x10);
+
+        for (uint32_t t = 0; t < threadsCount; t++) {
+            auto ownPtr = ptrOffset(hostMemory, t * pagesPerThread * MemoryConstants::pageSize + MemoryConstants::pageSize / 2);
+            threads.emplace_back([&, ownPtr]() {
+                while (!start.load())
+                    ;
+                for (uint32_t i = 0; i < iterations; i++) {
+                    auto ownAllocation = memoryManager->allocateGraphicsMemory(MockAllocationProperties{false, (pagesPerThread - 1) * MemoryConstants::pageSize}, ownPtr);
+                    auto sharedAllocation = memoryManager->allocateGraphicsMemory(MockAllocationProperties{false, 0x100}, sharedPtr);
+                    if (ownAllocation == nullptr || sharedAllocation == nullptr) {
+                        failures++;
+                    }
+                    memoryManager->freeGraphicsMemory(ownAllocation);
+                    memoryManager->freeGraphicsMemory(sharedAllocation);
+                }
+            });
+        }
+        start = true;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        return failures.load();
+    }
+
+    template <typename OperationT>
+    void measure(const char *testName, OperationT &&operation) {
+        double previousRatio = -1.0;
+        uint64_t hash = Hash::hash(testName, strlen(testName));
+
+        bool success = getTestRatio(hash, previousRatio);
+        long long times[3] = {0, 0, 0};
+
+        for (int i = 0; i < 3; i++) {
+            Timer t;
+            t.start();
+            operation();
+            t.end();
+
+            times[i] = t.get();
+        }
+
+        long long time = majorityVote(times[0], times[1], times[2]);
+        double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+        std::cout << testName << ": " << static_cast<double>(2 * threadsCount * iterations) * 1000000.0 / static_cast<double>(time) << " allocations/ms" << std::endl;
+
+        if (success && previousRatio > ratioThreshold) {
+            EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+        }
+
+        updateTestRatio(hash, ratio);
+    }
+
+    uint32_t threadsCount = 1;
+    ExecutionEnvironment executionEnvironment;
+    std::unique_ptr<MockMemoryManager> memoryManager;
+    MockHostPtrManager *hostPtrManager = nullptr;
+    void *hostMemory = nullptr;
+};
+
+TEST_P(HostPtrManagerPerfTest, hostPtrAllocationThroughput) {
+    auto testName = "HostPtrManagerPerfTest.hostPtrAllocationThroughput/threads" + std::to_string(threadsCount);
+    measure(testName.c_str(), [&]() {
+        EXPECT_EQ(0u, runThreads());
+    });
+}
+
+INSTANTIATE_TEST_CASE_P(HostPtrManager,
+                        HostPtrManagerPerfTest,
+                        ::testing::Values(1u, 2u, 4u, 8u, 16u));
+} // namespace ULT
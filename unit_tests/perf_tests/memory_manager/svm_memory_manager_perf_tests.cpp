@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "unit_tests/perf_tests/perf_test_utils.h"
+#include "runtime/helpers/hash.h"
+#include "runtime/memory_manager/svm_memory_manager.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_memory_manager.h"
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+struct SVMAllocsManagerPerfTest : public ::testing::TestWithParam<std::tuple<int32_t /*small allocation threshold*/, uint32_t /*threads count*/>> {
+    static constexpr uint32_t allocationsPerThread = 10000;
+    static constexpr size_t allocationSize = 64;
+    static constexpr uint32_t lookupsPerAllocation = 16;
+
+    void SetUp() override {
+        std::tie(smallAllocationThreshold, threadsCount) = GetParam();
+        DebugManager.flags.SVMSmallAllocationThreshold.set(smallAllocationThreshold);
+        memoryManager.reset(new MockMemoryManager(false, false, executionEnvironment));
+        svmManager.reset(new SVMAllocsManager(memoryManager.get()));
+    }
+
+    void TearDown() override {
+        svmManager.reset();
+    }
+
+    // each thread keeps its own allocations alive while looking up pointers, then frees them
+    uint32_t runThreads() {
+        std::atomic<bool> start{false};
+        std::atomic<uint32_t> failures{0};
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < threadsCount; t++) {
+            threads.emplace_back([&]() {
+                std::vector<void *> ptrs;
+                ptrs.reserve(allocationsPerThread);
+                while (!start.load())
+                    ;
+                for (uint32_t i = 0; i < allocationsPerThread; i++) {
+                    auto ptr = svmManager->createSVMAlloc(allocationSize, false, false);
+                    if (ptr == nullptr) {
+                        failures++;
+                        continue;
+                    }
+                    ptrs.push_back(ptr);
+                }
+                for (uint32_t lookup = 0; lookup < lookupsPerAllocation; lookup++) {
+                    for (auto ptr : ptrs) {
+                        if (svmManager->getSVMAlloc(ptr) == nullptr) {
+                            failures++;
+                        }
+                    }
+                }
+                for (auto ptr : ptrs) {
+                    svmManager->freeSVMAlloc(ptr);
+                }
+            });
+        }
+        start = true;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        return failures.load();
+    }
+
+    template <typename OperationT>
+    void measure(const char *testName, OperationT &&operation) {
+        double previousRatio = -1.0;
+        uint64_t hash = Hash::hash(testName, strlen(testName));
+
+        bool success = getTestRatio(hash, previousRatio);
+        long long times[3] = {0, 0, 0};
+
+        for (int i = 0; i < 3; i++) {
+            Timer t;
+            t.start();
+            operation();
+            t.end();
+
+            times[i] = t.get();
+        }
+
+        long long time = majorityVote(times[0], times[1], times[2]);
+        double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+        std::cout << testName << ": " << static_cast<double>(threadsCount * allocationsPerThread) * 1000000.0 / static_cast<double>(time) << " allocations/ms" << std::endl;
+
+        if (success && previousRatio > ratioThreshold) {
+            EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+        }
+
+        updateTestRatio(hash, ratio);
+    }
+
+    int32_t smallAllocationThreshold = 0;
+    uint32_t threadsCount = 1;
+    DebugManagerStateRestore restore;
+    ExecutionEnvironment executionEnvironment;
+    std::unique_ptr<MockMemoryManager> memoryManager;
+    std::unique_ptr<SVMAllocsManager> svmManager;
+};
+
+TEST_P(SVMAllocsManagerPerfTest, smallAllocationsWithConcurrentLookups) {
+    auto testName = "SVMAllocsManagerPerfTest.smallAllocationsWithConcurrentLookups/threshold" + std::to_string(smallAllocationThreshold) +
+                    "/threads" + std::to_string(threadsCount);
+    measure(testName.c_str(), [&]() {
+        EXPECT_EQ(0u, runThreads());
+    });
+}
+
+// threshold 0 - small allocations are not carved out of slabs
+INSTANTIATE_TEST_CASE_P(SVMAllocsManager,
+                        SVMAllocsManagerPerfTest,
+                        ::testing::Combine(::testing::Values(0, 256),
+                                           ::testing::Values(1u, 2u, 4u, 8u)));
+} // namespace ULT
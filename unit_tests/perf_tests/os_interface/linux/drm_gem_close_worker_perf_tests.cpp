@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "unit_tests/perf_tests/perf_test_utils.h"
+#include "drm/i915_drm.h"
+#include "runtime/execution_environment/execution_environment.h"
+#include "runtime/helpers/hash.h"
+#include "runtime/os_interface/linux/drm_buffer_object.h"
+#include "runtime/os_interface/linux/drm_gem_close_worker.h"
+#include "runtime/os_interface/linux/drm_memory_manager.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+class DrmMockForCloseWorker : public Drm {
+  public:
+    DrmMockForCloseWorker() : Drm(33) {
+    }
+    int ioctl(unsigned long request, void *arg) override {
+        if (request == DRM_IOCTL_GEM_CLOSE) {
+            gemCloseCount++;
+        }
+        return 0;
+    }
+    std::atomic<int> gemCloseCount{0};
+};
+
+struct DrmGemCloseWorkerPerfTest : public ::testing::TestWithParam<int32_t /*max queue depth*/> {
+    static constexpr int objectsCount = 100000;
+
+    class BufferObjectWrapper : public BufferObject {
+      public:
+        BufferObjectWrapper(Drm *drm, int handle) : BufferObject(drm, handle, false) {
+        }
+    };
+
+    void SetUp() override {
+        DebugManager.flags.GemCloseWorkerMaxQueueDepth.set(GetParam());
+        drm.reset(new DrmMockForCloseWorker);
+        memoryManager.reset(new DrmMemoryManager(drm.get(), gemCloseWorkerMode::gemCloseWorkerInactive, false, false, executionEnvironment));
+    }
+
+    void TearDown() override {
+        memoryManager.reset();
+        drm.reset();
+    }
+
+    template <typename OperationT>
+    void measure(const char *testName, OperationT &&operation) {
+        double previousRatio = -1.0;
+        uint64_t hash = Hash::hash(testName, strlen(testName));
+
+        bool success = getTestRatio(hash, previousRatio);
+        long long times[3] = {0, 0, 0};
+
+        for (int i = 0; i < 3; i++) {
+            Timer t;
+            t.start();
+            operation();
+            t.end();
+
+            times[i] = t.get();
+        }
+
+        long long time = majorityVote(times[0], times[1], times[2]);
+        double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+        std::cout << testName << ": " << static_cast<double>(objectsCount) * 1000000.0 / static_cast<double>(time) << " objects/ms" << std::endl;
+
+        if (success && previousRatio > ratioThreshold) {
+            EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+        }
+
+        updateTestRatio(hash, ratio);
+    }
+
+    DebugManagerStateRestore restore;
+    ExecutionEnvironment executionEnvironment;
+    std::unique_ptr<DrmMockForCloseWorker> drm;
+    std::unique_ptr<DrmMemoryManager> memoryManager;
+};
+
+TEST_P(DrmGemCloseWorkerPerfTest, closeThroughput) {
+    auto testName = "DrmGemCloseWorkerPerfTest.closeThroughput/queueDepth" + std::to_string(GetParam());
+    measure(testName.c_str(), [&]() {
+        drm->gemCloseCount = 0;
+        auto worker = std::make_unique<DrmGemCloseWorker>(*memoryManager);
+        for (int handle = 0; handle < objectsCount; handle++) {
+            worker->push(new BufferObjectWrapper(drm.get(), handle));
+        }
+        worker->close(true);
+        EXPECT_EQ(objectsCount, drm->gemCloseCount.load());
+    });
+}
+
+// 0 - unbounded queue
+INSTANTIATE_TEST_CASE_P(DrmGemCloseWorker,
+                        DrmGemCloseWorkerPerfTest,
+                        ::testing::Values(0, 1, 16, 256, 4096));
+} // namespace ULT
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/helpers/hash.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/utilities/perf_profiler.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+struct PerfTracePerfTest : public ::testing::Test {
+    static constexpr int32_t eventsCount = 64 * 1024;
+
+    void SetUp() override {
+        previousBufferSize = DebugManager.flags.PerfTraceBufferSize.get();
+        DebugManager.flags.PerfTraceBufferSize.set(eventsCount);
+        drainedEvents.reserve(eventsCount);
+    }
+
+    void TearDown() override {
+        drainedEvents.clear();
+        PerfProfiler::drainTraceEvents(drainedEvents);
+        DebugManager.flags.PerfTraceBufferSize.set(previousBufferSize);
+    }
+
+    template <typename TraceT>
+    void measure(const char *testName, TraceT &&trace) {
+        double previousRatio = -1.0;
+        uint64_t hash = Hash::hash(testName, strlen(testName));
+
+        bool success = getTestRatio(hash, previousRatio);
+        long long times[3] = {0, 0, 0};
+
+        for (int i = 0; i < 3; i++) {
+            Timer t;
+            t.start();
+            for (int32_t event = 0; event < eventsCount; event++) {
+                trace();
+            }
+            t.end();
+
+            times[i] = t.get();
+            drainedEvents.clear();
+            PerfProfiler::drainTraceEvents(drainedEvents);
+        }
+
+        long long time = majorityVote(times[0], times[1], times[2]);
+        double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+        std::cout << testName << ": " << static_cast<double>(time) / static_cast<double>(eventsCount) << " ns per event" << std::endl;
+
+        if (success && previousRatio > ratioThreshold) {
+            EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+        }
+
+        updateTestRatio(hash, ratio);
+    }
+
+    int32_t previousBufferSize = 0;
+    std::vector<PerfTraceEvent> drainedEvents;
+};
+
+TEST_F(PerfTracePerfTest, traceScopeDisabled) {
+    DebugManager.flags.PerfTraceBufferSize.set(0);
+    measure("PerfTracePerfTest.traceScopeDisabled", []() { PERF_TRACE_SCOPE("disabled", Enqueue); });
+    EXPECT_TRUE(drainedEvents.empty());
+}
+
+TEST_F(PerfTracePerfTest, traceScopeEnabled) {
+    measure("PerfTracePerfTest.traceScopeEnabled", []() { PERF_TRACE_SCOPE("enabled", Enqueue); });
+    EXPECT_EQ(static_cast<size_t>(eventsCount), drainedEvents.size());
+}
+} // namespace ULT
@@ -1,10 +1,13 @@
 /*
- * Copyright (C) 2017-2018 Intel Corporation
+ * Copyright (C) 2017-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
  */
 
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/memory_manager/internal_allocation_storage.h"
+#include "runtime/memory_manager/memory_manager.h"
 #include "runtime/program/printf_handler.h"
 #include "unit_tests/fixtures/device_fixture.h"
 #include "unit_tests/mocks/mock_context.h"
@@ -143,3 +146,32 @@ TEST(PrintfHandlerTest, givenMultiDispatchInfoWithMultipleKernelsWhenCreatingAnd
     printfHandler->prepareDispatch(multiDispatchInfo);
     EXPECT_NE(nullptr, printfHandler->getSurface());
 }
+
+TEST(PrintfHandlerTest, givenReusableAllocationOfOtherTypeWhenPrintfHandlerIsPreparedThenAllocationIsReusedAsPrintfSurface) {
+    MockContext context;
+    std::unique_ptr<MockDevice> device(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+    auto program = std::make_unique<MockProgram>(*device->getExecutionEnvironment(), &context, false);
+    auto kernelInfo = std::make_unique<KernelInfo>();
+
+    auto printfSurface = std::make_unique<SPatchAllocateStatelessPrintfSurface>();
+    printfSurface->DataParamOffset = 0;
+    printfSurface->DataParamSize = 8;
+    kernelInfo->patchInfo.pAllocateStatelessPrintfSurface = printfSurface.get();
+
+    uint64_t crossThread[8];
+    auto kernel = std::make_unique<MockKernel>(program.get(), *kernelInfo, *device);
+    kernel->setCrossThreadData(&crossThread, sizeof(uint64_t) * 8);
+
+    auto reusableAllocation = device->getMemoryManager()->allocateGraphicsMemoryWithProperties({device->getDeviceInfo().printfBufferSize, GraphicsAllocation::AllocationType::FILL_PATTERN});
+    ASSERT_NE(nullptr, reusableAllocation);
+    auto internalAllocationStorage = device->getDefaultEngine().commandStreamReceiver->getInternalAllocationStorage();
+    internalAllocationStorage->storeAllocation(std::unique_ptr<GraphicsAllocation>(reusableAllocation), REUSABLE_ALLOCATION);
+
+    MockMultiDispatchInfo multiDispatchInfo(kernel.get());
+    std::unique_ptr<PrintfHandler> printfHandler(PrintfHandler::create(multiDispatchInfo, *device));
+    ASSERT_NE(nullptr, printfHandler.get());
+
+    printfHandler->prepareDispatch(multiDispatchInfo);
+    EXPECT_EQ(reusableAllocation, printfHandler->getSurface());
+    EXPECT_EQ(GraphicsAllocation::AllocationType::PRINTF_SURFACE, printfHandler->getSurface()->getAllocationType());
+}
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/hash.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/kernel/kernel.h"
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_device.h"
+#include "unit_tests/mocks/mock_memory_manager.h"
+#include "unit_tests/mocks/mock_program.h"
+#include "patch_list.h"
+#include "test.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+using namespace iOpenCL;
+
+struct ProcessGenBinaryTest : public ::testing::Test {
+    static constexpr uint32_t kernelHeapSize = 64;
+    static constexpr uint32_t crossThreadDataSize = 0x40;
+
+    void SetUp() override {
+        device.reset(MockDevice::createWithNewExecutionEnvironment<MockDevice>(platformDevices[0]));
+    }
+
+    std::unique_ptr<MockProgram> createProgram(const std::vector<char> &binary) {
+        auto program = std::make_unique<MockProgram>(*device->getExecutionEnvironment());
+        program->setDevice(device.get());
+        program->storeGenBinary(binary.data(), binary.size());
+        return program;
+    }
+
+    template <typename TokenT>
+    static void pushBackToken(std::vector<char> &container, const TokenT &token) {
+        auto begin = reinterpret_cast<const char *>(&token);
+        container.insert(container.end(), begin, begin + sizeof(token));
+    }
+
+    std::vector<char> createBinary(uint32_t numKernels, uint32_t invalidKernel = std::numeric_limits<uint32_t>::max()) {
+        std::vector<char> binary;
+
+        SProgramBinaryHeader programHeader = {};
+        programHeader.Magic = MAGIC_CL;
+        programHeader.Version = CURRENT_ICBE_VERSION;
+        programHeader.Device = platformDevices[0]->pPlatform->eRenderCoreFamily;
+        programHeader.GPUPointerSizeInBytes = 8;
+        programHeader.NumberOfKernels = numKernels;
+        pushBackToken(binary, programHeader);
+
+        for (uint32_t i = 0; i < numKernels; i++) {
+            std::string kernelName = "kernel_" + std::to_string(i);
+            kernelName.resize(alignUp(kernelName.size() + 1, 4), '\0');
+
+            std::vector<char> patchList;
+            if (i == invalidKernel) {
+                SPatchItemHeader unhandledToken = {};
+                unhandledToken.Token = NUM_PATCH_TOKENS;
+                unhandledToken.Size = sizeof(SPatchItemHeader);
+                pushBackToken(patchList, unhandledToken);
+            } else {
+                SPatchExecutionEnvironment executionEnvironment = {};
+                executionEnvironment.Token = PATCH_TOKEN_EXECUTION_ENVIRONMENT;
+                executionEnvironment.Size = sizeof(SPatchExecutionEnvironment);
+                executionEnvironment.LargestCompiledSIMDSize = 16;
+                executionEnvironment.CompiledSIMD16 = 1;
+                pushBackToken(patchList, executionEnvironment);
+
+                SPatchDataParameterStream dataParameterStream = {};
+                dataParameterStream.Token = PATCH_TOKEN_DATA_PARAMETER_STREAM;
+                dataParameterStream.Size = sizeof(SPatchDataParameterStream);
+                dataParameterStream.DataParameterStreamSize = crossThreadDataSize;
+                pushBackToken(patchList, dataParameterStream);
+            }
+
+            std::vector<char> kernelBody(kernelName.begin(), kernelName.end());
+            kernelBody.insert(kernelBody.end(), kernelHeapSize, static_cast<char>(i));
+            kernelBody.insert(kernelBody.end(), patchList.begin(), patchList.end());
+
+            SKernelBinaryHeaderCommon kernelHeader = {};
+            kernelHeader.CheckSum = static_cast<uint32_t>(Hash::hash(kernelBody.data(), kernelBody.size()) & 0xFFFFFFFF);
+            kernelHeader.KernelNameSize = static_cast<uint32_t>(kernelName.size());
+            kernelHeader.KernelHeapSize = kernelHeapSize;
+            kernelHeader.PatchListSize = static_cast<uint32_t>(patchList.size());
+            pushBackToken(binary, kernelHeader);
+            binary.insert(binary.end(), kernelBody.begin(), kernelBody.end());
+        }
+        return binary;
+    }
+
+    std::unique_ptr<MockDevice> device;
+};
+
+constexpr uint32_t ProcessGenBinaryTest::kernelHeapSize;
+constexpr uint32_t ProcessGenBinaryTest::crossThreadDataSize;
+
+TEST_F(ProcessGenBinaryTest, givenManyKernelsBinaryWhenProcessedInParallelThenKernelInfosMatchSequentialParsing) {
+    DebugManagerStateRestore restore;
+    constexpr uint32_t numKernels = 512;
+    auto binary = createBinary(numKernels);
+
+    DebugManager.flags.EnableParallelKernelParsing.set(false);
+    auto sequentialProgram = createProgram(binary);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(CL_SUCCESS, sequentialProgram->processGenBinary());
+    auto sequentialTime = std::chrono::steady_clock::now() - start;
+
+    DebugManager.flags.EnableParallelKernelParsing.set(true);
+    auto parallelProgram = createProgram(binary);
+    start = std::chrono::steady_clock::now();
+    EXPECT_EQ(CL_SUCCESS, parallelProgram->processGenBinary());
+    auto parallelTime = std::chrono::steady_clock::now() - start;
+
+    RecordProperty("sequentialParsingUs", static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(sequentialTime).count()));
+    RecordProperty("parallelParsingUs", static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(parallelTime).count()));
+    RecordProperty("parsingThreads", static_cast<int>(MockProgram::getKernelParsingThreadsCount(numKernels)));
+
+    ASSERT_EQ(numKernels, sequentialProgram->getNumKernels());
+    ASSERT_EQ(numKernels, parallelProgram->getNumKernels());
+    for (uint32_t i = 0; i < numKernels; i++) {
+        auto sequentialInfo = sequentialProgram->kernelInfoArray[i];
+        auto parallelInfo = parallelProgram->kernelInfoArray[i];
+        EXPECT_EQ("kernel_" + std::to_string(i), parallelInfo->name);
+        EXPECT_EQ(sequentialInfo->name, parallelInfo->name);
+        EXPECT_TRUE(parallelInfo->isValid);
+        EXPECT_EQ(sequentialInfo->heapInfo.blobSize, parallelInfo->heapInfo.blobSize);
+        EXPECT_EQ(sequentialInfo->getMaxSimdSize(), parallelInfo->getMaxSimdSize());
+        ASSERT_NE(nullptr, parallelInfo->patchInfo.dataParameterStream);
+        EXPECT_EQ(crossThreadDataSize, parallelInfo->patchInfo.dataParameterStream->DataParameterStreamSize);
+        EXPECT_NE(nullptr, parallelInfo->crossThreadData);
+        EXPECT_NE(nullptr, parallelInfo->getGraphicsAllocation());
+    }
+}
+
+TEST_F(ProcessGenBinaryTest, givenProcessedBinaryThenKernelHeapsReferenceStoredBinaryInPlace) {
+    auto program = createProgram(createBinary(4));
+    EXPECT_EQ(CL_SUCCESS, program->processGenBinary());
+
+    auto binaryBegin = program->genBinary;
+    auto binaryEnd = ptrOffset(program->genBinary, program->genBinarySize);
+    for (auto kernelInfo : program->kernelInfoArray) {
+        auto kernelHeap = static_cast<const char *>(kernelInfo->heapInfo.pKernelHeap);
+        EXPECT_LE(binaryBegin, kernelHeap);
+        EXPECT_GE(binaryEnd, ptrOffset(kernelHeap, kernelHeapSize));
+    }
+}
+
+TEST_F(ProcessGenBinaryTest, givenInvalidKernelInBinaryWhenProcessedInParallelThenOnlyPrecedingKernelsAreRegistered) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.EnableParallelKernelParsing.set(true);
+    auto program = createProgram(createBinary(64, 40));
+
+    EXPECT_EQ(CL_INVALID_KERNEL, program->processGenBinary());
+    ASSERT_EQ(40u, program->getNumKernels());
+    EXPECT_EQ("kernel_39", program->kernelInfoArray[39]->name);
+}
+
+TEST_F(ProcessGenBinaryTest, givenInvalidKernelWithHeapWhenProcessedThenIsaIsNotAllocatedAndErrorIsReturned) {
+    auto program = createProgram(createBinary(1, 0));
+
+    EXPECT_EQ(CL_INVALID_KERNEL, program->processGenBinary());
+    EXPECT_EQ(0u, program->getNumKernels());
+}
+
+TEST_F(ProcessGenBinaryTest, givenFewKernelsOrParallelParsingDisabledWhenThreadsCountIsQueriedThenSingleThreadIsUsed) {
+    DebugManagerStateRestore restore;
+    EXPECT_EQ(1u, MockProgram::getKernelParsingThreadsCount(MockProgram::minKernelsPerParsingThread - 1));
+
+    DebugManager.flags.EnableParallelKernelParsing.set(false);
+    EXPECT_EQ(1u, MockProgram::getKernelParsingThreadsCount(1024));
+
+    DebugManager.flags.EnableParallelKernelParsing.set(true);
+    DebugManager.flags.LogPatchTokens.set(true);
+    EXPECT_EQ(1u, MockProgram::getKernelParsingThreadsCount(1024));
+
+    DebugManager.flags.LogPatchTokens.set(false);
+    EXPECT_LE(MockProgram::getKernelParsingThreadsCount(1024), std::max(std::thread::hardware_concurrency(), 1u));
+}
+
+TEST_F(ProcessGenBinaryTest, givenLazyKernelIsaAllocationWhenBinaryIsProcessedThenIsaIsAllocatedOnFirstKernelRequest) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.EnableLazyKernelIsaAllocation.set(true);
+    auto program = createProgram(createBinary(16));
+
+    EXPECT_EQ(CL_SUCCESS, program->processGenBinary());
+    EXPECT_TRUE(program->deferKernelAllocations);
+    for (auto kernelInfo : program->kernelInfoArray) {
+        EXPECT_EQ(nullptr, kernelInfo->getGraphicsAllocation());
+    }
+
+    auto kernelInfo = program->Program::getKernelInfo("kernel_3");
+    ASSERT_NE(nullptr, kernelInfo);
+    auto kernelAllocation = kernelInfo->getGraphicsAllocation();
+    ASSERT_NE(nullptr, kernelAllocation);
+    EXPECT_EQ(0, memcmp(kernelAllocation->getUnderlyingBuffer(), kernelInfo->heapInfo.pKernelHeap, kernelHeapSize));
+    EXPECT_EQ(kernelAllocation, program->Program::getKernelInfo("kernel_3")->getGraphicsAllocation());
+    EXPECT_EQ(nullptr, program->kernelInfoArray[4]->getGraphicsAllocation());
+
+    EXPECT_NE(nullptr, program->Program::getKernelInfo(size_t{4})->getGraphicsAllocation());
+}
+
+TEST_F(ProcessGenBinaryTest, givenLazyKernelIsaAllocationWhenIsaAllocationFailsThenKernelIsNotCreated) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.EnableLazyKernelIsaAllocation.set(true);
+    device->injectMemoryManager(new FailMemoryManager(*device->getExecutionEnvironment()));
+    auto program = createProgram(createBinary(1));
+
+    EXPECT_EQ(CL_SUCCESS, program->processGenBinary());
+    ASSERT_EQ(1u, program->kernelInfoArray.size());
+    EXPECT_EQ(nullptr, program->kernelInfoArray[0]->getGraphicsAllocation());
+
+    cl_int retVal = CL_SUCCESS;
+    auto kernel = Kernel::create(program.get(), *program->kernelInfoArray[0], &retVal);
+    EXPECT_EQ(nullptr, kernel);
+    EXPECT_EQ(CL_OUT_OF_RESOURCES, retVal);
+    EXPECT_EQ(nullptr, program->kernelInfoArray[0]->getGraphicsAllocation());
+}
+
+TEST_F(ProcessGenBinaryTest, givenDefaultSettingsWhenBinaryIsProcessedThenIsaIsAllocatedForAllKernels) {
+    auto program = createProgram(createBinary(4));
+
+    EXPECT_EQ(CL_SUCCESS, program->processGenBinary());
+    EXPECT_FALSE(program->deferKernelAllocations);
+    for (auto kernelInfo : program->kernelInfoArray) {
+        EXPECT_NE(nullptr, kernelInfo->getGraphicsAllocation());
+    }
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2018 Intel Corporation
+ * Copyright (C) 2018-2019 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  *
@@ -25,6 +25,9 @@ class MockOsLibrary : public OsLibrary {
     bool isLoaded() override {
         return false;
     }
+    std::string getFullPath() override {
+        return std::string();
+    }
 };
 
 class MockDeviceWithDebuggerActive : public MockDevice {
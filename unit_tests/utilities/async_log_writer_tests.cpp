@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "runtime/helpers/file_io.h"
+#include "runtime/utilities/async_log_writer.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+struct MockAsyncLogWriter : public AsyncLogWriter {
+    using AsyncLogWriter::AsyncLogWriter;
+    using AsyncLogWriter::pending;
+    using AsyncLogWriter::thread;
+
+    ~MockAsyncLogWriter() override {
+        closeThread();
+    }
+
+    void writeToSink(const char *str, size_t length) override {
+        written.append(str, length);
+        maxWrittenBatch = std::max(maxWrittenBatch, length);
+    }
+
+    std::string written;
+    size_t maxWrittenBatch = 0;
+};
+
+TEST(AsyncLogWriterTest, givenLinesWrittenFromManyThreadsWhenFlushedThenAllLinesAreWrittenIntact) {
+    MockAsyncLogWriter logWriter("mockLog");
+    constexpr size_t threadsCount = 4;
+    constexpr size_t linesPerThread = 1000;
+    const std::string line = "line logged from multiple threads\n";
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadsCount; i++) {
+        threads.emplace_back([&]() {
+            for (size_t j = 0; j < linesPerThread; j++) {
+                logWriter.write(line);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    logWriter.flush();
+
+    EXPECT_TRUE(logWriter.pending.empty());
+    EXPECT_EQ(threadsCount * linesPerThread * line.size(), logWriter.written.size());
+    size_t linesCount = 0;
+    for (auto pos = logWriter.written.find(line); pos != std::string::npos; pos = logWriter.written.find(line, pos + line.size())) {
+        linesCount++;
+    }
+    EXPECT_EQ(threadsCount * linesPerThread, linesCount);
+    EXPECT_GE(AsyncLogWriter::maxPendingSize + line.size(), logWriter.maxWrittenBatch);
+}
+
+TEST(AsyncLogWriterTest, givenClosedThreadWhenLineIsWrittenThenItIsWrittenSynchronouslyWithoutRestartingThread) {
+    MockAsyncLogWriter logWriter("mockLog");
+    logWriter.write("first line\n");
+    logWriter.closeThread();
+    EXPECT_EQ(nullptr, logWriter.thread.get());
+    EXPECT_EQ(std::string("first line\n"), logWriter.written);
+
+    logWriter.write("second line\n");
+    EXPECT_EQ(nullptr, logWriter.thread.get());
+    EXPECT_TRUE(logWriter.pending.empty());
+    EXPECT_EQ(std::string("first line\nsecond line\n"), logWriter.written);
+}
+
+TEST(AsyncLogWriterTest, givenPendingLinesWhenWriterIsDestroyedThenLinesAreFlushedToLogFile) {
+    std::string fileName = "asyncLogWriterTest.log";
+    std::remove(fileName.c_str());
+    {
+        AsyncLogWriter logWriter(fileName);
+        logWriter.write("first line\n");
+        logWriter.write("second line\n");
+    }
+
+    void *fileData = nullptr;
+    auto fileSize = loadDataFromFile(fileName.c_str(), fileData);
+    ASSERT_NE(nullptr, fileData);
+    EXPECT_EQ(std::string("first line\nsecond line\n"), std::string(static_cast<char *>(fileData), fileSize));
+    deleteDataReadFromFile(fileData);
+    std::remove(fileName.c_str());
+}
@@ -23,8 +23,10 @@
 #include "test.h"
 #include "gtest/gtest.h"
 #include "runtime/utilities/perf_profiler.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 
 #include <chrono>
+#include <cstdio>
 #include <thread>
 
 using namespace OCLRT;
@@ -305,3 +307,147 @@ TEST(PerfProfiler, SysLogBuilderReadAndWrite) {
     EXPECT_EQ(timeW, timeR);
     EXPECT_EQ(idW, idR);
 }
+
+TEST(PerfTraceBuffer, givenPushedEventsWhenDrainedThenEventsAreReturnedInOrder) {
+    PerfTraceBuffer buffer(5, 4);
+    EXPECT_EQ(4u, buffer.getCapacity());
+    EXPECT_TRUE(buffer.isEmpty());
+
+    const char *names[] = {"first", "second", "third", "fourth", "fifth"};
+    std::vector<PerfTraceEvent> events;
+    for (uint64_t i = 0; i < 5; i++) {
+        EXPECT_TRUE(buffer.push(names[i], PerfTraceCategory::Wait, 10 * i, 10 * i + i));
+        EXPECT_EQ(1u, buffer.drain(events));
+    }
+    EXPECT_TRUE(buffer.isEmpty());
+
+    ASSERT_EQ(5u, events.size());
+    for (uint64_t i = 0; i < 5; i++) {
+        EXPECT_STREQ(names[i], events[i].name);
+        EXPECT_EQ(10 * i, events[i].start);
+        EXPECT_EQ(i, events[i].duration);
+        EXPECT_EQ(PerfTraceCategory::Wait, events[i].category);
+        EXPECT_EQ(5u, events[i].threadId);
+    }
+}
+
+TEST(PerfTraceBuffer, givenCapacityNotPowerOfTwoWhenBufferIsCreatedThenCapacityIsRoundedUp) {
+    PerfTraceBuffer buffer(0, 100);
+    EXPECT_EQ(128u, buffer.getCapacity());
+}
+
+TEST(PerfTraceBuffer, givenFullBufferWhenEventIsPushedThenEventIsDroppedAndCounted) {
+    PerfTraceBuffer buffer(0, 2);
+    EXPECT_TRUE(buffer.push("a", PerfTraceCategory::Enqueue, 0, 1));
+    EXPECT_TRUE(buffer.push("b", PerfTraceCategory::Enqueue, 1, 2));
+    EXPECT_FALSE(buffer.push("c", PerfTraceCategory::Enqueue, 2, 3));
+    EXPECT_EQ(1u, buffer.getDroppedCount());
+
+    std::vector<PerfTraceEvent> events;
+    EXPECT_EQ(2u, buffer.drain(events));
+    EXPECT_STREQ("b", events[1].name);
+    EXPECT_TRUE(buffer.push("d", PerfTraceCategory::Enqueue, 3, 4));
+}
+
+TEST(PerfTraceBuffer, givenEventsWhenChromeTraceIsWrittenThenCompleteEventsInMicrosecondsAreEmitted) {
+    std::vector<PerfTraceEvent> events;
+    events.push_back({"enqueueHandler", 1500, 2000, PerfTraceCategory::Enqueue, 3});
+    events.push_back({"flush", 4000, 500, PerfTraceCategory::Submission, 4});
+
+    std::stringstream out;
+    PerfProfiler::writeChromeTrace(out, events);
+    auto trace = out.str();
+
+    EXPECT_EQ(0u, trace.find("{\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, trace.find("{\"name\":\"enqueueHandler\",\"cat\":\"enqueue\",\"ph\":\"X\",\"ts\":1.500,\"dur\":2.000,\"pid\":0,\"tid\":3}"));
+    EXPECT_NE(std::string::npos, trace.find("{\"name\":\"flush\",\"cat\":\"submission\",\"ph\":\"X\",\"ts\":4.000,\"dur\":0.500,\"pid\":0,\"tid\":4}"));
+    EXPECT_NE(std::string::npos, trace.find("]"));
+}
+
+TEST(PerfTraceScope, givenTracingDisabledWhenScopeEndsThenNoEventIsRecorded) {
+    DebugManagerStateRestore restore;
+    std::vector<PerfTraceEvent> events;
+    PerfProfiler::drainTraceEvents(events);
+    events.clear();
+
+    DebugManager.flags.PerfTraceBufferSize.set(0);
+    EXPECT_FALSE(PerfProfiler::isTracingEnabled());
+    {
+        PERF_TRACE_SCOPE("disabledScope", Enqueue);
+    }
+    PerfProfiler::drainTraceEvents(events);
+    EXPECT_TRUE(events.empty());
+}
+
+TEST(PerfTraceScope, givenTracingEnabledWhenScopeEndsThenEventIsRecordedInThreadBuffer) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.PerfTraceBufferSize.set(16);
+    std::vector<PerfTraceEvent> events;
+    PerfProfiler::drainTraceEvents(events);
+    events.clear();
+
+    auto before = PerfProfiler::getTraceTimestamp();
+    {
+        PERF_TRACE_SCOPE("enabledScope", FlushTask);
+    }
+    auto after = PerfProfiler::getTraceTimestamp();
+
+    PerfProfiler::drainTraceEvents(events);
+    ASSERT_EQ(1u, events.size());
+    EXPECT_STREQ("enabledScope", events[0].name);
+    EXPECT_EQ(PerfTraceCategory::FlushTask, events[0].category);
+    EXPECT_LE(before, events[0].start);
+    EXPECT_GE(after, events[0].start + events[0].duration);
+    EXPECT_EQ(PerfProfiler::getTraceBuffer()->getThreadId(), events[0].threadId);
+}
+
+TEST(PerfTraceScope, givenExitedThreadWhenEventsAreDrainedThenItsEventsAreCollectedAndBufferIsReused) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.PerfTraceBufferSize.set(16);
+    std::vector<PerfTraceEvent> events;
+    PerfProfiler::drainTraceEvents(events);
+    events.clear();
+
+    PerfTraceBuffer *firstThreadBuffer = nullptr;
+    std::thread([&]() {
+        firstThreadBuffer = PerfProfiler::getTraceBuffer();
+        PERF_TRACE_SCOPE("workerScope", Wait);
+    }).join();
+
+    PerfProfiler::drainTraceEvents(events);
+    ASSERT_EQ(1u, events.size());
+    EXPECT_STREQ("workerScope", events[0].name);
+    EXPECT_EQ(firstThreadBuffer->getThreadId(), events[0].threadId);
+
+    PerfTraceBuffer *secondThreadBuffer = nullptr;
+    std::thread([&]() {
+        secondThreadBuffer = PerfProfiler::getTraceBuffer();
+    }).join();
+    EXPECT_EQ(firstThreadBuffer, secondThreadBuffer);
+}
+
+TEST(PerfTraceCollector, givenTracedEventsWhenCollectorIsDestroyedThenEventsAreExportedToFile) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.PerfTraceBufferSize.set(16);
+    std::vector<PerfTraceEvent> events;
+    PerfProfiler::drainTraceEvents(events);
+
+    const char *fileName = "perf_trace_collector_test.json";
+    {
+        PerfTraceCollector collector(fileName, 1);
+        {
+            PERF_TRACE_SCOPE("collectedScope", Submission);
+        }
+        collector.drain();
+        EXPECT_EQ(1u, collector.getEventsCount());
+    }
+
+    std::ifstream traceFile(fileName);
+    ASSERT_TRUE(traceFile.is_open());
+    std::stringstream trace;
+    trace << traceFile.rdbuf();
+    traceFile.close();
+    std::remove(fileName);
+
+    EXPECT_NE(std::string::npos, trace.str().find("\"name\":\"collectedScope\",\"cat\":\"submission\""));
+}